@@ -6,6 +6,8 @@
 
 #include "Area.h"
 
+#include <cmath>
+
 namespace SPHSDK
 {
 
@@ -32,15 +34,81 @@ bool Area::isInsideArea(const Point2F& /*point*/)
     return false;
 }
 
+namespace
+{
+// Moves the coordinate into [start, start + side)
+FLOAT wrapCoordinate(FLOAT coordinate, FLOAT start, FLOAT side)
+{
+    FLOAT offset = std::fmod(coordinate - start, side);
+    if (offset < 0.)
+        offset += side;
+
+    // fmod of a tiny negative offset rounds up to side
+    return start + (offset < side ? offset : 0.);
+}
+
+FLOAT getMinimumImageCoordinate(FLOAT difference, FLOAT side)
+{
+    return difference - side * std::round(difference / side);
+}
+} // namespace
+
 Volume::Volume() :
-    m_boundingCuboid(Cuboid()) {}
+    m_boundingCuboid(Cuboid()),
+    m_periodicAxes({false, false, false}) {}
 
 Volume::Volume(const Cuboid& cube) :
-    m_boundingCuboid(cube) {}
+    m_boundingCuboid(cube),
+    m_periodicAxes({false, false, false}) {}
+
+Volume::Volume(const Cuboid& cube, const std::array<bool, 3>& periodicAxes) :
+    m_boundingCuboid(cube),
+    m_periodicAxes(periodicAxes) {}
 
 Cuboid Volume::getBoundingCuboid() const
 {
     return m_boundingCuboid;
 }
 
+bool Volume::isPeriodic(size_t axis) const
+{
+    return m_periodicAxes[axis];
+}
+
+bool Volume::hasPeriodicAxes() const
+{
+    return m_periodicAxes[0] || m_periodicAxes[1] || m_periodicAxes[2];
+}
+
+Point3F Volume::wrapPosition(const Point3F& point) const
+{
+    return Point3F(m_periodicAxes[0] ? wrapCoordinate(0u, point.x) : point.x,
+                   m_periodicAxes[1] ? wrapCoordinate(1u, point.y) : point.y,
+                   m_periodicAxes[2] ? wrapCoordinate(2u, point.z) : point.z);
+}
+
+FLOAT Volume::wrapCoordinate(size_t axis, FLOAT coordinate) const
+{
+    const Cuboid& cube = m_boundingCuboid;
+
+    switch (axis)
+    {
+    case 0u:
+        return SPHSDK::wrapCoordinate(coordinate, cube.startingPoint.x, cube.width);
+    case 1u:
+        return SPHSDK::wrapCoordinate(coordinate, cube.startingPoint.y, cube.length);
+    default:
+        return SPHSDK::wrapCoordinate(coordinate, cube.startingPoint.z, cube.height);
+    }
+}
+
+Point3F Volume::getMinimumImage(const Point3F& difference) const
+{
+    const Cuboid& cube = m_boundingCuboid;
+
+    return Point3F(m_periodicAxes[0] ? getMinimumImageCoordinate(difference.x, cube.width) : difference.x,
+                   m_periodicAxes[1] ? getMinimumImageCoordinate(difference.y, cube.length) : difference.y,
+                   m_periodicAxes[2] ? getMinimumImageCoordinate(difference.z, cube.height) : difference.z);
+}
+
 } // SPHSDK
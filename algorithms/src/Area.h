@@ -9,6 +9,8 @@
 
 #include "Point.h"
 
+#include <array>
+
 namespace SPHSDK
 {
 
@@ -77,6 +79,7 @@ private:
 * The x-axis is equal to width.
 * The y-axis is equal to length.
 * The z-axis is equal to height.
+* Periodic axes have no walls, a point leaving the cuboid on one side enters it on the opposite one.
 */
 class Volume
 {
@@ -86,14 +89,43 @@ public:
 
     explicit Volume(const Cuboid& cube);
 
+    /**
+    * @param periodicAxes    Whether x, y and z axes are periodic
+    */
+    Volume(const Cuboid& cube, const std::array<bool, 3>& periodicAxes);
+
     ~Volume() = default;
 
     Cuboid getBoundingCuboid() const;
 
+    bool isPeriodic(size_t axis) const;
+
+    /**
+    * @brief Returns true if any axis is periodic.
+    */
+    bool hasPeriodicAxes() const;
+
+    /**
+    * @brief Moves the point into the cuboid along periodic axes, other coordinates are kept.
+    */
+    Point3F wrapPosition(const Point3F& point) const;
+
+    /**
+    * @brief Moves the coordinate along the axis into the cuboid, as wrapPosition() does for periodic axes.
+    */
+    FLOAT wrapCoordinate(size_t axis, FLOAT coordinate) const;
+
+    /**
+    * @brief Returns the shortest of the differences between periodic images of two points (minimum image).
+    */
+    Point3F getMinimumImage(const Point3F& difference) const;
+
 private:
 
     Cuboid m_boundingCuboid;
 
+    std::array<bool, 3> m_periodicAxes;
+
 };
 
 } // SPHSDK
@@ -0,0 +1,118 @@
+/**
+ * @file BoundingVolumeHierarchy.cpp
+ * @author Anton Artyukh (artyukhanton@gmail.com)
+ * @date Created Oct 19, 2026
+ **/
+
+#include "BoundingVolumeHierarchy.h"
+
+#include <algorithm>
+
+namespace SPHSDK
+{
+
+namespace
+{
+inline Point3F getMax(const Cuboid& box)
+{
+    return Point3F(box.startingPoint.x + box.width, box.startingPoint.y + box.length,
+                   box.startingPoint.z + box.height);
+}
+
+inline FLOAT getCentre(const Cuboid& box, size_t axis)
+{
+    switch (axis)
+    {
+    case 0u:
+        return box.startingPoint.x + 0.5 * box.width;
+    case 1u:
+        return box.startingPoint.y + 0.5 * box.length;
+    default:
+        return box.startingPoint.z + 0.5 * box.height;
+    }
+}
+} // namespace
+
+void BoundingVolumeHierarchy::build(const std::vector<Cuboid>& bounds)
+{
+    m_nodes.clear();
+    m_items.resize(bounds.size());
+    m_itemBoxes.resize(bounds.size());
+
+    for (size_t i = 0u; i < bounds.size(); ++i)
+        m_items[i] = i;
+
+    if (bounds.empty())
+        return;
+
+    // A median split never makes more than 2 * items nodes
+    m_nodes.reserve(2u * bounds.size());
+    m_nodes.emplace_back();
+
+    buildNode(0u, 0u, bounds.size(), bounds);
+
+    for (size_t i = 0u; i < bounds.size(); ++i)
+    {
+        m_itemBoxes[i].min = bounds[m_items[i]].startingPoint;
+        m_itemBoxes[i].max = getMax(bounds[m_items[i]]);
+    }
+}
+
+size_t BoundingVolumeHierarchy::getItemsNumber() const
+{
+    return m_items.size();
+}
+
+SizetVector BoundingVolumeHierarchy::query(const Point3F& point) const
+{
+    SizetVector result;
+    forEachContaining(point, [&result](size_t item) { result.push_back(item); });
+
+    return result;
+}
+
+void BoundingVolumeHierarchy::buildNode(size_t node, size_t begin, size_t end, const std::vector<Cuboid>& bounds)
+{
+    Point3F min = bounds[m_items[begin]].startingPoint;
+    Point3F max = getMax(bounds[m_items[begin]]);
+
+    for (size_t i = begin + 1u; i < end; ++i)
+    {
+        const Point3F itemMin = bounds[m_items[i]].startingPoint;
+        const Point3F itemMax = getMax(bounds[m_items[i]]);
+
+        min = Point3F(std::min(min.x, itemMin.x), std::min(min.y, itemMin.y), std::min(min.z, itemMin.z));
+        max = Point3F(std::max(max.x, itemMax.x), std::max(max.y, itemMax.y), std::max(max.z, itemMax.z));
+    }
+
+    m_nodes[node].box.min = min;
+    m_nodes[node].box.max = max;
+
+    if (end - begin <= LeafSize)
+    {
+        m_nodes[node].first = begin;
+        m_nodes[node].count = end - begin;
+        return;
+    }
+
+    const Point3F size = max - min;
+    const size_t axis = size.x >= size.y && size.x >= size.z ? 0u : (size.y >= size.z ? 1u : 2u);
+
+    const size_t middle = begin + (end - begin) / 2u;
+    std::nth_element(m_items.begin() + begin, m_items.begin() + middle, m_items.begin() + end,
+                     [&bounds, axis](size_t a, size_t b) {
+                         return getCentre(bounds[a], axis) < getCentre(bounds[b], axis);
+                     });
+
+    const size_t children = m_nodes.size();
+    m_nodes[node].first = children;
+    m_nodes[node].count = 0u;
+
+    m_nodes.emplace_back();
+    m_nodes.emplace_back();
+
+    buildNode(children, begin, middle, bounds);
+    buildNode(children + 1u, middle, end, bounds);
+}
+
+} // namespace SPHSDK
@@ -0,0 +1,89 @@
+/**
+ * @file BoundingVolumeHierarchy.h
+ * @author Anton Artyukh (artyukhanton@gmail.com)
+ * @date Created Oct 19, 2026
+ **/
+
+#ifndef BOUNDING_VOLUME_HIERARCHY_H_2E91084AAAEB44559207A08C0BD3F549
+#define BOUNDING_VOLUME_HIERARCHY_H_2E91084AAAEB44559207A08C0BD3F549
+
+#include "Area.h"
+#include "Defines.h"
+#include "Point.h"
+
+#include <vector>
+
+namespace SPHSDK
+{
+
+namespace TestEnvironment
+{
+class BoundingVolumeHierarchyTestSuite;
+} // namespace TestEnvironment
+
+/**
+ * @brief BoundingVolumeHierarchy class keeps axis-aligned boxes of items in a binary tree,
+ * so a query visits only the few items whose boxes contain the point.
+ * Nodes are split at the median of item centres along their longest side and stored in one array.
+ */
+class BoundingVolumeHierarchy
+{
+    friend class TestEnvironment::BoundingVolumeHierarchyTestSuite;
+
+public:
+    // Items in one leaf
+    static constexpr size_t LeafSize = 2u;
+
+    /**
+     * @brief Rebuilds the tree, item i is bounded by bounds[i].
+     */
+    void build(const std::vector<Cuboid>& bounds);
+
+    size_t getItemsNumber() const;
+
+    /**
+     * @brief Calls visitor(item) for every item whose box contains the point, no memory is allocated.
+     */
+    template <class Visitor> void forEachContaining(const Point3F& point, Visitor&& visitor) const;
+
+    /**
+     * @brief Returns items whose boxes contain the point.
+     */
+    SizetVector query(const Point3F& point) const;
+
+private:
+    struct Box
+    {
+        Point3F min;
+        Point3F max;
+    };
+
+    struct Node
+    {
+        Box box;
+
+        // Leaf: the first of count items in m_items, inner node: the first of two children placed one after another
+        size_t first;
+        size_t count;
+    };
+
+    // Maximal depth of the tree, more than enough for a median split of size_t items
+    static constexpr size_t MaxDepth = 64u;
+
+    void buildNode(size_t node, size_t begin, size_t end, const std::vector<Cuboid>& bounds);
+
+    static bool contains(const Box& box, const Point3F& point);
+
+private:
+    std::vector<Node> m_nodes;
+
+    // Items ordered by leaves and their boxes
+    SizetVector m_items;
+    std::vector<Box> m_itemBoxes;
+};
+
+} // namespace SPHSDK
+
+#include "BoundingVolumeHierarchy.hpp"
+
+#endif // BOUNDING_VOLUME_HIERARCHY_H_2E91084AAAEB44559207A08C0BD3F549
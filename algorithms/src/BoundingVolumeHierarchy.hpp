@@ -0,0 +1,46 @@
+/**
+ * @file BoundingVolumeHierarchy.hpp
+ * @author Anton Artyukh (artyukhanton@gmail.com)
+ * @date Created Oct 19, 2026
+ **/
+
+#include "BoundingVolumeHierarchy.h"
+
+namespace SPHSDK
+{
+
+template <class Visitor> void BoundingVolumeHierarchy::forEachContaining(const Point3F& point, Visitor&& visitor) const
+{
+    if (m_nodes.empty())
+        return;
+
+    size_t stack[MaxDepth + 1u];
+    size_t stackSize = 0u;
+    stack[stackSize++] = 0u;
+
+    while (stackSize > 0u)
+    {
+        const Node& node = m_nodes[stack[--stackSize]];
+        if (!contains(node.box, point))
+            continue;
+
+        if (node.count == 0u)
+        {
+            stack[stackSize++] = node.first + 1u;
+            stack[stackSize++] = node.first;
+            continue;
+        }
+
+        for (size_t i = node.first; i < node.first + node.count; ++i)
+            if (contains(m_itemBoxes[i], point))
+                visitor(m_items[i]);
+    }
+}
+
+inline bool BoundingVolumeHierarchy::contains(const Box& box, const Point3F& point)
+{
+    return point.x >= box.min.x && point.x <= box.max.x && point.y >= box.min.y && point.y <= box.max.y &&
+           point.z >= box.min.z && point.z <= box.max.z;
+}
+
+} // namespace SPHSDK
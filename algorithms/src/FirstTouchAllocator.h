@@ -0,0 +1,95 @@
+/**
+ * @file FirstTouchAllocator.h
+ * @author Anton Artyukh (artyukhanton@gmail.com)
+ * @date Created Oct 19, 2026
+ **/
+
+#ifndef FIRST_TOUCH_ALLOCATOR_H_0B7D2E95C4A14F6B8E31D97A5C60F2E4
+#define FIRST_TOUCH_ALLOCATOR_H_0B7D2E95C4A14F6B8E31D97A5C60F2E4
+
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace SPHSDK
+{
+
+namespace FirstTouch
+{
+// Set by DeferConstructionScope on the current thread
+inline thread_local bool isConstructionDeferred = false;
+} // namespace FirstTouch
+
+/**
+ * @brief FirstTouchAllocator is std::allocator which may skip default construction of elements.
+ * The operating system places a memory page on the NUMA node of the thread which writes it first,
+ * so a container resized inside DeferConstructionScope keeps its pages unplaced
+ * until every worker constructs its own slice in place, e.g. in ThreadPool::parallelFor().
+ */
+template <class T> class FirstTouchAllocator : public std::allocator<T>
+{
+public:
+    template <class U> struct rebind
+    {
+        using other = FirstTouchAllocator<U>;
+    };
+
+    FirstTouchAllocator() = default;
+
+    template <class U> FirstTouchAllocator(const FirstTouchAllocator<U>&)
+    {
+    }
+
+    template <class U, class... Args> void construct(U* pointer, Args&&... args)
+    {
+        if (sizeof...(Args) == 0u && FirstTouch::isConstructionDeferred)
+            return;
+
+        ::new (static_cast<void*>(pointer)) U(std::forward<Args>(args)...);
+    }
+
+    template <class U> void destroy(U* pointer)
+    {
+        pointer->~U();
+    }
+};
+
+template <class T, class U> bool operator==(const FirstTouchAllocator<T>&, const FirstTouchAllocator<U>&)
+{
+    return true;
+}
+
+template <class T, class U> bool operator!=(const FirstTouchAllocator<T>&, const FirstTouchAllocator<U>&)
+{
+    return false;
+}
+
+/**
+ * @brief While the scope is alive, containers with FirstTouchAllocator created or resized
+ * on this thread leave new elements unconstructed.
+ * The caller must construct every such element in place before the element is used or destroyed.
+ */
+class DeferConstructionScope
+{
+public:
+    DeferConstructionScope()
+        : m_previous(FirstTouch::isConstructionDeferred)
+    {
+        FirstTouch::isConstructionDeferred = true;
+    }
+
+    ~DeferConstructionScope()
+    {
+        FirstTouch::isConstructionDeferred = m_previous;
+    }
+
+    DeferConstructionScope(const DeferConstructionScope&) = delete;
+    DeferConstructionScope& operator=(const DeferConstructionScope&) = delete;
+
+private:
+    bool m_previous;
+};
+
+} // namespace SPHSDK
+
+#endif // FIRST_TOUCH_ALLOCATOR_H_0B7D2E95C4A14F6B8E31D97A5C60F2E4
@@ -0,0 +1,184 @@
+/**
+ * @file FloatPack.h
+ * @author Anton Artyukh (artyukhanton@gmail.com)
+ * @date Created Oct 19, 2026
+ **/
+
+#ifndef FLOAT_PACK_H_7A1C5E93B20D4F68A4E1D9B03C6F2E51
+#define FLOAT_PACK_H_7A1C5E93B20D4F68A4E1D9B03C6F2E51
+
+#include "Defines.h"
+
+#include <cmath>
+#include <type_traits>
+
+#if defined(__AVX__)
+#define SPHSDK_FLOAT_PACK_AVX
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#define SPHSDK_FLOAT_PACK_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace SPHSDK
+{
+
+/**
+ * @brief FloatPack struct keeps several FLOAT values processed by one SIMD instruction:
+ * 4 with AVX, 2 with SSE2 and 1 without them. Operations are lane-wise and rounded like the scalar ones,
+ * a FLOAT converts to a pack of equal lanes, so templates written for FLOAT (ROperations, Shapes) work on packs.
+ * The width is chosen at compile time, the build option ENABLE_AVX2 turns AVX on.
+ */
+struct FloatPack
+{
+#if defined(SPHSDK_FLOAT_PACK_AVX)
+    static constexpr size_t Size = 4u;
+
+    __m256d value;
+#elif defined(SPHSDK_FLOAT_PACK_SSE2)
+    static constexpr size_t Size = 2u;
+
+    __m128d value;
+#else
+    static constexpr size_t Size = 1u;
+
+    FLOAT value;
+#endif
+
+    FloatPack() = default;
+
+    FloatPack(FLOAT scalar);
+
+    /**
+     * @brief Loads Size values, the pointer needs no alignment.
+     */
+    static FloatPack load(const FLOAT* values);
+
+    void store(FLOAT* values) const;
+};
+
+static_assert(FloatPack::Size == 1u || std::is_same<FLOAT, double>::value, "SIMD packs hold double lanes");
+
+// Lane-wise binary operator
+#define SPHSDK_FLOAT_PACK_OPERATION(name, expression)                                                                  \
+    inline FloatPack name(const FloatPack& a, const FloatPack& b)                                                      \
+    {                                                                                                                  \
+        FloatPack result;                                                                                              \
+        result.value = expression;                                                                                     \
+        return result;                                                                                                 \
+    }
+
+#if defined(SPHSDK_FLOAT_PACK_AVX)
+
+inline FloatPack::FloatPack(FLOAT scalar)
+    : value(_mm256_set1_pd(scalar))
+{
+}
+
+inline FloatPack FloatPack::load(const FLOAT* values)
+{
+    FloatPack pack;
+    pack.value = _mm256_loadu_pd(values);
+    return pack;
+}
+
+inline void FloatPack::store(FLOAT* values) const
+{
+    _mm256_storeu_pd(values, value);
+}
+
+SPHSDK_FLOAT_PACK_OPERATION(operator+, _mm256_add_pd(a.value, b.value))
+SPHSDK_FLOAT_PACK_OPERATION(operator-, _mm256_sub_pd(a.value, b.value))
+SPHSDK_FLOAT_PACK_OPERATION(operator*, _mm256_mul_pd(a.value, b.value))
+SPHSDK_FLOAT_PACK_OPERATION(operator/, _mm256_div_pd(a.value, b.value))
+
+inline FloatPack sqrt(const FloatPack& a)
+{
+    FloatPack result;
+    result.value = _mm256_sqrt_pd(a.value);
+    return result;
+}
+
+#elif defined(SPHSDK_FLOAT_PACK_SSE2)
+
+inline FloatPack::FloatPack(FLOAT scalar)
+    : value(_mm_set1_pd(scalar))
+{
+}
+
+inline FloatPack FloatPack::load(const FLOAT* values)
+{
+    FloatPack pack;
+    pack.value = _mm_loadu_pd(values);
+    return pack;
+}
+
+inline void FloatPack::store(FLOAT* values) const
+{
+    _mm_storeu_pd(values, value);
+}
+
+SPHSDK_FLOAT_PACK_OPERATION(operator+, _mm_add_pd(a.value, b.value))
+SPHSDK_FLOAT_PACK_OPERATION(operator-, _mm_sub_pd(a.value, b.value))
+SPHSDK_FLOAT_PACK_OPERATION(operator*, _mm_mul_pd(a.value, b.value))
+SPHSDK_FLOAT_PACK_OPERATION(operator/, _mm_div_pd(a.value, b.value))
+
+inline FloatPack sqrt(const FloatPack& a)
+{
+    FloatPack result;
+    result.value = _mm_sqrt_pd(a.value);
+    return result;
+}
+
+#else
+
+inline FloatPack::FloatPack(FLOAT scalar)
+    : value(scalar)
+{
+}
+
+inline FloatPack FloatPack::load(const FLOAT* values)
+{
+    return FloatPack(*values);
+}
+
+inline void FloatPack::store(FLOAT* values) const
+{
+    *values = value;
+}
+
+SPHSDK_FLOAT_PACK_OPERATION(operator+, a.value + b.value)
+SPHSDK_FLOAT_PACK_OPERATION(operator-, a.value - b.value)
+SPHSDK_FLOAT_PACK_OPERATION(operator*, a.value * b.value)
+SPHSDK_FLOAT_PACK_OPERATION(operator/, a.value / b.value)
+
+inline FloatPack sqrt(const FloatPack& a)
+{
+    FloatPack result;
+    result.value = std::sqrt(a.value);
+    return result;
+}
+
+#endif
+
+#undef SPHSDK_FLOAT_PACK_OPERATION
+
+/**
+ * @brief Evaluates out[i] = f(xs[i], ys[i], zs[i]) for n points, FloatPack::Size points at a time,
+ * the rest one by one. f is generic, it is called with packs and with FLOATs.
+ */
+template <class F>
+void evaluateInPacks(const F& f, const FLOAT* xs, const FLOAT* ys, const FLOAT* zs, FLOAT* out, size_t n)
+{
+    size_t i = 0u;
+
+    for (; i + FloatPack::Size <= n; i += FloatPack::Size)
+        f(FloatPack::load(xs + i), FloatPack::load(ys + i), FloatPack::load(zs + i)).store(out + i);
+
+    for (; i < n; ++i)
+        out[i] = f(xs[i], ys[i], zs[i]);
+}
+
+} // namespace SPHSDK
+
+#endif // FLOAT_PACK_H_7A1C5E93B20D4F68A4E1D9B03C6F2E51
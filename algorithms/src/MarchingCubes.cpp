@@ -6,27 +6,69 @@
 
 #include "MarchingCubes.h"
 #include "MarchingCubesConfig.h"
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <stdexcept>
+#include <limits>
+#include <type_traits>
+#include <unordered_map>
 
 namespace SPHSDK
 {
 
-Point3FVector MarchingCubes::generateMesh(std::function<FLOAT(FLOAT, FLOAT, FLOAT)> f)
+void IndexedMesh::clear()
 {
-    Point3FVector mesh;
+    vertices.clear();
+    indices.clear();
+}
+
+size_t IndexedMesh::getTrianglesNumber() const
+{
+    return indices.size() / TRIANGLES_CORNERS_NUMBER;
+}
+
+void IndexedMesh::saveObj(std::ostream& stream) const
+{
+    for (const Point3F& vertex : vertices)
+        stream << "v " << vertex.x << ' ' << vertex.y << ' ' << vertex.z << '\n';
+
+    // OBJ indices start from 1
+    for (size_t i = 0u; i + 2u < indices.size(); i += TRIANGLES_CORNERS_NUMBER)
+        stream << "f " << indices[i] + 1u << ' ' << indices[i + 1u] + 1u << ' ' << indices[i + 2u] + 1u << '\n';
+}
+
+void ShadedMesh::clear()
+{
+    vertices.clear();
+    indices.clear();
+}
 
-    for (auto x = X_MIN; x < X_MAX; x += GRID_CUBE_SIZE)
+size_t ShadedMesh::getTrianglesNumber() const
+{
+    return indices.size() / TRIANGLES_CORNERS_NUMBER;
+}
+
+void ShadedMesh::saveObj(std::ostream& stream) const
+{
+    for (const MeshVertex& vertex : vertices)
+        stream << "v " << vertex.position.x << ' ' << vertex.position.y << ' ' << vertex.position.z << '\n';
+
+    for (const MeshVertex& vertex : vertices)
+        stream << "vn " << vertex.normal.x << ' ' << vertex.normal.y << ' ' << vertex.normal.z << '\n';
+
+    // Every vertex has the normal of the same index
+    for (size_t i = 0u; i + 2u < indices.size(); i += TRIANGLES_CORNERS_NUMBER)
     {
-        for (auto y = Y_MIN; y < Y_MAX; y += GRID_CUBE_SIZE)
-        {
-            for (auto z = Z_MIN; z < Z_MAX; z += GRID_CUBE_SIZE)
-            {
-                // iX, iY, iZ are coordinates of the current vertex in grid_cube
-                const auto vertices = MarchingCube(f, x, y, z);
-                std::copy(vertices.begin(), vertices.end(), std::back_inserter(mesh));
-            }
-        }
+        stream << 'f';
+
+        for (size_t corner = i; corner < i + TRIANGLES_CORNERS_NUMBER; ++corner)
+            stream << ' ' << indices[corner] + 1u << "//" << indices[corner] + 1u;
+
+        stream << '\n';
     }
-    return mesh;
 }
 
 static FLOAT adapt(FLOAT a, FLOAT b)
@@ -41,20 +83,1057 @@ static FLOAT adapt(FLOAT a, FLOAT b)
     return -a / delta;
 }
 
-Point3FVector MarchingCubes::MarchingCube(std::function<FLOAT(FLOAT, FLOAT, FLOAT)> f, FLOAT fX, FLOAT fY, FLOAT fZ)
+namespace
 {
-    // vector with all triangles found
-    Point3FVector trianglesMesh;
+// Cells of the grid along one axis, at least one even for flat bounds, the last cell may stick out of [min, max]
+size_t getGridCellsNumber(FLOAT min, FLOAT max, FLOAT cellSize)
+{
+    const FLOAT cellsNumber = (max - min) / cellSize;
+    if (!(cellsNumber < static_cast<FLOAT>(MarchingCubes::MaxCellsNumber)))
+        throw std::invalid_argument("Marching cubes grid has too many cells");
 
-    FLOAT CubeValue[CUBE_VERTICES_NUMBER];
+    size_t number = std::max<size_t>(1u, static_cast<size_t>(std::max<FLOAT>(0.0, std::ceil(cellsNumber))));
+
+    // The division may round either way, the far vertex is the first one at or beyond max
+    while (min + static_cast<FLOAT>(number) * cellSize < max)
+        ++number;
+
+    while (number > 1u && min + static_cast<FLOAT>(number - 1u) * cellSize >= max)
+        --number;
+
+    return number;
+}
+
+// Coordinates of the grid vertices along one axis, vertex i is at min + i * cellSize
+std::vector<FLOAT> getGridCoordinates(FLOAT min, FLOAT max, FLOAT cellSize)
+{
+    std::vector<FLOAT> coordinates(getGridCellsNumber(min, max, cellSize) + 1u);
+
+    for (size_t i = 0u; i < coordinates.size(); ++i)
+        coordinates[i] = min + static_cast<FLOAT>(i) * cellSize;
+
+    return coordinates;
+}
+
+// The coordinates of getGridCoordinates() computed on access, so a sparse grid takes no memory per cell
+class UniformAxis
+{
+public:
+    UniformAxis(FLOAT min, FLOAT max, FLOAT cellSize)
+        : m_min(min)
+        , m_cellSize(cellSize)
+        , m_verticesNumber(getGridCellsNumber(min, max, cellSize) + 1u)
+    {
+    }
+
+    FLOAT operator[](size_t i) const
+    {
+        return m_min + static_cast<FLOAT>(i) * m_cellSize;
+    }
+
+    size_t size() const
+    {
+        return m_verticesNumber;
+    }
+
+private:
+    FLOAT m_min;
+    FLOAT m_cellSize;
+    size_t m_verticesNumber;
+};
+
+// Bit i is set when cube vertex i is inside of the surface, f > 0
+int getFlagIndex(const FLOAT CubeValue[])
+{
+    int flagIndex = 0;
+
+    for (int iVertexTest = 0; iVertexTest < CUBE_VERTICES_NUMBER; iVertexTest++)
+    {
+        if (CubeValue[iVertexTest] > 0)
+        {
+            flagIndex |= 1 << iVertexTest;
+        }
+    }
+    return flagIndex;
+}
+
+// Runs body(firstSlab, lastSlab, thread) over contiguous ranges of slabs, one range per thread
+template <class Body> void forEachSlabRange(size_t slabsNumber, ThreadPool* pool, size_t threadsNumber, Body body)
+{
+    const auto runThreads = [slabsNumber, threadsNumber, &body](size_t begin, size_t end) {
+        for (size_t thread = begin; thread < end; ++thread)
+            body(slabsNumber * thread / threadsNumber, slabsNumber * (thread + 1u) / threadsNumber, thread);
+    };
+
+    if (pool != nullptr)
+        pool->parallelFor(0u, threadsNumber, runThreads);
+    else
+        runThreads(0u, threadsNumber);
+}
+
+// Offsets of the cube vertices in grid vertices
+struct VertexSteps
+{
+    VertexSteps()
+    {
+        for (int iVertex = 0; iVertex < CUBE_VERTICES_NUMBER; iVertex++)
+            for (int axis = 0; axis < CUBE_DIMENSION; axis++)
+                steps[iVertex][axis] = VertexOffset[iVertex][axis] > 0.0 ? 1u : 0u;
+    }
+
+    size_t steps[CUBE_VERTICES_NUMBER][CUBE_DIMENSION];
+};
+
+const VertexSteps VERTEX_STEPS;
+
+/**
+ * Every grid edge is identified by its lower vertex and its axis, edge e of a cell
+ * starts at the cell vertex EdgeStart[e] and goes along EdgeAxis[e].
+ */
+struct EdgeTable
+{
+    EdgeTable()
+    {
+        for (int iEdge = 0; iEdge < CUBE_EDGES_NUMBER; iEdge++)
+        {
+            const auto v0 = EdgeConnection[iEdge][0];
+            const auto v1 = EdgeConnection[iEdge][1];
+
+            for (int axis = 0; axis < CUBE_DIMENSION; axis++)
+                if (VertexOffset[v0][axis] != VertexOffset[v1][axis])
+                    this->axis[iEdge] = static_cast<size_t>(axis);
+
+            const auto lower = VertexOffset[v0][this->axis[iEdge]] < VertexOffset[v1][this->axis[iEdge]] ? v0 : v1;
+
+            for (int axis = 0; axis < CUBE_DIMENSION; axis++)
+                start[iEdge][axis] = VertexOffset[lower][axis] > 0.0 ? 1u : 0u;
+        }
+    }
+
+    size_t start[CUBE_EDGES_NUMBER][CUBE_DIMENSION];
+    size_t axis[CUBE_EDGES_NUMBER];
+};
+
+// The function is > 0 inside, so the outward normal is against its gradient
+Point3F getOutwardNormal(const Point3F& gradient)
+{
+    const FLOAT norm = gradient.calcNorm();
+    return norm > 0.0 ? gradient * (-1.0 / norm) : Point3F();
+}
+
+// Vertices of meshes without normals are their positions
+struct MakePosition
+{
+    Point3F operator()(const size_t[], const size_t[], FLOAT, const Point3F& position) const
+    {
+        return position;
+    }
+};
+
+/**
+ * Mesh vertices of the grid edges starting in two neighbouring x-planes, the flat replacement of a map from edges.
+ * Plane x is kept in half x % 2, it is emptied when plane x + 2 comes, so cells must come in the order of x.
+ * Only the entries set are emptied, and the cache of a thread is reused by all meshes it builds.
+ */
+class SlabEdgeCache
+{
+public:
+    static constexpr uint32_t NoVertex = std::numeric_limits<uint32_t>::max();
+
+    // Empties the cache for a grid of ysNumber x zsNumber vertices in a plane
+    void reset(size_t ysNumber, size_t zsNumber)
+    {
+        empty(0u);
+        empty(1u);
+
+        if (ysNumber != m_ysNumber || zsNumber != m_zsNumber)
+        {
+            m_ysNumber = ysNumber;
+            m_zsNumber = zsNumber;
+            m_vertices.assign(2u * ysNumber * zsNumber * CUBE_DIMENSION, NoVertex);
+        }
+    }
+
+    // The vertex of the edge from the grid vertex lower along the axis, NoVertex until it is set
+    uint32_t& at(const size_t lower[], size_t axis)
+    {
+        const size_t half = lower[0] % 2u;
+        if (m_planes[half] != lower[0])
+        {
+            empty(half);
+            m_planes[half] = lower[0];
+        }
+
+        const size_t entry = ((half * m_ysNumber + lower[1]) * m_zsNumber + lower[2]) * CUBE_DIMENSION + axis;
+        if (m_vertices[entry] == NoVertex)
+            m_setEntries[half].push_back(entry);
+
+        return m_vertices[entry];
+    }
+
+private:
+    static constexpr size_t NoPlane = std::numeric_limits<size_t>::max();
+
+    void empty(size_t half)
+    {
+        for (const size_t entry : m_setEntries[half])
+            m_vertices[entry] = NoVertex;
+
+        m_setEntries[half].clear();
+        m_planes[half] = NoPlane;
+    }
+
+    size_t m_ysNumber = 0u;
+    size_t m_zsNumber = 0u;
+
+    std::vector<uint32_t> m_vertices;
+
+    size_t m_planes[2] = {NoPlane, NoPlane};
+    SizetVector m_setEntries[2];
+};
+
+// Appends the mesh to vectors, edges keeps the grid edge of every vertex if it is not nullptr
+template <class Vertex> class VectorsWriter
+{
+public:
+    VectorsWriter(std::vector<Vertex>& vertices, std::vector<uint64_t>* edges, std::vector<uint32_t>& indices)
+        : m_vertices(vertices)
+        , m_edges(edges)
+        , m_indices(indices)
+    {
+    }
+
+    template <class Make> uint32_t addVertex(const size_t[], size_t, uint64_t edge, const Make& make)
+    {
+        m_vertices.push_back(make());
+
+        if (m_edges != nullptr)
+            m_edges->push_back(edge);
+
+        return static_cast<uint32_t>(m_vertices.size() - 1u);
+    }
+
+    void addIndex(uint32_t index)
+    {
+        m_indices.push_back(index);
+    }
+
+private:
+    std::vector<Vertex>&   m_vertices;
+    std::vector<uint64_t>* m_edges;
+    std::vector<uint32_t>& m_indices;
+};
+
+/**
+ * Adds triangles of grid cells to an indexed mesh, a vertex is added once per grid edge.
+ * It is interpolated from the lower vertex of the edge, so all cells sharing the edge agree on it.
+ * getValue(i, j, k) returns the function in a grid vertex,
+ * makeVertex(lower, upper, t, position) builds the mesh vertex of the edge between grid vertices lower and upper.
+ * cache.at(lower, axis) returns the vertex of the edge along the axis, SlabEdgeCache::NoVertex until it is added,
+ * see SlabEdgeCache, and the triangles go to the writer, see VectorsWriter.
+ * The coordinates of the grid vertices are xs[i], ys[j] and zs[k].
+ */
+template <class GetValue, class Cache, class Writer, class MakeVertex = MakePosition,
+          class Axis = std::vector<FLOAT>>
+class CellMesher
+{
+public:
+    CellMesher(const Axis&       xs,
+               const Axis&       ys,
+               const Axis&       zs,
+               const GetValue&   getValue,
+               Cache&            cache,
+               Writer&           writer,
+               const MakeVertex& makeVertex = MakeVertex())
+        : m_xs(xs)
+        , m_ys(ys)
+        , m_zs(zs)
+        , m_getValue(getValue)
+        , m_makeVertex(makeVertex)
+        , m_cache(cache)
+        , m_writer(writer)
+    {
+    }
+
+    void addCell(size_t i, size_t j, size_t k, int iFlagIndex)
+    {
+        for (int iCorner = 0; iCorner < TRIANGLES_MAX_NUMBER_FOR_ONE_CUBE * TRIANGLES_CORNERS_NUMBER; iCorner++)
+        {
+            const int iEdge = TriangleConnectionTable[iFlagIndex][iCorner];
+            if (iEdge < 0)
+                break;
+
+            const size_t axis = m_edgeTable.axis[iEdge];
+            const size_t lower[3] = {i + m_edgeTable.start[iEdge][0], j + m_edgeTable.start[iEdge][1],
+                                     k + m_edgeTable.start[iEdge][2]};
+
+            uint32_t& vertex = m_cache.at(lower, axis);
+
+            if (vertex == SlabEdgeCache::NoVertex)
+            {
+                const size_t lowerVertex = (lower[0] * m_ys.size() + lower[1]) * m_zs.size() + lower[2];
+                const uint64_t edge = static_cast<uint64_t>(lowerVertex) * CUBE_DIMENSION + axis;
+
+                vertex = m_writer.addVertex(lower, axis, edge, [this, &lower, axis] {
+                    size_t upper[3] = {lower[0], lower[1], lower[2]};
+                    ++upper[axis];
+
+                    const FLOAT t =
+                        adapt(m_getValue(lower[0], lower[1], lower[2]), m_getValue(upper[0], upper[1], upper[2]));
+
+                    const Point3F start(m_xs[lower[0]], m_ys[lower[1]], m_zs[lower[2]]);
+                    const Point3F end(m_xs[upper[0]], m_ys[upper[1]], m_zs[upper[2]]);
+
+                    return m_makeVertex(lower, upper, t, start + (end - start) * t);
+                });
+            }
+
+            m_writer.addIndex(vertex);
+        }
+    }
+
+private:
+    const Axis& m_xs;
+    const Axis& m_ys;
+    const Axis& m_zs;
+
+    const GetValue& m_getValue;
+
+    const MakeVertex m_makeVertex;
+
+    const EdgeTable m_edgeTable;
+
+    Cache&  m_cache;
+    Writer& m_writer;
+};
+
+// A vertex on the last plane of a range of slabs, on an edge along y or z, and its number in the range
+struct PlaneVertex
+{
+    size_t j;
+    size_t k;
+    size_t axis;
+    uint32_t vertex;
+};
+
+/**
+ * Counts the mesh of a range of slabs without building it. The vertices on the first plane, but the one of the grid,
+ * belong to the previous range, the ones on the last plane are kept for the next range.
+ */
+class CountingWriter
+{
+public:
+    CountingWriter(size_t firstPlane, size_t lastPlane, std::vector<PlaneVertex>& lastPlaneVertices)
+        : m_firstPlane(firstPlane)
+        , m_lastPlane(lastPlane)
+        , m_lastPlaneVertices(lastPlaneVertices)
+    {
+    }
+
+    template <class Make> uint32_t addVertex(const size_t lower[], size_t axis, uint64_t, const Make&)
+    {
+        const bool isInPlane = axis != 0u;
+
+        // Any number but NoVertex, the triangles are not written
+        if (isInPlane && lower[0] == m_firstPlane && m_firstPlane != 0u)
+            return 0u;
+
+        if (isInPlane && lower[0] == m_lastPlane)
+            m_lastPlaneVertices.push_back({lower[1], lower[2], axis, static_cast<uint32_t>(m_verticesNumber)});
+
+        return static_cast<uint32_t>(m_verticesNumber++);
+    }
+
+    void addIndex(uint32_t)
+    {
+        ++m_indicesNumber;
+    }
+
+    size_t getVerticesNumber() const
+    {
+        return m_verticesNumber;
+    }
+
+    size_t getIndicesNumber() const
+    {
+        return m_indicesNumber;
+    }
+
+private:
+    const size_t m_firstPlane;
+    const size_t m_lastPlane;
+
+    std::vector<PlaneVertex>& m_lastPlaneVertices;
+
+    size_t m_verticesNumber = 0u;
+    size_t m_indicesNumber = 0u;
+};
+
+// Writes the mesh of a range of slabs into its part of the buffers, vertices are numbered from firstVertex
+template <class Vertex> class ArraysWriter
+{
+public:
+    ArraysWriter(Vertex* vertices, uint32_t firstVertex, uint32_t* indices)
+        : m_vertices(vertices)
+        , m_nextVertex(firstVertex)
+        , m_indices(indices)
+    {
+    }
+
+    template <class Make> uint32_t addVertex(const size_t[], size_t, uint64_t, const Make& make)
+    {
+        *m_vertices++ = make();
+        return m_nextVertex++;
+    }
+
+    void addIndex(uint32_t index)
+    {
+        *m_indices++ = index;
+    }
+
+private:
+    Vertex*   m_vertices;
+    uint32_t  m_nextVertex;
+    uint32_t* m_indices;
+};
+
+/**
+ * Triangulates all cells of the grid into an indexed mesh in parallel slabs, see CellMesher for makeVertex.
+ * Every range of slabs is counted first, then written straight into its part of the mesh buffers,
+ * a vertex on the plane between two ranges is taken from the earlier one. So the mesh is the one of a single range,
+ * it does not depend on the number of threads.
+ */
+template <class Mesh, class MakeVertex>
+void triangulateGrid(const MarchingCubesGrid& grid,
+                     ThreadPool*              pool,
+                     size_t                   threadsNumber,
+                     const MakeVertex&        makeVertex,
+                     Mesh&                    mesh)
+{
+    using Vertex = typename decltype(Mesh::vertices)::value_type;
+
+    const auto getValue = [&grid](size_t i, size_t j, size_t k) { return grid.values[grid.getIndex(i, j, k)]; };
+
+    // Runs the cells of the slabs through the writer
+    const auto meshSlabs = [&grid, &getValue, &makeVertex](size_t firstSlab, size_t lastSlab, SlabEdgeCache& cache,
+                                                            auto& writer) {
+        CellMesher<decltype(getValue), SlabEdgeCache, std::remove_reference_t<decltype(writer)>, MakeVertex> mesher(
+            grid.xs, grid.ys, grid.zs, getValue, cache, writer, makeVertex);
+        FLOAT CubeValue[CUBE_VERTICES_NUMBER];
+
+        for (size_t i = firstSlab; i < lastSlab; ++i)
+            for (size_t j = 0u; j < grid.getCellsNumber(1u); ++j)
+                for (size_t k = 0u; k < grid.getCellsNumber(2u); ++k)
+                {
+                    grid.getCubeValues(i, j, k, CubeValue);
+
+                    const int iFlagIndex = getFlagIndex(CubeValue);
+                    if (CubeEdgeFlags[iFlagIndex] != 0)
+                        mesher.addCell(i, j, k, iFlagIndex);
+                }
+    };
+
+    struct SlabsRange
+    {
+        size_t firstSlab = 0u;
+        size_t lastSlab = 0u;
+
+        size_t verticesNumber = 0u;
+        size_t indicesNumber = 0u;
+
+        std::vector<PlaneVertex> lastPlaneVertices;
+    };
+
+    std::vector<SlabsRange> ranges(threadsNumber);
+
+    forEachSlabRange(grid.getCellsNumber(0u), pool, threadsNumber, [&](size_t firstSlab, size_t lastSlab,
+                                                                       size_t thread) {
+        thread_local SlabEdgeCache cache;
+        cache.reset(grid.ys.size(), grid.zs.size());
+
+        SlabsRange& range = ranges[thread];
+        range.firstSlab = firstSlab;
+        range.lastSlab = lastSlab;
+
+        CountingWriter writer(firstSlab, lastSlab, range.lastPlaneVertices);
+        meshSlabs(firstSlab, lastSlab, cache, writer);
+
+        range.verticesNumber = writer.getVerticesNumber();
+        range.indicesNumber = writer.getIndicesNumber();
+    });
+
+    SizetVector firstVertices(threadsNumber + 1u, 0u);
+    SizetVector firstIndices(threadsNumber + 1u, 0u);
+    for (size_t thread = 0u; thread < threadsNumber; ++thread)
+    {
+        firstVertices[thread + 1u] = firstVertices[thread] + ranges[thread].verticesNumber;
+        firstIndices[thread + 1u] = firstIndices[thread] + ranges[thread].indicesNumber;
+    }
+
+    mesh.vertices.resize(firstVertices.back());
+    mesh.indices.resize(firstIndices.back());
+
+    forEachSlabRange(grid.getCellsNumber(0u), pool, threadsNumber, [&](size_t firstSlab, size_t lastSlab,
+                                                                       size_t thread) {
+        thread_local SlabEdgeCache cache;
+        cache.reset(grid.ys.size(), grid.zs.size());
+
+        // The vertices of the first plane are written by the closest earlier range with slabs
+        size_t previous = thread;
+        while (previous > 0u && ranges[previous - 1u].firstSlab == ranges[previous - 1u].lastSlab)
+            --previous;
+
+        if (previous > 0u)
+            for (const PlaneVertex& planeVertex : ranges[previous - 1u].lastPlaneVertices)
+            {
+                const size_t lower[3] = {firstSlab, planeVertex.j, planeVertex.k};
+                cache.at(lower, planeVertex.axis) =
+                    static_cast<uint32_t>(firstVertices[previous - 1u] + planeVertex.vertex);
+            }
+
+        ArraysWriter<Vertex> writer(mesh.vertices.data() + firstVertices[thread],
+                                    static_cast<uint32_t>(firstVertices[thread]),
+                                    mesh.indices.data() + firstIndices[thread]);
+        meshSlabs(firstSlab, lastSlab, cache, writer);
+    });
+}
+} // namespace
+
+static void checkCellSize(FLOAT cellSize)
+{
+    if (!(cellSize > 0.0))
+        throw std::invalid_argument("Marching cubes cell size must be positive");
+}
+
+MarchingCubesGrid::MarchingCubesGrid(const Cuboid& bounds, FLOAT cellSize)
+    : cellSize(cellSize)
+{
+    checkCellSize(cellSize);
+
+    xs = getGridCoordinates(bounds.startingPoint.x, bounds.startingPoint.x + bounds.width, cellSize);
+    ys = getGridCoordinates(bounds.startingPoint.y, bounds.startingPoint.y + bounds.length, cellSize);
+    zs = getGridCoordinates(bounds.startingPoint.z, bounds.startingPoint.z + bounds.height, cellSize);
+
+    values.resize(xs.size() * ys.size() * zs.size());
+}
+
+size_t MarchingCubesGrid::getIndex(size_t i, size_t j, size_t k) const
+{
+    return (i * ys.size() + j) * zs.size() + k;
+}
 
-    // Evaluate value of the cube vertex at each point
+size_t MarchingCubesGrid::getCellsNumber(size_t axis) const
+{
+    return (axis == 0u ? xs.size() : (axis == 1u ? ys.size() : zs.size())) - 1u;
+}
+
+void MarchingCubesGrid::getCubeValues(size_t i, size_t j, size_t k, FLOAT CubeValue[]) const
+{
     for (int iVertex = 0; iVertex < CUBE_VERTICES_NUMBER; iVertex++)
+        CubeValue[iVertex] = values[getIndex(i + VERTEX_STEPS.steps[iVertex][0], j + VERTEX_STEPS.steps[iVertex][1],
+                                             k + VERTEX_STEPS.steps[iVertex][2])];
+}
+
+Point3F MarchingCubesGrid::getGradient(size_t i, size_t j, size_t k) const
+{
+    const std::vector<FLOAT>* coordinates[3] = {&xs, &ys, &zs};
+    FLOAT gradient[3];
+
+    for (size_t axis = 0u; axis < 3u; ++axis)
+    {
+        size_t lower[3] = {i, j, k};
+        size_t upper[3] = {i, j, k};
+
+        if (lower[axis] > 0u)
+            --lower[axis];
+        if (upper[axis] + 1u < coordinates[axis]->size())
+            ++upper[axis];
+
+        gradient[axis] =
+            (values[getIndex(upper[0], upper[1], upper[2])] - values[getIndex(lower[0], lower[1], lower[2])]) /
+            ((*coordinates[axis])[upper[axis]] - (*coordinates[axis])[lower[axis]]);
+    }
+
+    return Point3F(gradient[0], gradient[1], gradient[2]);
+}
+
+Cuboid MarchingCubes::getDefaultBounds()
+{
+    return Cuboid(Point3F(X_MIN, Y_MIN, Z_MIN), X_MAX - X_MIN, Y_MAX - Y_MIN, Z_MAX - Z_MIN);
+}
+
+FLOAT MarchingCubes::getDefaultCellSize()
+{
+    return GRID_CUBE_SIZE;
+}
+
+Point3FVector MarchingCubes::generateMesh(const std::function<FLOAT(FLOAT, FLOAT, FLOAT)>& f, ThreadPool* pool)
+{
+    return generateMesh(f, getDefaultBounds(), getDefaultCellSize(), pool);
+}
+
+void MarchingCubes::generateMesh(const std::function<FLOAT(FLOAT, FLOAT, FLOAT)>& f,
+                                 IndexedMesh&                                    mesh,
+                                 ThreadPool*                                     pool)
+{
+    generateMesh(f, getDefaultBounds(), getDefaultCellSize(), mesh, pool);
+}
+
+Point3FVector MarchingCubes::generateMesh(const std::function<FLOAT(FLOAT, FLOAT, FLOAT)>& f,
+                                          const Cuboid&                                    bounds,
+                                          FLOAT                                            cellSize,
+                                          ThreadPool*                                      pool)
+{
+    return generateMesh<std::function<FLOAT(FLOAT, FLOAT, FLOAT)>>(f, bounds, cellSize, pool);
+}
+
+void MarchingCubes::generateMesh(const std::function<FLOAT(FLOAT, FLOAT, FLOAT)>& f,
+                                 const Cuboid&                                    bounds,
+                                 FLOAT                                            cellSize,
+                                 IndexedMesh&                                     mesh,
+                                 ThreadPool*                                      pool)
+{
+    generateMesh<std::function<FLOAT(FLOAT, FLOAT, FLOAT)>>(f, bounds, cellSize, mesh, pool);
+}
+
+Point3FVector MarchingCubes::triangulate(const MarchingCubesGrid& grid, ThreadPool* pool)
+{
+    const size_t threadsNumber = pool != nullptr ? pool->getThreadsNumber() : 1u;
+    const FLOAT cellSize = grid.cellSize;
+
+    std::vector<Point3FVector> threadMeshes(threadsNumber);
+
+    forEachSlabRange(grid.getCellsNumber(0u), pool, threadsNumber,
+                     [&grid, cellSize, &threadMeshes](size_t firstSlab, size_t lastSlab, size_t thread) {
+                         Point3FVector& trianglesMesh = threadMeshes[thread];
+                         FLOAT CubeValue[CUBE_VERTICES_NUMBER];
+
+                         for (size_t i = firstSlab; i < lastSlab; ++i)
+                             for (size_t j = 0u; j < grid.getCellsNumber(1u); ++j)
+                                 for (size_t k = 0u; k < grid.getCellsNumber(2u); ++k)
+                                 {
+                                     grid.getCubeValues(i, j, k, CubeValue);
+                                     MarchingCube(CubeValue, grid.xs[i], grid.ys[j], grid.zs[k], cellSize,
+                                                  trianglesMesh);
+                                 }
+                     });
+
+    size_t meshSize = 0u;
+    for (const Point3FVector& threadMesh : threadMeshes)
+        meshSize += threadMesh.size();
+
+    Point3FVector mesh;
+    mesh.reserve(meshSize);
+
+    for (const Point3FVector& threadMesh : threadMeshes)
+        mesh.insert(mesh.end(), threadMesh.begin(), threadMesh.end());
+
+    return mesh;
+}
+
+void MarchingCubes::triangulate(const MarchingCubesGrid& grid, IndexedMesh& mesh, ThreadPool* pool)
+{
+    const size_t threadsNumber = pool != nullptr ? pool->getThreadsNumber() : 1u;
+    triangulateGrid(grid, pool, threadsNumber, MakePosition(), mesh);
+}
+
+void MarchingCubes::generateMesh(const std::function<FLOAT(FLOAT, FLOAT, FLOAT)>& f,
+                                 const Cuboid&                                    bounds,
+                                 FLOAT                                            cellSize,
+                                 ShadedMesh&                                      mesh,
+                                 ThreadPool*                                      pool)
+{
+    MarchingCubesGrid grid(bounds, cellSize);
+    grid.evaluate(f, pool);
+
+    const size_t threadsNumber = pool != nullptr ? pool->getThreadsNumber() : 1u;
+
+    const auto makeVertex = [&grid](const size_t lower[], const size_t upper[], FLOAT t, const Point3F& position) {
+        const Point3F gradient = grid.getGradient(lower[0], lower[1], lower[2]) * (1.0 - t) +
+                                 grid.getGradient(upper[0], upper[1], upper[2]) * t;
+
+        return MeshVertex{position, getOutwardNormal(gradient)};
+    };
+
+    triangulateGrid(grid, pool, threadsNumber, makeVertex, mesh);
+}
+
+void MarchingCubes::generateMesh(const std::function<FLOAT(FLOAT, FLOAT, FLOAT)>&   f,
+                                 const std::function<Point3F(FLOAT, FLOAT, FLOAT)>& gradient,
+                                 const Cuboid&                                      bounds,
+                                 FLOAT                                              cellSize,
+                                 ShadedMesh&                                        mesh,
+                                 ThreadPool*                                        pool)
+{
+    MarchingCubesGrid grid(bounds, cellSize);
+    grid.evaluate(f, pool);
+
+    const size_t threadsNumber = pool != nullptr ? pool->getThreadsNumber() : 1u;
+
+    const auto makeVertex = [&gradient](const size_t[], const size_t[], FLOAT, const Point3F& position) {
+        return MeshVertex{position, getOutwardNormal(gradient(position.x, position.y, position.z))};
+    };
+
+    triangulateGrid(grid, pool, threadsNumber, makeVertex, mesh);
+}
+
+void MarchingCubes::generateAdaptiveMesh(const std::function<FLOAT(FLOAT, FLOAT, FLOAT)>& f,
+                                         const Cuboid&                                    bounds,
+                                         FLOAT                                            cellSize,
+                                         FLOAT                                            lipschitzConstant,
+                                         IndexedMesh&                                     mesh,
+                                         ThreadPool*                                      pool)
+{
+    const auto mayContainSurface = [&f, lipschitzConstant](const Point3F& min, const Point3F& max) {
+        const Point3F center = (min + max) * 0.5;
+        return std::abs(f(center.x, center.y, center.z)) <= lipschitzConstant * 0.5 * (max - min).calcNorm();
+    };
+
+    generateCulledMesh(f, bounds, cellSize, mayContainSurface, mesh, pool);
+}
+
+void MarchingCubes::generateCulledMesh(const std::function<FLOAT(FLOAT, FLOAT, FLOAT)>&           f,
+                                       const Cuboid&                                              bounds,
+                                       FLOAT                                                      cellSize,
+                                       const std::function<bool(const Point3F&, const Point3F&)>& mayContainSurface,
+                                       IndexedMesh&                                               mesh,
+                                       ThreadPool*                                                pool)
+{
+    checkCellSize(cellSize);
+
+    // Cells and vertices are kept by their coordinates i, j and k, so the empty space of a sparse grid
+    // takes no memory and its size is not limited by linear indices
+    using GridIndex = std::array<size_t, 3>;
+
+    const UniformAxis xs(bounds.startingPoint.x, bounds.startingPoint.x + bounds.width, cellSize);
+    const UniformAxis ys(bounds.startingPoint.y, bounds.startingPoint.y + bounds.length, cellSize);
+    const UniformAxis zs(bounds.startingPoint.z, bounds.startingPoint.z + bounds.height, cellSize);
+
+    // Boxes of cells [first, last) along every axis, the root covers the whole grid
+    struct Box
+    {
+        size_t first[3];
+        size_t last[3];
+    };
+
+    std::vector<Box> boxes = {{{0u, 0u, 0u}, {xs.size() - 1u, ys.size() - 1u, zs.size() - 1u}}};
+    std::vector<GridIndex> surfaceCells;
+
+    while (!boxes.empty())
     {
-        CubeValue[iVertex] =
-            f(fX + VertexOffset[iVertex][0], fY + VertexOffset[iVertex][1], fZ + VertexOffset[iVertex][2]);
+        const Box box = boxes.back();
+        boxes.pop_back();
+
+        if (box.last[0] - box.first[0] == 1u && box.last[1] - box.first[1] == 1u && box.last[2] - box.first[2] == 1u)
+        {
+            // Corners of single cells are classified directly
+            surfaceCells.push_back({box.first[0], box.first[1], box.first[2]});
+            continue;
+        }
+
+        if (!mayContainSurface(Point3F(xs[box.first[0]], ys[box.first[1]], zs[box.first[2]]),
+                               Point3F(xs[box.last[0]], ys[box.last[1]], zs[box.last[2]])))
+            continue;
+
+        // Halves of every axis longer than one cell
+        size_t splits[3][3];
+        size_t partsNumbers[3];
+        for (size_t axis = 0u; axis < 3u; ++axis)
+        {
+            const size_t middle = box.first[axis] + (box.last[axis] - box.first[axis]) / 2u;
+            const bool isSplit = box.last[axis] - box.first[axis] > 1u;
+
+            splits[axis][0] = box.first[axis];
+            splits[axis][1] = isSplit ? middle : box.last[axis];
+            splits[axis][2] = box.last[axis];
+            partsNumbers[axis] = isSplit ? 2u : 1u;
+        }
+
+        for (size_t a = 0u; a < partsNumbers[0]; ++a)
+            for (size_t b = 0u; b < partsNumbers[1]; ++b)
+                for (size_t c = 0u; c < partsNumbers[2]; ++c)
+                    boxes.push_back({{splits[0][a], splits[1][b], splits[2][c]},
+                                     {splits[0][a + 1u], splits[1][b + 1u], splits[2][c + 1u]}});
     }
 
+    // In the order of the uniform grid, so the mesh is the same as the one of generateMesh()
+    std::sort(surfaceCells.begin(), surfaceCells.end());
+
+    // Vertices of the kept cells, every vertex is evaluated once
+    std::vector<GridIndex> vertices;
+    vertices.reserve(surfaceCells.size() * CUBE_VERTICES_NUMBER);
+
+    for (const GridIndex& cell : surfaceCells)
+        for (int iVertex = 0; iVertex < CUBE_VERTICES_NUMBER; iVertex++)
+            vertices.push_back({cell[0] + VERTEX_STEPS.steps[iVertex][0], cell[1] + VERTEX_STEPS.steps[iVertex][1],
+                                cell[2] + VERTEX_STEPS.steps[iVertex][2]});
+
+    std::sort(vertices.begin(), vertices.end());
+    vertices.erase(std::unique(vertices.begin(), vertices.end()), vertices.end());
+
+    std::vector<FLOAT> values(vertices.size());
+
+    const auto evaluateVertices = [&f, &xs, &ys, &zs, &vertices, &values](size_t begin, size_t end) {
+        for (size_t v = begin; v < end; ++v)
+            values[v] = f(xs[vertices[v][0]], ys[vertices[v][1]], zs[vertices[v][2]]);
+    };
+
+    if (pool != nullptr)
+        pool->parallelForDynamic(0u, vertices.size(), evaluateVertices);
+    else
+        evaluateVertices(0u, vertices.size());
+
+    const auto getVertexRank = [&vertices](size_t i, size_t j, size_t k) {
+        return static_cast<size_t>(std::lower_bound(vertices.begin(), vertices.end(), GridIndex{i, j, k}) -
+                                   vertices.begin());
+    };
+
+    const auto getValue = [&getVertexRank, &values](size_t i, size_t j, size_t k) {
+        return values[getVertexRank(i, j, k)];
+    };
+
+    // The planes of a sparse grid may not fit the memory, so the edges are numbered by their lower vertices,
+    // which are corners of the kept cells
+    struct KeptEdgeCache
+    {
+        uint32_t& at(const size_t lower[], size_t axis)
+        {
+            return vertexOfEdge[getRank(lower[0], lower[1], lower[2]) * CUBE_DIMENSION + axis];
+        }
+
+        const decltype(getVertexRank)& getRank;
+
+        std::vector<uint32_t> vertexOfEdge;
+    };
+
+    KeptEdgeCache cache{getVertexRank,
+                        std::vector<uint32_t>(vertices.size() * CUBE_DIMENSION, SlabEdgeCache::NoVertex)};
+
+    mesh.clear();
+
+    VectorsWriter<Point3F> writer(mesh.vertices, nullptr, mesh.indices);
+    CellMesher<decltype(getValue), KeptEdgeCache, decltype(writer), MakePosition, UniformAxis> mesher(
+        xs, ys, zs, getValue, cache, writer);
+
+    FLOAT CubeValue[CUBE_VERTICES_NUMBER];
+
+    for (const GridIndex& cell : surfaceCells)
+    {
+        for (int iVertex = 0; iVertex < CUBE_VERTICES_NUMBER; iVertex++)
+            CubeValue[iVertex] = getValue(cell[0] + VERTEX_STEPS.steps[iVertex][0],
+                                          cell[1] + VERTEX_STEPS.steps[iVertex][1],
+                                          cell[2] + VERTEX_STEPS.steps[iVertex][2]);
+
+        const int iFlagIndex = determineFlag(CubeValue);
+        if (CubeEdgeFlags[iFlagIndex] != 0)
+            mesher.addCell(cell[0], cell[1], cell[2], iFlagIndex);
+    }
+}
+
+IncrementalMarchingCubes::IncrementalMarchingCubes(const Cuboid& bounds,
+                                                   FLOAT         cellSize,
+                                                   size_t        blockSize,
+                                                   FLOAT         tolerance)
+    : m_blockSize(blockSize)
+    , m_tolerance(tolerance)
+{
+    checkCellSize(cellSize);
+
+    if (blockSize == 0u)
+        throw std::invalid_argument("Marching cubes block size must be positive");
+
+    m_xs = getGridCoordinates(bounds.startingPoint.x, bounds.startingPoint.x + bounds.width, cellSize);
+    m_ys = getGridCoordinates(bounds.startingPoint.y, bounds.startingPoint.y + bounds.length, cellSize);
+    m_zs = getGridCoordinates(bounds.startingPoint.z, bounds.startingPoint.z + bounds.height, cellSize);
+
+    const size_t cellsNumbers[3] = {m_xs.size() - 1u, m_ys.size() - 1u, m_zs.size() - 1u};
+    for (size_t axis = 0u; axis < 3u; ++axis)
+        m_blocksNumber[axis] = (cellsNumbers[axis] + blockSize - 1u) / blockSize;
+
+    m_chunks.resize(m_blocksNumber[0] * m_blocksNumber[1] * m_blocksNumber[2]);
+}
+
+const SizetVector& IncrementalMarchingCubes::update(const std::function<FLOAT(FLOAT, FLOAT, FLOAT)>& f,
+                                                    ThreadPool*                                     pool)
+{
+    const size_t threadsNumber = pool != nullptr ? pool->getThreadsNumber() : 1u;
+    const bool isFirstUpdate = m_meshedValues.empty();
+
+    m_meshedValues.resize(m_xs.size() * m_ys.size() * m_zs.size());
+    m_isChanged.resize(m_meshedValues.size());
+
+    const auto evaluateSlabs = [this, &f, isFirstUpdate](size_t firstSlab, size_t lastSlab, size_t) {
+        for (size_t i = firstSlab; i < lastSlab; ++i)
+            for (size_t j = 0u; j < m_ys.size(); ++j)
+                for (size_t k = 0u; k < m_zs.size(); ++k)
+                {
+                    const size_t vertex = getVertexIndex(i, j, k);
+                    const FLOAT value = f(m_xs[i], m_ys[j], m_zs[k]);
+                    const FLOAT meshedValue = m_meshedValues[vertex];
+
+                    const bool isChanged = isFirstUpdate || (value > 0) != (meshedValue > 0) ||
+                                           std::abs(value - meshedValue) > m_tolerance;
+
+                    m_isChanged[vertex] = isChanged ? 1u : 0u;
+
+                    if (isChanged)
+                        m_meshedValues[vertex] = value;
+                }
+    };
+
+    forEachSlabRange(m_xs.size(), pool, threadsNumber, evaluateSlabs);
+
+    // A block is remeshed when any vertex of its cells changed, including the ones on its faces
+    std::vector<uint8_t> isBlockChanged(m_chunks.size(), 0u);
+
+    const auto findChangedBlocks = [this, &isBlockChanged](size_t begin, size_t end) {
+        for (size_t block = begin; block < end; ++block)
+        {
+            const size_t blockCoordinates[3] = {block / m_blocksNumber[2] / m_blocksNumber[1],
+                                                block / m_blocksNumber[2] % m_blocksNumber[1],
+                                                block % m_blocksNumber[2]};
+            const size_t verticesNumbers[3] = {m_xs.size(), m_ys.size(), m_zs.size()};
+
+            size_t first[3];
+            size_t last[3];
+            for (size_t axis = 0u; axis < 3u; ++axis)
+            {
+                first[axis] = blockCoordinates[axis] * m_blockSize;
+                last[axis] = std::min(first[axis] + m_blockSize + 1u, verticesNumbers[axis]);
+            }
+
+            for (size_t i = first[0]; i < last[0] && isBlockChanged[block] == 0u; ++i)
+                for (size_t j = first[1]; j < last[1] && isBlockChanged[block] == 0u; ++j)
+                    for (size_t k = first[2]; k < last[2]; ++k)
+                        if (m_isChanged[getVertexIndex(i, j, k)] != 0u)
+                        {
+                            isBlockChanged[block] = 1u;
+                            break;
+                        }
+        }
+    };
+
+    if (pool != nullptr)
+        pool->parallelFor(0u, m_chunks.size(), findChangedBlocks);
+    else
+        findChangedBlocks(0u, m_chunks.size());
+
+    m_updatedBlocks.clear();
+    for (size_t block = 0u; block < m_chunks.size(); ++block)
+        if (isBlockChanged[block] != 0u)
+            m_updatedBlocks.push_back(block);
+
+    // Chunks are independent, every block writes only its own one
+    const auto remeshBlocks = [this](size_t begin, size_t end) {
+        for (size_t updated = begin; updated < end; ++updated)
+            remeshBlock(m_updatedBlocks[updated]);
+    };
+
+    if (pool != nullptr)
+        pool->parallelFor(0u, m_updatedBlocks.size(), remeshBlocks);
+    else
+        remeshBlocks(0u, m_updatedBlocks.size());
+
+    return m_updatedBlocks;
+}
+
+size_t IncrementalMarchingCubes::getBlocksNumber() const
+{
+    return m_chunks.size();
+}
+
+const IndexedMesh& IncrementalMarchingCubes::getChunk(size_t block) const
+{
+    return m_chunks.at(block).mesh;
+}
+
+void IncrementalMarchingCubes::gatherMesh(IndexedMesh& mesh) const
+{
+    size_t verticesNumber = 0u;
+    size_t indicesNumber = 0u;
+    for (const Chunk& chunk : m_chunks)
+    {
+        verticesNumber += chunk.mesh.vertices.size();
+        indicesNumber += chunk.mesh.indices.size();
+    }
+
+    mesh.clear();
+    mesh.vertices.reserve(verticesNumber);
+    mesh.indices.reserve(indicesNumber);
+
+    std::unordered_map<uint64_t, uint32_t> vertexOfEdge;
+    std::vector<uint32_t> meshVertices;
+
+    for (const Chunk& chunk : m_chunks)
+    {
+        meshVertices.resize(chunk.mesh.vertices.size());
+
+        for (size_t vertex = 0u; vertex < chunk.mesh.vertices.size(); ++vertex)
+        {
+            const auto inserted =
+                vertexOfEdge.emplace(chunk.edges[vertex], static_cast<uint32_t>(mesh.vertices.size()));
+
+            if (inserted.second)
+                mesh.vertices.push_back(chunk.mesh.vertices[vertex]);
+
+            meshVertices[vertex] = inserted.first->second;
+        }
+
+        for (const uint32_t index : chunk.mesh.indices)
+            mesh.indices.push_back(meshVertices[index]);
+    }
+}
+
+void IncrementalMarchingCubes::remeshBlock(size_t block)
+{
+    Chunk& chunk = m_chunks[block];
+    chunk.mesh.clear();
+    chunk.edges.clear();
+
+    const auto getValue = [this](size_t i, size_t j, size_t k) { return m_meshedValues[getVertexIndex(i, j, k)]; };
+    thread_local SlabEdgeCache cache;
+    cache.reset(m_ys.size(), m_zs.size());
+
+    VectorsWriter<Point3F> writer(chunk.mesh.vertices, &chunk.edges, chunk.mesh.indices);
+    CellMesher<decltype(getValue), SlabEdgeCache, decltype(writer)> mesher(m_xs, m_ys, m_zs, getValue, cache, writer);
+
+    const size_t blockCoordinates[3] = {block / m_blocksNumber[2] / m_blocksNumber[1],
+                                        block / m_blocksNumber[2] % m_blocksNumber[1], block % m_blocksNumber[2]};
+    const size_t cellsNumbers[3] = {m_xs.size() - 1u, m_ys.size() - 1u, m_zs.size() - 1u};
+
+    size_t first[3];
+    size_t last[3];
+    for (size_t axis = 0u; axis < 3u; ++axis)
+    {
+        first[axis] = blockCoordinates[axis] * m_blockSize;
+        last[axis] = std::min(first[axis] + m_blockSize, cellsNumbers[axis]);
+    }
+
+    FLOAT CubeValue[CUBE_VERTICES_NUMBER];
+
+    for (size_t i = first[0]; i < last[0]; ++i)
+        for (size_t j = first[1]; j < last[1]; ++j)
+            for (size_t k = first[2]; k < last[2]; ++k)
+            {
+                for (int iVertex = 0; iVertex < CUBE_VERTICES_NUMBER; iVertex++)
+                    CubeValue[iVertex] = getValue(i + VERTEX_STEPS.steps[iVertex][0],
+                                                  j + VERTEX_STEPS.steps[iVertex][1],
+                                                  k + VERTEX_STEPS.steps[iVertex][2]);
+
+                const int iFlagIndex = getFlagIndex(CubeValue);
+                if (CubeEdgeFlags[iFlagIndex] != 0)
+                    mesher.addCell(i, j, k, iFlagIndex);
+            }
+}
+
+size_t IncrementalMarchingCubes::getVertexIndex(size_t i, size_t j, size_t k) const
+{
+    return (i * m_ys.size() + j) * m_zs.size() + k;
+}
+
+void MarchingCubes::MarchingCube(
+    const FLOAT CubeValue[], FLOAT fX, FLOAT fY, FLOAT fZ, FLOAT cellSize, Point3FVector& trianglesMesh)
+{
     // Find which vertices are inside of the surface and which are outside
     int iFlagIndex = determineFlag(CubeValue);
 
@@ -64,18 +1143,19 @@ Point3FVector MarchingCubes::MarchingCube(std::function<FLOAT(FLOAT, FLOAT, FLOA
     // If the cube is entirely inside or outside of the surface, then there will be no intersections
     if (iEdgeFlags == 0)
     {
-        return trianglesMesh;
+        return;
     }
 
     // Fill the triangles that were found.  There can be up to five per cube
-    fillFoundTriangles(trianglesMesh, findPointIntersection(iEdgeFlags, CubeValue, fX, fY, fZ), iFlagIndex);
+    Point3F EdgeVertex[CUBE_EDGES_NUMBER];
+    findPointIntersection(iEdgeFlags, CubeValue, fX, fY, fZ, cellSize, EdgeVertex);
 
-    return trianglesMesh;
+    fillFoundTriangles(trianglesMesh, EdgeVertex, iFlagIndex);
 }
 
-void MarchingCubes::fillFoundTriangles(Point3FVector&       resultEdgeVertex,
-                                       const Point3FVector& EdgeVertex,
-                                       const int           iFlagIndex)
+void MarchingCubes::fillFoundTriangles(Point3FVector& resultEdgeVertex,
+                                       const Point3F  EdgeVertex[],
+                                       const int      iFlagIndex)
 {
     for (int iTriangle = 0; iTriangle < TRIANGLES_MAX_NUMBER_FOR_ONE_CUBE; iTriangle++)
     {
@@ -93,10 +1173,16 @@ void MarchingCubes::fillFoundTriangles(Point3FVector&       resultEdgeVertex,
 }
 
 // Find points of intersection on each edge
-Point3FVector MarchingCubes::findPointIntersection(
-    const int iEdgeFlags, const FLOAT CubeValue[], const FLOAT fX, const FLOAT fY, const FLOAT fZ)
+void MarchingCubes::findPointIntersection(const int   iEdgeFlags,
+                                          const FLOAT CubeValue[],
+                                          const FLOAT fX,
+                                          const FLOAT fY,
+                                          const FLOAT fZ,
+                                          const FLOAT cellSize,
+                                          Point3F     EdgeVertex[])
 {
-    Point3FVector EdgeVertex(12);
+    // VertexOffset scaled to the cell size
+    const auto offset = [cellSize](int iVertex, int axis) { return VertexOffset[iVertex][axis] > 0.0 ? cellSize : 0.0; };
 
     for (int iEdge = 0; iEdge < CUBE_EDGES_NUMBER; iEdge++)
     {
@@ -113,24 +1199,15 @@ Point3FVector MarchingCubes::findPointIntersection(
             const auto t0 = 1 - adapt(f0, f1);
             const auto t1 = 1 - t0;
 
-            EdgeVertex[iEdge].x = fX + VertexOffset[v0][0] * t0 + VertexOffset[v1][0] * t1;
-            EdgeVertex[iEdge].y = fY + VertexOffset[v0][1] * t0 + VertexOffset[v1][1] * t1;
-            EdgeVertex[iEdge].z = fZ + VertexOffset[v0][2] * t0 + VertexOffset[v1][2] * t1;
+            EdgeVertex[iEdge].x = fX + offset(v0, 0) * t0 + offset(v1, 0) * t1;
+            EdgeVertex[iEdge].y = fY + offset(v0, 1) * t0 + offset(v1, 1) * t1;
+            EdgeVertex[iEdge].z = fZ + offset(v0, 2) * t0 + offset(v1, 2) * t1;
         }
     }
-    return EdgeVertex;
 }
+
 int MarchingCubes::determineFlag(const FLOAT CubeValue[])
 {
-    int flagIndex = 0;
-
-    for (int iVertexTest = 0; iVertexTest < CUBE_VERTICES_NUMBER; iVertexTest++)
-    {
-        if (CubeValue[iVertexTest] > 0)
-        {
-            flagIndex |= 1 << iVertexTest;
-        }
-    }
-    return flagIndex;
+    return getFlagIndex(CubeValue);
 }
 } // namespace SPHSDK
@@ -7,38 +7,347 @@
 #ifndef MARCHING_CUBES_H_43C34465A6ED4DB9B9F2F4C3937BF5DC
 #define MARCHING_CUBES_H_43C34465A6ED4DB9B9F2F4C3937BF5DC
 
+#include "Area.h"
+#include "Defines.h"
 #include "Point.h"
 
+#include <cstdint>
 #include <functional>
+#include <ostream>
+#include <vector>
 
 namespace SPHSDK
 {
 
+class ThreadPool;
+
+/**
+ * @brief IndexedMesh struct keeps a triangle mesh as a vertex buffer and an index buffer,
+ * every three indices are one triangle.
+ */
+struct IndexedMesh
+{
+    /**
+     * @brief Empties the buffers keeping their capacity.
+     */
+    void clear();
+
+    size_t getTrianglesNumber() const;
+
+    /**
+     * @brief Writes vertices ("v") and triangles ("f") in Wavefront OBJ format.
+     */
+    void saveObj(std::ostream& stream) const;
+
+    Point3FVector vertices;
+
+    std::vector<uint32_t> indices;
+};
+
+/**
+ * @brief MeshVertex struct keeps the position of a vertex with its unit normal pointing out of the surface.
+ */
+struct MeshVertex
+{
+    Point3F position;
+
+    Point3F normal;
+};
+
+/**
+ * @brief ShadedMesh struct keeps an indexed mesh with normals, they are interleaved with positions in one buffer.
+ */
+struct ShadedMesh
+{
+    /**
+     * @brief Empties the buffers keeping their capacity.
+     */
+    void clear();
+
+    size_t getTrianglesNumber() const;
+
+    /**
+     * @brief Writes vertices ("v"), normals ("vn") and triangles ("f") in Wavefront OBJ format.
+     */
+    void saveObj(std::ostream& stream) const;
+
+    std::vector<MeshVertex> vertices;
+
+    std::vector<uint32_t> indices;
+};
+
+/**
+ * @brief MarchingCubesGrid struct keeps the values of a function in the vertices of a grid of cubes.
+ * z is the fastest index, so the values of a row of vertices along z are contiguous.
+ */
+struct MarchingCubesGrid
+{
+    /**
+     * @param bounds      The box covered by the grid, the last cells along an axis may stick out of it
+     * @param cellSize    The side of one grid cube
+     * @throw std::invalid_argument if the cell size is not positive
+     */
+    MarchingCubesGrid(const Cuboid& bounds, FLOAT cellSize);
+
+    /**
+     * @brief Evaluates the function in every vertex of the grid, a row along z at a time.
+     * F is either f(x, y, z) or the batched f(xs, ys, zs, out, n), which fills out[i] = f(xs[i], ys[i], zs[i])
+     * for the n vertices of a row. Both are called directly, so cheap fields are inlined into the row loop
+     * and a batched field may vectorise it.
+     * @param pool    The pool evaluating slabs of rows in parallel, may be nullptr
+     */
+    template <class F> void evaluate(const F& f, ThreadPool* pool = nullptr);
+
+    size_t getIndex(size_t i, size_t j, size_t k) const;
+
+    size_t getCellsNumber(size_t axis) const;
+
+    void getCubeValues(size_t i, size_t j, size_t k, FLOAT CubeValue[]) const;
+
+    /**
+     * @brief Returns central differences of the values in the vertex, one-sided on the sides of the grid.
+     */
+    Point3F getGradient(size_t i, size_t j, size_t k) const;
+
+    FLOAT cellSize;
+
+    std::vector<FLOAT> xs;
+    std::vector<FLOAT> ys;
+    std::vector<FLOAT> zs;
+
+    std::vector<FLOAT> values;
+};
+
 /**
  * @brief MarchingCubes class implements Marching Cubes algorithm.
+ *
+ * The mesh is generated in two phases: the function is evaluated once per grid vertex into a buffer,
+ * then the cells are classified and triangulated reading the buffer, so shared corners are not evaluated again.
+ * Both phases run over slabs of the grid along x in parallel, every thread writes its own triangles,
+ * which are merged in the order of slabs, so the mesh does not depend on the number of threads.
+ * Indexed meshes are counted per range of slabs first, then every thread writes straight into its part
+ * of the buffers of the mesh.
  */
 class MarchingCubes
 {
 
 public:
+    // Cells along one axis of a grid, bounds needing more of them are rejected
+    static constexpr size_t MaxCellsNumber = static_cast<size_t>(1u) << 40u;
+
     /**
      * @brief Generates triangles mesh from function
-     * @param f    The function that represents the domain equation
+     * @param f       The function that represents the domain equation
+     * @param pool    The pool evaluating the function and triangulating cells in parallel, may be nullptr
+     * @return triangle soup, every three points are one triangle
+     */
+    static Point3FVector generateMesh(const std::function<FLOAT(FLOAT, FLOAT, FLOAT)>& f, ThreadPool* pool = nullptr);
+
+    /**
+     * @brief Generates triangles mesh from function in the given bounds.
+     * @param bounds      The box covered by the grid, the last cells along an axis may stick out of it
+     * @param cellSize    The side of one grid cube
+     * @throw std::invalid_argument if the cell size is not positive
+     */
+    static Point3FVector generateMesh(const std::function<FLOAT(FLOAT, FLOAT, FLOAT)>& f,
+                                      const Cuboid&                                    bounds,
+                                      FLOAT                                            cellSize,
+                                      ThreadPool*                                      pool = nullptr);
+
+    /**
+     * @brief Generates indexed mesh from function, triangles of neighbouring cells share the vertices
+     * on their common grid edges. The vertices are added in the order the serial generation meets them.
+     * @param mesh    Replaced by the result, its buffers are reused, so a reserved mesh is not reallocated
      */
-    static Point3FVector generateMesh(std::function<FLOAT(FLOAT, FLOAT, FLOAT)> f);
+    static void generateMesh(const std::function<FLOAT(FLOAT, FLOAT, FLOAT)>& f,
+                             IndexedMesh&                                    mesh,
+                             ThreadPool*                                     pool = nullptr);
+
+    /**
+     * @brief Generates indexed mesh from function in the given bounds, see the overloads above.
+     */
+    static void generateMesh(const std::function<FLOAT(FLOAT, FLOAT, FLOAT)>& f,
+                             const Cuboid&                                    bounds,
+                             FLOAT                                            cellSize,
+                             IndexedMesh&                                     mesh,
+                             ThreadPool*                                      pool = nullptr);
+
+    /**
+     * @brief Generate the same meshes as the overloads above from a function of any type.
+     * F is either f(x, y, z) or the batched f(xs, ys, zs, out, n), see MarchingCubesGrid::evaluate().
+     * It is called without type erasure, so cheap fields are inlined into the loop over a row of grid vertices.
+     */
+    template <class F> static Point3FVector generateMesh(const F& f, ThreadPool* pool = nullptr);
+
+    template <class F>
+    static Point3FVector generateMesh(const F& f, const Cuboid& bounds, FLOAT cellSize, ThreadPool* pool = nullptr);
+
+    template <class F> static void generateMesh(const F& f, IndexedMesh& mesh, ThreadPool* pool = nullptr);
+
+    template <class F>
+    static void
+    generateMesh(const F& f, const Cuboid& bounds, FLOAT cellSize, IndexedMesh& mesh, ThreadPool* pool = nullptr);
+
+    /**
+     * @brief Generates indexed mesh with normals from function in the given bounds, see the overloads above.
+     * The normals are interpolated along the grid edges from central differences of the values cached
+     * in the grid vertices, so they cost no evaluations of the function and no second pass over the mesh.
+     */
+    static void generateMesh(const std::function<FLOAT(FLOAT, FLOAT, FLOAT)>& f,
+                             const Cuboid&                                    bounds,
+                             FLOAT                                            cellSize,
+                             ShadedMesh&                                      mesh,
+                             ThreadPool*                                      pool = nullptr);
+
+    /**
+     * @brief Generates indexed mesh with normals from function in the given bounds,
+     * the normals are taken from the gradient of the function evaluated once in every vertex of the mesh.
+     */
+    static void generateMesh(const std::function<FLOAT(FLOAT, FLOAT, FLOAT)>&   f,
+                             const std::function<Point3F(FLOAT, FLOAT, FLOAT)>& gradient,
+                             const Cuboid&                                      bounds,
+                             FLOAT                                              cellSize,
+                             ShadedMesh&                                        mesh,
+                             ThreadPool*                                        pool = nullptr);
+
+    /**
+     * @brief Generates the same indexed mesh as generateMesh() in the given bounds evaluating the function
+     * only near its surface. An octree over the cells skips boxes where the function can not reach zero,
+     * |f(center)| > lipschitzConstant * (half of the box diagonal), and splits the others down to single cells.
+     * The cells kept are triangulated on the grid of the bounds, so boxes of different sizes leave no cracks.
+     * @param lipschitzConstant    An upper bound of |grad f| in the bounds, a smaller one may lose parts of the surface
+     * @param pool                 The pool evaluating the function in the vertices of kept cells, may be nullptr
+     * @throw std::invalid_argument if the cell size is not positive
+     */
+    static void generateAdaptiveMesh(const std::function<FLOAT(FLOAT, FLOAT, FLOAT)>& f,
+                                     const Cuboid&                                    bounds,
+                                     FLOAT                                            cellSize,
+                                     FLOAT                                            lipschitzConstant,
+                                     IndexedMesh&                                     mesh,
+                                     ThreadPool*                                      pool = nullptr);
+
+    /**
+     * @brief Generates the same indexed mesh as generateMesh() in the given bounds triangulating only the cells
+     * of octree boxes kept by mayContainSurface(min, max), which is asked for every box of more than one cell.
+     * Single cells are classified by their corners, the function is evaluated only in vertices of kept cells,
+     * once per vertex. Memory and time do not depend on the empty cells, so the bounds may be large and sparse.
+     * @param pool    The pool evaluating the function in the vertices in parallel, may be nullptr
+     * @throw std::invalid_argument if the cell size is not positive or an axis has more than MaxCellsNumber cells
+     */
+    static void generateCulledMesh(const std::function<FLOAT(FLOAT, FLOAT, FLOAT)>&           f,
+                                   const Cuboid&                                              bounds,
+                                   FLOAT                                                      cellSize,
+                                   const std::function<bool(const Point3F&, const Point3F&)>& mayContainSurface,
+                                   IndexedMesh&                                               mesh,
+                                   ThreadPool*                                                pool = nullptr);
 
 private:
-    static Point3FVector MarchingCube(std::function<FLOAT(FLOAT, FLOAT, FLOAT)> f, FLOAT fX, FLOAT fY, FLOAT fZ);
+    // The grid meshed when no bounds are given
+    static Cuboid getDefaultBounds();
+
+    static FLOAT getDefaultCellSize();
+
+    static Point3FVector triangulate(const MarchingCubesGrid& grid, ThreadPool* pool);
+
+    static void triangulate(const MarchingCubesGrid& grid, IndexedMesh& mesh, ThreadPool* pool);
+
+    static void MarchingCube(
+        const FLOAT CubeValue[], FLOAT fX, FLOAT fY, FLOAT fZ, FLOAT cellSize, Point3FVector& trianglesMesh);
 
     static void
-    fillFoundTriangles(Point3FVector& resultEdgeVertex, const Point3FVector& EdgeVertex, const int iFlagIndex);
+    fillFoundTriangles(Point3FVector& resultEdgeVertex, const Point3F EdgeVertex[], const int iFlagIndex);
 
-    static Point3FVector findPointIntersection(
-        const int iEdgeFlags, const FLOAT CubeValue[], const FLOAT fX, const FLOAT fY, const FLOAT fZ);
+    static void findPointIntersection(const int   iEdgeFlags,
+                                      const FLOAT CubeValue[],
+                                      const FLOAT fX,
+                                      const FLOAT fY,
+                                      const FLOAT fZ,
+                                      const FLOAT cellSize,
+                                      Point3F     EdgeVertex[]);
 
     static int determineFlag(const FLOAT CubeValue[]);
 };
 
+/**
+ * @brief IncrementalMarchingCubes class keeps the indexed mesh of a changing function on a fixed grid.
+ * The grid is split into cubic blocks of cells, every block has its own mesh chunk, and an update
+ * regenerates only the chunks of blocks where the function changed since it was meshed.
+ *
+ * A grid vertex counts as changed when its value moves by more than the tolerance from the value
+ * it was last meshed with, or changes its sign, so the topology is always exact and the vertices drift
+ * at most by the tolerance. All blocks sharing a changed vertex are remeshed with the same values,
+ * so chunks always match on the faces between blocks.
+ */
+class IncrementalMarchingCubes
+{
+public:
+    /**
+     * @param bounds       The box covered by the grid, the last cells along an axis may stick out of it
+     * @param cellSize     The side of one grid cube
+     * @param blockSize    Cells along every side of a block, the last blocks along an axis may be smaller
+     * @param tolerance    Changes of the function up to it are not remeshed
+     * @throw std::invalid_argument if the cell size or the block size is not positive
+     */
+    IncrementalMarchingCubes(const Cuboid& bounds, FLOAT cellSize, size_t blockSize = 16u, FLOAT tolerance = 0.0);
+
+    /**
+     * @brief Evaluates the function in the vertices of the grid and remeshes the blocks where it changed.
+     * @param pool    The pool evaluating the function and remeshing blocks in parallel, may be nullptr
+     * @return The blocks remeshed, in increasing order, all of them on the first update
+     */
+    const SizetVector& update(const std::function<FLOAT(FLOAT, FLOAT, FLOAT)>& f, ThreadPool* pool = nullptr);
+
+    size_t getBlocksNumber() const;
+
+    /**
+     * @brief Returns the triangles of the cells of the block, vertices on its faces are repeated in the chunks
+     * of the neighbouring blocks.
+     */
+    const IndexedMesh& getChunk(size_t block) const;
+
+    /**
+     * @brief Replaces mesh with all chunks, the vertices on the faces between blocks are shared.
+     */
+    void gatherMesh(IndexedMesh& mesh) const;
+
+private:
+    struct Chunk
+    {
+        IndexedMesh mesh;
+
+        // Grid edge of every vertex
+        std::vector<uint64_t> edges;
+    };
+
+    void remeshBlock(size_t block);
+
+    size_t getVertexIndex(size_t i, size_t j, size_t k) const;
+
+private:
+    std::vector<FLOAT> m_xs;
+    std::vector<FLOAT> m_ys;
+    std::vector<FLOAT> m_zs;
+
+    size_t m_blockSize;
+
+    FLOAT m_tolerance;
+
+    // Blocks along x, y and z
+    size_t m_blocksNumber[3] = {0u, 0u, 0u};
+
+    // The values of the function in the grid vertices the chunks are built with
+    std::vector<FLOAT> m_meshedValues;
+
+    // Vertices changed by the last update
+    std::vector<uint8_t> m_isChanged;
+
+    std::vector<Chunk> m_chunks;
+
+    SizetVector m_updatedBlocks;
+};
+
 } // namespace SPHSDK
 
+#include "MarchingCubes.hpp"
+
 #endif // MARCHING_CUBES_H_43C34465A6ED4DB9B9F2F4C3937BF5DC
@@ -0,0 +1,87 @@
+/**
+ * @file MarchingCubes.hpp
+ * @author Anton Artyukh (artyukhanton@gmail.com)
+ * @date Created Oct 19, 2026
+ **/
+
+#ifndef MARCHING_CUBES_HPP_0C7E25B9D4A14F3E8B61A9F2E5D8C703
+#define MARCHING_CUBES_HPP_0C7E25B9D4A14F3E8B61A9F2E5D8C703
+
+#include "MarchingCubes.h"
+#include "ThreadPool.h"
+
+#include <type_traits>
+
+namespace SPHSDK
+{
+
+template <class F> void MarchingCubesGrid::evaluate(const F& f, ThreadPool* pool)
+{
+    constexpr bool isBatched =
+        std::is_invocable<const F&, const FLOAT*, const FLOAT*, const FLOAT*, FLOAT*, size_t>::value;
+
+    const auto evaluateSlabs = [this, &f](size_t firstSlab, size_t lastSlab) {
+        // x and y of the row repeated for the batched form
+        std::vector<FLOAT> rowXs;
+        std::vector<FLOAT> rowYs;
+
+        for (size_t i = firstSlab; i < lastSlab; ++i)
+            for (size_t j = 0u; j < ys.size(); ++j)
+            {
+                FLOAT* row = values.data() + getIndex(i, j, 0u);
+
+                if constexpr (isBatched)
+                {
+                    rowXs.assign(zs.size(), xs[i]);
+                    rowYs.assign(zs.size(), ys[j]);
+                    f(rowXs.data(), rowYs.data(), zs.data(), row, zs.size());
+                }
+                else
+                {
+                    const FLOAT x = xs[i];
+                    const FLOAT y = ys[j];
+
+                    for (size_t k = 0u; k < zs.size(); ++k)
+                        row[k] = f(x, y, zs[k]);
+                }
+            }
+    };
+
+    if (pool != nullptr)
+        pool->parallelFor(0u, xs.size(), evaluateSlabs);
+    else
+        evaluateSlabs(0u, xs.size());
+}
+
+template <class F> Point3FVector MarchingCubes::generateMesh(const F& f, ThreadPool* pool)
+{
+    return generateMesh(f, getDefaultBounds(), getDefaultCellSize(), pool);
+}
+
+template <class F>
+Point3FVector MarchingCubes::generateMesh(const F& f, const Cuboid& bounds, FLOAT cellSize, ThreadPool* pool)
+{
+    MarchingCubesGrid grid(bounds, cellSize);
+    grid.evaluate(f, pool);
+
+    return triangulate(grid, pool);
+}
+
+template <class F> void MarchingCubes::generateMesh(const F& f, IndexedMesh& mesh, ThreadPool* pool)
+{
+    generateMesh(f, getDefaultBounds(), getDefaultCellSize(), mesh, pool);
+}
+
+template <class F>
+void MarchingCubes::generateMesh(
+    const F& f, const Cuboid& bounds, FLOAT cellSize, IndexedMesh& mesh, ThreadPool* pool)
+{
+    MarchingCubesGrid grid(bounds, cellSize);
+    grid.evaluate(f, pool);
+
+    triangulate(grid, mesh, pool);
+}
+
+} // namespace SPHSDK
+
+#endif // MARCHING_CUBES_HPP_0C7E25B9D4A14F3E8B61A9F2E5D8C703
@@ -0,0 +1,496 @@
+/**
+ * @file MeshBoundary.cpp
+ * @author Anton Artyukh (artyukhanton@gmail.com)
+ * @date Created Oct 19, 2026
+ **/
+
+#include "MeshBoundary.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+namespace SPHSDK
+{
+
+namespace
+{
+const FLOAT Pi = 3.14159265358979323846;
+
+// Buckets along the longest side of the acceleration grid at most
+const size_t MaxBucketsPerAxis = 256u;
+
+// Closest features of a triangle, edge k connects corners k and (k + 1) % 3
+enum class Feature
+{
+    Vertex0,
+    Vertex1,
+    Vertex2,
+    Edge0,
+    Edge1,
+    Edge2,
+    Face
+};
+
+inline FLOAT dot(const Point3F& a, const Point3F& b)
+{
+    return a.x * b.x + a.y * b.y + a.z * b.z;
+}
+
+inline Point3F cross(const Point3F& a, const Point3F& b)
+{
+    return Point3F(a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x);
+}
+
+// Ericson, Real-Time Collision Detection, 5.1.5
+Point3F findClosestPoint(const Point3F& p, const Point3F& a, const Point3F& b, const Point3F& c, Feature& feature)
+{
+    const Point3F ab = b - a;
+    const Point3F ac = c - a;
+
+    const Point3F ap = p - a;
+    const FLOAT d1 = dot(ab, ap);
+    const FLOAT d2 = dot(ac, ap);
+    if (d1 <= 0.0 && d2 <= 0.0)
+    {
+        feature = Feature::Vertex0;
+        return a;
+    }
+
+    const Point3F bp = p - b;
+    const FLOAT d3 = dot(ab, bp);
+    const FLOAT d4 = dot(ac, bp);
+    if (d3 >= 0.0 && d4 <= d3)
+    {
+        feature = Feature::Vertex1;
+        return b;
+    }
+
+    const FLOAT vc = d1 * d4 - d3 * d2;
+    if (vc <= 0.0 && d1 >= 0.0 && d3 <= 0.0)
+    {
+        feature = Feature::Edge0;
+        return a + ab * (d1 / (d1 - d3));
+    }
+
+    const Point3F cp = p - c;
+    const FLOAT d5 = dot(ab, cp);
+    const FLOAT d6 = dot(ac, cp);
+    if (d6 >= 0.0 && d5 <= d6)
+    {
+        feature = Feature::Vertex2;
+        return c;
+    }
+
+    const FLOAT vb = d5 * d2 - d1 * d6;
+    if (vb <= 0.0 && d2 >= 0.0 && d6 <= 0.0)
+    {
+        feature = Feature::Edge2;
+        return a + ac * (d2 / (d2 - d6));
+    }
+
+    const FLOAT va = d3 * d6 - d5 * d4;
+    if (va <= 0.0 && d4 - d3 >= 0.0 && d5 - d6 >= 0.0)
+    {
+        feature = Feature::Edge1;
+        return b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+    }
+
+    const FLOAT denominator = 1.0 / (va + vb + vc);
+    feature = Feature::Face;
+    return a + ab * (vb * denominator) + ac * (vc * denominator);
+}
+
+/**
+ * Signed distance to a triangle mesh. Triangles are bucketed into a grid with cells of maxDistance,
+ * so the closest triangle within maxDistance lies in the 27 buckets around the point.
+ * Empty buckets know their side of the surface from a flood fill of the grid started at its border.
+ */
+class MeshDistance
+{
+public:
+    MeshDistance(const TriangleMesh& mesh, FLOAT maxDistance)
+        : m_vertices(mesh.vertices)
+        , m_triangles(mesh.triangles)
+        , m_maxDistance(maxDistance)
+    {
+        computeNormals();
+        buildBuckets(mesh.getBoundingCuboid());
+    }
+
+    FLOAT operator()(FLOAT x, FLOAT y, FLOAT z) const
+    {
+        const Point3F point(x, y, z);
+
+        size_t bucket[3];
+        for (size_t axis = 0u; axis < 3u; ++axis)
+        {
+            const FLOAT coordinate = (getAxis(point, axis) - getAxis(m_origin, axis)) / m_bucketSize;
+
+            // Also rejects NaN, the grid covers the mesh with maxDistance around
+            if (!(coordinate >= 0.0 && coordinate < static_cast<FLOAT>(m_buckets[axis])))
+                return -m_maxDistance;
+
+            bucket[axis] = static_cast<size_t>(coordinate);
+        }
+
+        FLOAT bestDistanceSqr = m_maxDistance * m_maxDistance;
+        FLOAT sign = 0.0;
+
+        for (size_t k = bucket[2] == 0u ? 0u : bucket[2] - 1u; k <= bucket[2] + 1u && k < m_buckets[2]; ++k)
+            for (size_t j = bucket[1] == 0u ? 0u : bucket[1] - 1u; j <= bucket[1] + 1u && j < m_buckets[1]; ++j)
+                for (size_t i = bucket[0] == 0u ? 0u : bucket[0] - 1u; i <= bucket[0] + 1u && i < m_buckets[0]; ++i)
+                    for (const size_t triangle : m_bucketTriangles[getBucketIndex(i, j, k)])
+                    {
+                        // Most triangles of the 27 buckets are farther than the closest one found so far
+                        if (getBoxDistanceSqr(point, m_triangleMin[triangle], m_triangleMax[triangle]) >
+                            bestDistanceSqr)
+                            continue;
+
+                        const TriangleMesh::Triangle& corners = m_triangles[triangle];
+
+                        Feature feature = Feature::Face;
+                        const Point3F closest = findClosestPoint(point, m_vertices[corners[0]], m_vertices[corners[1]],
+                                                                 m_vertices[corners[2]], feature);
+
+                        const Point3F difference = point - closest;
+                        const FLOAT distanceSqr = difference.calcNormSqr();
+
+                        if (distanceSqr <= bestDistanceSqr)
+                        {
+                            bestDistanceSqr = distanceSqr;
+                            sign = dot(difference, getPseudonormal(triangle, feature)) > 0.0 ? -1.0 : 1.0;
+                        }
+                    }
+
+        if (sign != 0.0)
+            return sign * std::sqrt(bestDistanceSqr);
+
+        const size_t index = getBucketIndex(bucket[0], bucket[1], bucket[2]);
+        if (m_bucketTriangles[index].empty())
+            return m_isInsideBucket[index] ? m_maxDistance : -m_maxDistance;
+
+        return isInsideByWindingNumber(point) ? m_maxDistance : -m_maxDistance;
+    }
+
+private:
+    static FLOAT getAxis(const Point3F& point, size_t axis)
+    {
+        return axis == 0u ? point.x : (axis == 1u ? point.y : point.z);
+    }
+
+    static FLOAT getBoxDistanceSqr(const Point3F& point, const Point3F& min, const Point3F& max)
+    {
+        const FLOAT dx = std::max(0.0, std::max(min.x - point.x, point.x - max.x));
+        const FLOAT dy = std::max(0.0, std::max(min.y - point.y, point.y - max.y));
+        const FLOAT dz = std::max(0.0, std::max(min.z - point.z, point.z - max.z));
+
+        return dx * dx + dy * dy + dz * dz;
+    }
+
+    size_t getBucketIndex(size_t i, size_t j, size_t k) const
+    {
+        return i + m_buckets[0] * (j + m_buckets[1] * k);
+    }
+
+    const Point3F& getPseudonormal(size_t triangle, Feature feature) const
+    {
+        switch (feature)
+        {
+        case Feature::Vertex0:
+        case Feature::Vertex1:
+        case Feature::Vertex2:
+            return m_vertexNormals[m_triangles[triangle][static_cast<size_t>(feature)]];
+        case Feature::Edge0:
+        case Feature::Edge1:
+        case Feature::Edge2:
+            return m_edgeNormals[triangle][static_cast<size_t>(feature) - static_cast<size_t>(Feature::Edge0)];
+        default:
+            return m_faceNormals[triangle];
+        }
+    }
+
+    // Bærentzen and Aanæs, Signed distance computation using the angle weighted pseudonormal
+    void computeNormals()
+    {
+        m_faceNormals.resize(m_triangles.size());
+        m_edgeNormals.resize(m_triangles.size());
+        m_vertexNormals.assign(m_vertices.size(), Point3F());
+
+        std::map<std::pair<size_t, size_t>, Point3F> edgeSums;
+
+        for (size_t triangle = 0u; triangle < m_triangles.size(); ++triangle)
+        {
+            const TriangleMesh::Triangle& corners = m_triangles[triangle];
+
+            const Point3F normal = cross(m_vertices[corners[1]] - m_vertices[corners[0]],
+                                         m_vertices[corners[2]] - m_vertices[corners[0]]);
+            const FLOAT norm = normal.calcNorm();
+
+            m_faceNormals[triangle] = norm > 0.0 ? normal / norm : Point3F();
+
+            for (size_t corner = 0u; corner < 3u; ++corner)
+            {
+                const Point3F toNext = m_vertices[corners[(corner + 1u) % 3u]] - m_vertices[corners[corner]];
+                const Point3F toPrevious = m_vertices[corners[(corner + 2u) % 3u]] - m_vertices[corners[corner]];
+                const FLOAT lengths = toNext.calcNorm() * toPrevious.calcNorm();
+
+                if (lengths > 0.0)
+                {
+                    const FLOAT angle = std::acos(std::max(-1.0, std::min(1.0, dot(toNext, toPrevious) / lengths)));
+                    m_vertexNormals[corners[corner]] += m_faceNormals[triangle] * angle;
+                }
+
+                const size_t from = corners[corner];
+                const size_t to = corners[(corner + 1u) % 3u];
+                edgeSums[std::make_pair(std::min(from, to), std::max(from, to))] += m_faceNormals[triangle];
+            }
+        }
+
+        for (size_t triangle = 0u; triangle < m_triangles.size(); ++triangle)
+            for (size_t edge = 0u; edge < 3u; ++edge)
+            {
+                const size_t from = m_triangles[triangle][edge];
+                const size_t to = m_triangles[triangle][(edge + 1u) % 3u];
+                m_edgeNormals[triangle][edge] = edgeSums[std::make_pair(std::min(from, to), std::max(from, to))];
+            }
+    }
+
+    void buildBuckets(const Cuboid& bounds)
+    {
+        const FLOAT longestSide = std::max(bounds.width, std::max(bounds.length, bounds.height));
+        m_bucketSize = std::max(m_maxDistance, longestSide / MaxBucketsPerAxis);
+
+        // One empty layer of buckets around the mesh starts the flood fill
+        const FLOAT margin = m_maxDistance + m_bucketSize;
+        m_origin = bounds.startingPoint - Point3F(margin, margin, margin);
+
+        const FLOAT extents[3] = {bounds.width, bounds.length, bounds.height};
+        for (size_t axis = 0u; axis < 3u; ++axis)
+            m_buckets[axis] = static_cast<size_t>(std::ceil((extents[axis] + 2.0 * margin) / m_bucketSize));
+
+        m_bucketTriangles.assign(m_buckets[0] * m_buckets[1] * m_buckets[2], SizetVector());
+        m_triangleMin.resize(m_triangles.size());
+        m_triangleMax.resize(m_triangles.size());
+
+        for (size_t triangle = 0u; triangle < m_triangles.size(); ++triangle)
+        {
+            // Degenerate triangles have no normal and are covered by their neighbours
+            if (m_faceNormals[triangle].calcNormSqr() == 0.0)
+                continue;
+
+            size_t first[3];
+            size_t last[3];
+
+            const Point3F& a = m_vertices[m_triangles[triangle][0]];
+            const Point3F& b = m_vertices[m_triangles[triangle][1]];
+            const Point3F& c = m_vertices[m_triangles[triangle][2]];
+
+            m_triangleMin[triangle] = Point3F(std::min(a.x, std::min(b.x, c.x)), std::min(a.y, std::min(b.y, c.y)),
+                                              std::min(a.z, std::min(b.z, c.z)));
+            m_triangleMax[triangle] = Point3F(std::max(a.x, std::max(b.x, c.x)), std::max(a.y, std::max(b.y, c.y)),
+                                              std::max(a.z, std::max(b.z, c.z)));
+
+            for (size_t axis = 0u; axis < 3u; ++axis)
+            {
+                const FLOAT min = getAxis(m_triangleMin[triangle], axis);
+                const FLOAT max = getAxis(m_triangleMax[triangle], axis);
+
+                first[axis] = static_cast<size_t>((min - getAxis(m_origin, axis)) / m_bucketSize);
+                last[axis] = std::min(m_buckets[axis] - 1u,
+                                      static_cast<size_t>((max - getAxis(m_origin, axis)) / m_bucketSize));
+            }
+
+            for (size_t k = first[2]; k <= last[2]; ++k)
+                for (size_t j = first[1]; j <= last[1]; ++j)
+                    for (size_t i = first[0]; i <= last[0]; ++i)
+                        m_bucketTriangles[getBucketIndex(i, j, k)].push_back(triangle);
+        }
+
+        floodFill();
+    }
+
+    void floodFill()
+    {
+        // Empty buckets reachable from the border through empty buckets are outside
+        std::vector<bool> isOutside(m_bucketTriangles.size(), false);
+        SizetVector queue;
+
+        const auto visit = [this, &isOutside, &queue](size_t i, size_t j, size_t k) {
+            const size_t index = getBucketIndex(i, j, k);
+            if (!isOutside[index] && m_bucketTriangles[index].empty())
+            {
+                isOutside[index] = true;
+                queue.push_back(index);
+            }
+        };
+
+        visit(0u, 0u, 0u);
+
+        for (size_t next = 0u; next < queue.size(); ++next)
+        {
+            const size_t index = queue[next];
+            const size_t i = index % m_buckets[0];
+            const size_t j = index / m_buckets[0] % m_buckets[1];
+            const size_t k = index / (m_buckets[0] * m_buckets[1]);
+
+            if (i > 0u)
+                visit(i - 1u, j, k);
+            if (i + 1u < m_buckets[0])
+                visit(i + 1u, j, k);
+            if (j > 0u)
+                visit(i, j - 1u, k);
+            if (j + 1u < m_buckets[1])
+                visit(i, j + 1u, k);
+            if (k > 0u)
+                visit(i, j, k - 1u);
+            if (k + 1u < m_buckets[2])
+                visit(i, j, k + 1u);
+        }
+
+        m_isInsideBucket.resize(isOutside.size());
+        for (size_t index = 0u; index < isOutside.size(); ++index)
+            m_isInsideBucket[index] = !isOutside[index] && m_bucketTriangles[index].empty();
+    }
+
+    // Van Oosterom and Strackee solid angles, only for points near buckets with triangles but far from them
+    bool isInsideByWindingNumber(const Point3F& point) const
+    {
+        FLOAT solidAngle = 0.0;
+
+        for (const TriangleMesh::Triangle& corners : m_triangles)
+        {
+            const Point3F a = m_vertices[corners[0]] - point;
+            const Point3F b = m_vertices[corners[1]] - point;
+            const Point3F c = m_vertices[corners[2]] - point;
+
+            const FLOAT lengthA = a.calcNorm();
+            const FLOAT lengthB = b.calcNorm();
+            const FLOAT lengthC = c.calcNorm();
+
+            const FLOAT numerator = dot(a, cross(b, c));
+            const FLOAT denominator =
+                lengthA * lengthB * lengthC + dot(a, b) * lengthC + dot(a, c) * lengthB + dot(b, c) * lengthA;
+
+            solidAngle += 2.0 * std::atan2(numerator, denominator);
+        }
+
+        return std::fabs(solidAngle) > 2.0 * Pi;
+    }
+
+private:
+    Point3FVector m_vertices;
+    std::vector<TriangleMesh::Triangle> m_triangles;
+
+    Point3FVector m_faceNormals;
+    std::vector<std::array<Point3F, 3>> m_edgeNormals;
+    Point3FVector m_vertexNormals;
+
+    FLOAT m_maxDistance;
+
+    Point3F m_origin;
+    FLOAT m_bucketSize;
+    size_t m_buckets[3];
+
+    VectorOfSizetVectors m_bucketTriangles;
+    Point3FVector m_triangleMin;
+    Point3FVector m_triangleMax;
+    std::vector<bool> m_isInsideBucket;
+};
+
+// FNV-1a over the bytes of the value
+template <class T> void hashValue(uint64_t& hash, const T& value)
+{
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&value);
+    for (size_t i = 0u; i < sizeof(value); ++i)
+    {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+}
+
+uint64_t hashMesh(const TriangleMesh& mesh, FLOAT cellSize, FLOAT bandWidth)
+{
+    uint64_t hash = 14695981039346656037ull;
+
+    hashValue(hash, cellSize);
+    hashValue(hash, bandWidth);
+    hashValue(hash, static_cast<uint64_t>(mesh.vertices.size()));
+    hashValue(hash, static_cast<uint64_t>(mesh.triangles.size()));
+
+    for (const Point3F& vertex : mesh.vertices)
+    {
+        hashValue(hash, vertex.x);
+        hashValue(hash, vertex.y);
+        hashValue(hash, vertex.z);
+    }
+
+    for (const TriangleMesh::Triangle& triangle : mesh.triangles)
+        for (const size_t corner : triangle)
+            hashValue(hash, static_cast<uint64_t>(corner));
+
+    return hash;
+}
+} // namespace
+
+SignedDistanceField MeshBoundary::bake(const TriangleMesh& mesh, FLOAT cellSize, FLOAT bandWidth, ThreadPool* pool)
+{
+    const Cuboid bounds = mesh.getBoundingCuboid();
+    const Cuboid fieldBounds(bounds.startingPoint - Point3F(bandWidth, bandWidth, bandWidth),
+                             bounds.width + 2.0 * bandWidth, bounds.length + 2.0 * bandWidth,
+                             bounds.height + 2.0 * bandWidth);
+
+    // Central differences at the border of the band look one cell farther
+    const FLOAT maxDistance = std::max(bandWidth, 2.0 * cellSize) + 2.0 * cellSize;
+
+    return SignedDistanceField(makeDistanceFunction(mesh, maxDistance), fieldBounds, cellSize, bandWidth, pool);
+}
+
+SignedDistanceField MeshBoundary::bake(
+    const TriangleMesh& mesh, FLOAT cellSize, FLOAT bandWidth, const std::string& cacheFile, ThreadPool* pool)
+{
+    const uint64_t key = hashMesh(mesh, cellSize, bandWidth);
+
+    std::ifstream cache(cacheFile, std::ios::binary);
+    if (cache)
+    {
+        uint64_t cachedKey = 0u;
+        if (cache.read(reinterpret_cast<char*>(&cachedKey), sizeof(cachedKey)) && cachedKey == key)
+        {
+            try
+            {
+                return SignedDistanceField::load(cache);
+            }
+            catch (const std::runtime_error&)
+            {
+                // A damaged cache is baked again
+            }
+        }
+    }
+
+    SignedDistanceField field = bake(mesh, cellSize, bandWidth, pool);
+
+    std::ofstream output(cacheFile, std::ios::binary | std::ios::trunc);
+    if (output)
+    {
+        output.write(reinterpret_cast<const char*>(&key), sizeof(key));
+        field.save(output);
+    }
+
+    return field;
+}
+
+SignedDistanceField::Function MeshBoundary::makeDistanceFunction(const TriangleMesh& mesh, FLOAT maxDistance)
+{
+    const std::shared_ptr<const MeshDistance> distance = std::make_shared<const MeshDistance>(mesh, maxDistance);
+
+    return [distance](FLOAT x, FLOAT y, FLOAT z) { return (*distance)(x, y, z); };
+}
+
+} // namespace SPHSDK
@@ -0,0 +1,60 @@
+/**
+ * @file MeshBoundary.h
+ * @author Anton Artyukh (artyukhanton@gmail.com)
+ * @date Created Oct 19, 2026
+ **/
+
+#ifndef MESH_BOUNDARY_H_FE09566896F64837AF15E0B23C71A0BB
+#define MESH_BOUNDARY_H_FE09566896F64837AF15E0B23C71A0BB
+
+#include "SignedDistanceField.h"
+#include "TriangleMesh.h"
+
+#include <string>
+
+namespace SPHSDK
+{
+
+class ThreadPool;
+
+/**
+ * @brief MeshBoundary class turns closed triangle meshes into signed distance fields,
+ * so real geometry collides in the same way as R-function shapes.
+ *
+ * The sign comes from the angle-weighted pseudonormal of the closest feature of the mesh,
+ * so triangles must be oriented consistently with normals pointing outwards.
+ */
+class MeshBoundary
+{
+public:
+    /**
+     * @brief Bakes the field of the mesh covering its bounding box with the band width around.
+     * @param mesh         The closed mesh
+     * @param cellSize     The side of one voxel
+     * @param bandWidth    The distance from the surface kept in the field
+     * @param pool         The pool baking bricks in parallel, may be nullptr
+     */
+    static SignedDistanceField bake(const TriangleMesh& mesh, FLOAT cellSize, FLOAT bandWidth, ThreadPool* pool = nullptr);
+
+    /**
+     * @brief Same as above, but reads the field from cacheFile if it was baked there from the same mesh
+     * and parameters, otherwise bakes it and writes to cacheFile.
+     * The cache is silently skipped if the file can not be written.
+     */
+    static SignedDistanceField bake(const TriangleMesh& mesh,
+                                    FLOAT               cellSize,
+                                    FLOAT               bandWidth,
+                                    const std::string&  cacheFile,
+                                    ThreadPool*         pool = nullptr);
+
+    /**
+     * @brief Returns signed distance to the mesh, > 0 inside like R-functions.
+     * Distances are exact up to maxDistance, farther points get +-maxDistance.
+     * The function keeps its own acceleration grid and may be called concurrently.
+     */
+    static SignedDistanceField::Function makeDistanceFunction(const TriangleMesh& mesh, FLOAT maxDistance);
+};
+
+} // namespace SPHSDK
+
+#endif // MESH_BOUNDARY_H_FE09566896F64837AF15E0B23C71A0BB
@@ -81,6 +81,36 @@ public:
 
     void search(T& points);
 
+    /**
+    * @brief Puts every point into its box, the first phase of search().
+    * Must be called before searchInBox() every time the points move.
+    */
+    void insertPoints(const T& points);
+
+    /**
+    * @brief Finds neighbours of the points which lie in the given box, the second phase of search().
+    * Along periodic axes of the volume distances are minimum images and boxes at opposite sides are neighbours.
+    * Only neighbour lists of the box points are written, so different boxes
+    * can be searched concurrently.
+    */
+    void searchInBox(T& points, const size_t boxIndex);
+
+    /**
+    * @brief Same as searchInBox(), additionally collects neighbours closer than shortRadius
+    * into shortNeighbours[pointIndex], e.g. candidates for collisions of particles.
+    * shortNeighbours must have an element for every point.
+    */
+    void searchInBox(T& points, const size_t boxIndex, FLOAT shortRadius, VectorOfSizetVectors& shortNeighbours);
+
+    size_t getBoxesNumber() const;
+
+    const SizetVector& getPointsInBox(const size_t boxIndex) const;
+
+    /**
+    * @brief Returns the number of boxes along width, length and height.
+    */
+    SizetVector getBoxesGridSize() const;
+
     enum BoxType { outerCorner, outerLongitual, outerCenter,
                    innerCorner, innerLongitual, innerCenter };
 
@@ -88,8 +118,20 @@ private:
 
     void insertPointsIntoBoxes(const T& points);
 
+    void searchInBox(T& points, const size_t boxIndex, FLOAT shortRadius, VectorOfSizetVectors* shortNeighbours);
+
     void findNearbyBoxes();
 
+    /**
+    * @brief Adds boxes across the sides of periodic axes, they are neighbours through the wrap-around.
+    */
+    void addPeriodicNearbyBoxes(const SizetVector& components, const size_t boxIndex);
+
+    /**
+    * @brief Returns box of the point wrapped into the volume along periodic axes.
+    */
+    size_t getPeriodicBoxIndex(const Point3F& position) const;
+
     SizetVector getComponentsOfBoxIndex(const size_t boxIndex);
 
     BoxType getBoxType(const SizetVector& components);
@@ -151,6 +193,8 @@ private:
     size_t m_normalizedCuboidWidth;
     size_t m_normalizedCuboidLength;
     size_t m_normalizedCuboidHeight;
+
+    bool m_hasPeriodicAxes;
 };
 } // namespace SPHSDK
 
@@ -9,6 +9,7 @@
 
 #include "NeighboursSearch.h"
 
+#include <algorithm>
 #include <cfloat>
 #include <cmath>
 
@@ -228,6 +229,8 @@ NeighboursSearch3D<T>::NeighboursSearch3D(const Volume& volume, FLOAT radius, FL
         m_boxes.resize(m_boxesNumber);
         m_nearbyBoxes.resize(m_boxesNumber);
 
+        m_hasPeriodicAxes = m_volume.hasPeriodicAxes();
+
         findNearbyBoxes();
     }
 
@@ -235,42 +238,115 @@ template <class T> NeighboursSearch3D<T>::~NeighboursSearch3D() = default;
 
 /**
  * @brief The main method of search.
- * 1. Clear all neighbours;
- * 2. Put every point in box;
- * 3. Look for neighbour points for every point in every box;
- * 4. Look for neighbour points for every point in neighbour boxes;
+ * 1. Put every point in box;
+ * 2. Look for neighbour points for every point in every box (see searchInBox).
  */
 template <class T> void NeighboursSearch3D<T>::search(T& points)
 {
     // 1
-    for (size_t i = 0; i < points.size(); i++)
-        points[i].neighbours.clear();
-    // 2
     insertPointsIntoBoxes(points);
-    // 3
+    // 2
     for (size_t boxIndex = 0; boxIndex < m_boxes.size(); boxIndex++)
-        for (size_t pointIndex = 0; pointIndex < m_boxes[boxIndex].size(); pointIndex++)
-            for (size_t nearbyPointIndex = 0; nearbyPointIndex < m_boxes[boxIndex].size(); nearbyPointIndex++)
-                if (pointIndex != nearbyPointIndex)
+        searchInBox(points, boxIndex);
+}
+
+template <class T> void NeighboursSearch3D<T>::insertPoints(const T& points)
+{
+    insertPointsIntoBoxes(points);
+}
+
+template <class T> void NeighboursSearch3D<T>::searchInBox(T& points, const size_t boxIndex)
+{
+    searchInBox(points, boxIndex, 0.0, nullptr);
+}
+
+template <class T>
+void NeighboursSearch3D<T>::searchInBox(T& points,
+                                        const size_t boxIndex,
+                                        FLOAT shortRadius,
+                                        VectorOfSizetVectors& shortNeighbours)
+{
+    searchInBox(points, boxIndex, shortRadius, &shortNeighbours);
+}
+
+/**
+ * @brief Search for the points of one box.
+ * 1. Clear neighbours of the box points;
+ * 2. Look for neighbour points for every point in the same box;
+ * 3. Look for neighbour points for every point in neighbour boxes;
+ * Neighbours closer than shortRadius are also put into shortNeighbours if it is given.
+ */
+template <class T>
+void NeighboursSearch3D<T>::searchInBox(T& points,
+                                        const size_t boxIndex,
+                                        FLOAT shortRadius,
+                                        VectorOfSizetVectors* shortNeighbours)
+{
+    const SizetVector& box = m_boxes[boxIndex];
+    const FLOAT shortRadiusSqr = shortRadius * shortRadius;
+    // 1
+    for (size_t pointIndex = 0; pointIndex < box.size(); pointIndex++)
+    {
+        points[box[pointIndex]].neighbours.clear();
+
+        if (shortNeighbours != nullptr)
+            (*shortNeighbours)[box[pointIndex]].clear();
+    }
+    // 2
+    for (size_t pointIndex = 0; pointIndex < box.size(); pointIndex++)
+        for (size_t nearbyPointIndex = 0; nearbyPointIndex < box.size(); nearbyPointIndex++)
+            if (pointIndex != nearbyPointIndex)
+            {
+                Point3F difference = points[box[pointIndex]].position - points[box[nearbyPointIndex]].position;
+                if (m_hasPeriodicAxes)
+                    difference = m_volume.getMinimumImage(difference);
+
+                const FLOAT distanceSqr = difference.calcNormSqr();
+                if (distanceSqr <= pow(m_radius, 2))
                 {
-                    Point3F difference = points[m_boxes[boxIndex][pointIndex]].position -
-                                         points[m_boxes[boxIndex][nearbyPointIndex]].position;
-                    if (difference.calcNormSqr() <= pow(m_radius, 2))
-                        points[m_boxes[boxIndex][pointIndex]].neighbours.push_back(m_boxes[boxIndex][nearbyPointIndex]);
+                    points[box[pointIndex]].neighbours.push_back(box[nearbyPointIndex]);
+
+                    if (shortNeighbours != nullptr && distanceSqr < shortRadiusSqr)
+                        (*shortNeighbours)[box[pointIndex]].push_back(box[nearbyPointIndex]);
                 }
-    // 4
-    for (size_t boxIndex = 0; boxIndex < m_boxes.size(); boxIndex++)
-        for (size_t pointIndex = 0; pointIndex < m_boxes[boxIndex].size(); pointIndex++)
-            for (size_t nearbyBoxIndex = 0; nearbyBoxIndex < m_nearbyBoxes[boxIndex].size(); nearbyBoxIndex++)
-                for (size_t nearbyPointIndex = 0; nearbyPointIndex < m_boxes[m_nearbyBoxes[boxIndex][nearbyBoxIndex]].size(); nearbyPointIndex++)
+            }
+    // 3
+    for (size_t pointIndex = 0; pointIndex < box.size(); pointIndex++)
+        for (size_t nearbyBoxIndex = 0; nearbyBoxIndex < m_nearbyBoxes[boxIndex].size(); nearbyBoxIndex++)
+        {
+            const SizetVector& nearbyBox = m_boxes[m_nearbyBoxes[boxIndex][nearbyBoxIndex]];
+
+            for (size_t nearbyPointIndex = 0; nearbyPointIndex < nearbyBox.size(); nearbyPointIndex++)
+            {
+                Point3F difference = points[box[pointIndex]].position - points[nearbyBox[nearbyPointIndex]].position;
+                if (m_hasPeriodicAxes)
+                    difference = m_volume.getMinimumImage(difference);
+
+                const FLOAT distanceSqr = difference.calcNormSqr();
+                if (distanceSqr - pow(m_radius, 2) <= DBL_EPSILON)
                 {
-                    Point3F difference = points[m_boxes[boxIndex][pointIndex]].position -
-                                         points[m_boxes[m_nearbyBoxes[boxIndex][nearbyBoxIndex]][nearbyPointIndex]].position;
-                    if (difference.calcNormSqr() - pow(m_radius, 2) <= DBL_EPSILON)
-                        points[m_boxes[boxIndex][pointIndex]]
-                            .neighbours
-                            .push_back(m_boxes[m_nearbyBoxes[boxIndex][nearbyBoxIndex]][nearbyPointIndex]);
+                    points[box[pointIndex]].neighbours.push_back(nearbyBox[nearbyPointIndex]);
+
+                    if (shortNeighbours != nullptr && distanceSqr < shortRadiusSqr)
+                        (*shortNeighbours)[box[pointIndex]].push_back(nearbyBox[nearbyPointIndex]);
                 }
+            }
+        }
+}
+
+template <class T> size_t NeighboursSearch3D<T>::getBoxesNumber() const
+{
+    return m_boxesNumber;
+}
+
+template <class T> const SizetVector& NeighboursSearch3D<T>::getPointsInBox(const size_t boxIndex) const
+{
+    return m_boxes[boxIndex];
+}
+
+template <class T> SizetVector NeighboursSearch3D<T>::getBoxesGridSize() const
+{
+    return {m_normalizedCuboidWidth, m_normalizedCuboidLength, m_normalizedCuboidHeight};
 }
 
 /**
@@ -297,6 +373,12 @@ template <class T> void NeighboursSearch3D<T>::insertPointsIntoBoxes(const T& po
 
     for (size_t i = 0; i < m_pointsSize; i++)
     {
+        if (m_hasPeriodicAxes)
+        {
+            m_boxes[getPeriodicBoxIndex(points[i].position)].push_back(i);
+            continue;
+        }
+
         // The Formula is created manually using height layers approach
 
         auto widthOffset = static_cast<size_t>(points[i].position.x / m_radius);
@@ -350,9 +432,87 @@ template <class T> void NeighboursSearch3D<T>::findNearbyBoxes()
         const SizetVector boxComponents = getComponentsOfBoxIndex(boxIndex);
         BoxType boxType = getBoxType(boxComponents);
         defineNearbyBoxes(boxType, boxComponents, boxIndex);
+
+        if (m_hasPeriodicAxes)
+            addPeriodicNearbyBoxes(boxComponents, boxIndex);
     }
 }
 
+/**
+ * @brief Every box has 26 neighbours in the infinite grid, those which lie across a periodic side
+ * are taken from the opposite side of the grid. With less than three boxes along a periodic axis
+ * the same box is reached from both sides, so it is added once.
+ */
+
+template <class T> void NeighboursSearch3D<T>::addPeriodicNearbyBoxes(const SizetVector& components,
+                                                                      const size_t boxIndex)
+{
+    const size_t sizes[3] = {m_normalizedCuboidWidth, m_normalizedCuboidLength, m_normalizedCuboidHeight};
+    SizetVector& nearbyBoxes = m_nearbyBoxes[boxIndex];
+
+    for (int heightShift = -1; heightShift <= 1; heightShift++)
+        for (int lengthShift = -1; lengthShift <= 1; lengthShift++)
+            for (int widthShift = -1; widthShift <= 1; widthShift++)
+            {
+                const int shifts[3] = {widthShift, lengthShift, heightShift};
+
+                size_t nearbyComponents[3];
+                bool isWrapped = false;
+                bool isOutside = false;
+
+                for (size_t axis = 0; axis < 3; axis++)
+                {
+                    const long long shifted = static_cast<long long>(components[axis]) + shifts[axis];
+                    const long long size = static_cast<long long>(sizes[axis]);
+
+                    if (shifted >= 0 && shifted < size)
+                    {
+                        nearbyComponents[axis] = static_cast<size_t>(shifted);
+                        continue;
+                    }
+
+                    if (!m_volume.isPeriodic(axis))
+                    {
+                        isOutside = true;
+                        break;
+                    }
+
+                    nearbyComponents[axis] = static_cast<size_t>((shifted + size) % size);
+                    isWrapped = true;
+                }
+
+                // Neighbours inside the grid are already added by defineNearbyBoxes()
+                if (isOutside || !isWrapped)
+                    continue;
+
+                const size_t nearbyBoxIndex = nearbyComponents[0] +
+                                              nearbyComponents[1] * m_normalizedCuboidWidth +
+                                              nearbyComponents[2] * m_normalizedCuboidWidth * m_normalizedCuboidLength;
+
+                if (nearbyBoxIndex != boxIndex &&
+                    std::find(nearbyBoxes.begin(), nearbyBoxes.end(), nearbyBoxIndex) == nearbyBoxes.end())
+                    nearbyBoxes.push_back(nearbyBoxIndex);
+            }
+}
+
+/**
+ * @brief Boxes of periodic axes cover the whole side, the last box takes the rest of it.
+ */
+
+template <class T> size_t NeighboursSearch3D<T>::getPeriodicBoxIndex(const Point3F& position) const
+{
+    const Point3F wrapped = m_volume.wrapPosition(position) - m_cuboid.startingPoint;
+
+    const auto component = [this](FLOAT coordinate, size_t size) {
+        const size_t index = static_cast<size_t>(std::max(coordinate, 0.0) / m_radius);
+        return std::min(index, size - 1);
+    };
+
+    return component(wrapped.x, m_normalizedCuboidWidth) +
+           component(wrapped.y, m_normalizedCuboidLength) * m_normalizedCuboidWidth +
+           component(wrapped.z, m_normalizedCuboidHeight) * m_normalizedCuboidWidth * m_normalizedCuboidLength;
+}
+
 /**
  * @brief This method returns array of components (width, length and height) for box index.
  */
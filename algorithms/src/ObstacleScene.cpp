@@ -0,0 +1,119 @@
+/**
+ * @file ObstacleScene.cpp
+ * @author Anton Artyukh (artyukhanton@gmail.com)
+ * @date Created Oct 19, 2026
+ **/
+
+#include "ObstacleScene.h"
+
+#include "MeshBoundary.h"
+#include "ROperations.h"
+
+#include <limits>
+#include <utility>
+
+namespace SPHSDK
+{
+
+size_t ObstacleScene::addShape(const SignedDistanceField::Function& function,
+                               const Cuboid&                        bounds,
+                               FLOAT                                cellSize,
+                               FLOAT                                bandWidth,
+                               ThreadPool*                          pool)
+{
+    const Point3F margin(bandWidth, bandWidth, bandWidth);
+    const Cuboid fieldBounds(bounds.startingPoint - margin, bounds.width + 2.0 * bandWidth,
+                             bounds.length + 2.0 * bandWidth, bounds.height + 2.0 * bandWidth);
+
+    return addField(SignedDistanceField(function, fieldBounds, cellSize, bandWidth, pool));
+}
+
+size_t ObstacleScene::addBox(const Cuboid& box, FLOAT cellSize, FLOAT bandWidth, ThreadPool* pool)
+{
+    const Point3F min = box.startingPoint;
+    const Point3F max = box.startingPoint + Point3F(box.width, box.length, box.height);
+
+    // Conjunction of three slabs, every slab is > 0 between its planes
+    const auto function = [min, max](FLOAT x, FLOAT y, FLOAT z) {
+        return ROperations::conjunction(ROperations::conjunction((x - min.x) * (max.x - x), (y - min.y) * (max.y - y)),
+                                        (z - min.z) * (max.z - z));
+    };
+
+    return addShape(function, box, cellSize, bandWidth, pool);
+}
+
+size_t ObstacleScene::addMesh(
+    const TriangleMesh& mesh, FLOAT cellSize, FLOAT bandWidth, const std::string& cacheFile, ThreadPool* pool)
+{
+    if (cacheFile.empty())
+        return addField(MeshBoundary::bake(mesh, cellSize, bandWidth, pool));
+
+    return addField(MeshBoundary::bake(mesh, cellSize, bandWidth, cacheFile, pool));
+}
+
+size_t ObstacleScene::addField(SignedDistanceField field)
+{
+    m_obstacles.push_back(std::move(field));
+    m_isHierarchyValid.store(false, std::memory_order_release);
+
+    return m_obstacles.size() - 1u;
+}
+
+size_t ObstacleScene::getObstaclesNumber() const
+{
+    return m_obstacles.size();
+}
+
+const SignedDistanceField& ObstacleScene::getObstacle(size_t index) const
+{
+    return m_obstacles[index];
+}
+
+bool ObstacleScene::sample(const Point3F& point, FLOAT& distance, Point3F& gradient) const
+{
+    distance = -std::numeric_limits<FLOAT>::infinity();
+    gradient = Point3F();
+
+    bool isSampled = false;
+
+    updateHierarchy();
+
+    m_hierarchy.forEachContaining(point, [this, &point, &distance, &gradient, &isSampled](size_t obstacle) {
+        FLOAT obstacleDistance = 0.0;
+        Point3F obstacleGradient;
+
+        const bool isObstacleSampled = m_obstacles[obstacle].sample(point, obstacleDistance, obstacleGradient);
+
+        if (obstacleDistance > distance)
+        {
+            distance = obstacleDistance;
+            gradient = obstacleGradient;
+            isSampled = isObstacleSampled;
+        }
+    });
+
+    return isSampled;
+}
+
+void ObstacleScene::updateHierarchy() const
+{
+    if (m_isHierarchyValid.load(std::memory_order_acquire))
+        return;
+
+    std::lock_guard<std::mutex> lock(m_hierarchyMutex);
+
+    // Another query may have rebuilt it while this one waited
+    if (m_isHierarchyValid.load(std::memory_order_relaxed))
+        return;
+
+    std::vector<Cuboid> bounds;
+    bounds.reserve(m_obstacles.size());
+    for (const SignedDistanceField& obstacle : m_obstacles)
+        bounds.push_back(obstacle.getBounds());
+
+    m_hierarchy.build(bounds);
+
+    m_isHierarchyValid.store(true, std::memory_order_release);
+}
+
+} // namespace SPHSDK
@@ -0,0 +1,95 @@
+/**
+ * @file ObstacleScene.h
+ * @author Anton Artyukh (artyukhanton@gmail.com)
+ * @date Created Oct 19, 2026
+ **/
+
+#ifndef OBSTACLE_SCENE_H_CCDE4B9818FA4F93B8BD638D2C317383
+#define OBSTACLE_SCENE_H_CCDE4B9818FA4F93B8BD638D2C317383
+
+#include "Area.h"
+#include "BoundingVolumeHierarchy.h"
+#include "SignedDistanceField.h"
+#include "TriangleMesh.h"
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace SPHSDK
+{
+
+class ThreadPool;
+
+/**
+ * @brief ObstacleScene class keeps a set of obstacles, each one cached in its own SignedDistanceField.
+ * The grids of the fields serve as bounding boxes of a BoundingVolumeHierarchy,
+ * so a query samples only the obstacles whose grids contain the point. The hierarchy is rebuilt once
+ * by the first query after obstacles were added, not by every add.
+ */
+class ObstacleScene
+{
+public:
+    /**
+     * @brief Adds an R-function shape, > 0 inside.
+     * @param bounds       The box the shape fits in, the field covers it with the band width around
+     * @param cellSize     The side of one voxel
+     * @param bandWidth    The distance from the surface kept in the field
+     * @param pool         The pool sampling the field in parallel, may be nullptr
+     * @return index of the obstacle
+     */
+    size_t addShape(const SignedDistanceField::Function& function,
+                    const Cuboid&                        bounds,
+                    FLOAT                                cellSize,
+                    FLOAT                                bandWidth,
+                    ThreadPool*                          pool = nullptr);
+
+    /**
+     * @brief Adds a solid box, the rest like in addShape().
+     */
+    size_t addBox(const Cuboid& box, FLOAT cellSize, FLOAT bandWidth, ThreadPool* pool = nullptr);
+
+    /**
+     * @brief Adds a closed triangle mesh baked by MeshBoundary::bake().
+     * @param cacheFile    The file keeping the baked field between runs, empty means no cache
+     */
+    size_t addMesh(const TriangleMesh& mesh,
+                   FLOAT               cellSize,
+                   FLOAT               bandWidth,
+                   const std::string&  cacheFile = std::string(),
+                   ThreadPool*         pool = nullptr);
+
+    /**
+     * @brief Adds an obstacle sampled beforehand.
+     */
+    size_t addField(SignedDistanceField field);
+
+    size_t getObstaclesNumber() const;
+
+    const SignedDistanceField& getObstacle(size_t index) const;
+
+    /**
+     * @brief Samples the obstacle the point is deepest in among those whose grids contain the point.
+     * @return false if no obstacle has samples around the point,
+     * then distance is the largest of their +-bandWidth, or -infinity if there are none, and gradient is zero
+     */
+    bool sample(const Point3F& point, FLOAT& distance, Point3F& gradient) const;
+
+private:
+    // Rebuilds the hierarchy if obstacles were added since the last query, safe to call from several threads
+    void updateHierarchy() const;
+
+private:
+    std::vector<SignedDistanceField> m_obstacles;
+
+    mutable BoundingVolumeHierarchy m_hierarchy;
+
+    mutable std::atomic<bool> m_isHierarchyValid{true};
+
+    mutable std::mutex m_hierarchyMutex;
+};
+
+} // namespace SPHSDK
+
+#endif // OBSTACLE_SCENE_H_CCDE4B9818FA4F93B8BD638D2C317383
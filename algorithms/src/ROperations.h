@@ -12,6 +12,7 @@ namespace SPHSDK
 
 /**
  * @brief ROperations class defines R-operations.
+ * T is FLOAT or FloatPack, which applies the operation to several values at once.
  */
 class ROperations
 {
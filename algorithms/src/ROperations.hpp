@@ -10,14 +10,18 @@
 namespace SPHSDK
 {
 
+// sqrt of other types, like FloatPack, is found by argument-dependent lookup
+
 template <class T> T ROperations::conjunction(T x, T y)
 {
-    return x + y - std::sqrt(x * x + y * y);
+    using std::sqrt;
+    return x + y - sqrt(x * x + y * y);
 }
 
 template <class T> T ROperations::disjunction(T x, T y)
 {
-    return x + y + std::sqrt(x * x + y * y);
+    using std::sqrt;
+    return x + y + sqrt(x * x + y * y);
 }
 
 } // namespace SPHSDK
@@ -0,0 +1,787 @@
+/**
+ * @file ShapeExpression.cpp
+ * @author Anton Artyukh (artyukhanton@gmail.com)
+ * @date Created Oct 19, 2026
+ **/
+
+#include "ShapeExpression.h"
+
+#include "FloatPack.h"
+#include "ROperations.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <initializer_list>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <tuple>
+
+namespace SPHSDK
+{
+
+namespace
+{
+struct Token
+{
+    enum class Type
+    {
+        Number,
+        Name,
+        Symbol,
+        End
+    };
+
+    Type type;
+    std::string text;
+    FLOAT value;
+    size_t line;
+};
+
+[[noreturn]] void fail(const std::string& message, size_t line)
+{
+    throw std::invalid_argument("Shape expression line " + std::to_string(line) + ": " + message);
+}
+
+std::vector<Token> tokenize(const std::string& text)
+{
+    std::vector<Token> tokens;
+    size_t line = 1u;
+    size_t i = 0u;
+
+    while (i < text.size())
+    {
+        const char symbol = text[i];
+
+        if (symbol == '\n')
+        {
+            ++line;
+            ++i;
+        }
+        else if (std::isspace(static_cast<unsigned char>(symbol)))
+        {
+            ++i;
+        }
+        else if (symbol == '#')
+        {
+            while (i < text.size() && text[i] != '\n')
+                ++i;
+        }
+        else if (std::isdigit(static_cast<unsigned char>(symbol)) || symbol == '.')
+        {
+            const char* begin = text.c_str() + i;
+            char* end = nullptr;
+            const FLOAT value = static_cast<FLOAT>(std::strtod(begin, &end));
+
+            if (end == begin)
+                fail("invalid number", line);
+
+            const size_t length = static_cast<size_t>(end - begin);
+            tokens.push_back({Token::Type::Number, text.substr(i, length), value, line});
+            i += length;
+        }
+        else if (std::isalpha(static_cast<unsigned char>(symbol)) || symbol == '_')
+        {
+            const size_t begin = i;
+            while (i < text.size() && (std::isalnum(static_cast<unsigned char>(text[i])) || text[i] == '_'))
+                ++i;
+
+            tokens.push_back({Token::Type::Name, text.substr(begin, i - begin), 0.0, line});
+        }
+        else if (std::strchr("+-*/(),=;", symbol) != nullptr)
+        {
+            tokens.push_back({Token::Type::Symbol, std::string(1u, symbol), 0.0, line});
+            ++i;
+        }
+        else
+        {
+            fail(std::string("unexpected '") + symbol + "'", line);
+        }
+    }
+
+    tokens.push_back({Token::Type::End, std::string(), 0.0, line});
+    return tokens;
+}
+
+using Interval = ShapeExpression::Interval;
+
+// Bounds of the values, NaN of inf - inf or 0 * inf widens them to the whole line
+Interval makeInterval(std::initializer_list<FLOAT> values)
+{
+    Interval interval = {std::numeric_limits<FLOAT>::infinity(), -std::numeric_limits<FLOAT>::infinity()};
+
+    for (const FLOAT value : values)
+    {
+        if (std::isnan(value))
+            return {-std::numeric_limits<FLOAT>::infinity(), std::numeric_limits<FLOAT>::infinity()};
+
+        interval.lower = std::min(interval.lower, value);
+        interval.upper = std::max(interval.upper, value);
+    }
+
+    return interval;
+}
+
+bool containsZero(const Interval& interval)
+{
+    return interval.lower <= 0.0 && interval.upper >= 0.0;
+}
+
+Interval multiply(const Interval& a, const Interval& b)
+{
+    return makeInterval({a.lower * b.lower, a.lower * b.upper, a.upper * b.lower, a.upper * b.upper});
+}
+
+Interval divide(const Interval& a, const Interval& b)
+{
+    if (containsZero(b))
+        return {-std::numeric_limits<FLOAT>::infinity(), std::numeric_limits<FLOAT>::infinity()};
+
+    return makeInterval({a.lower / b.lower, a.lower / b.upper, a.upper / b.lower, a.upper / b.upper});
+}
+
+Interval square(const Interval& a)
+{
+    const FLOAT lower = a.lower * a.lower;
+    const FLOAT upper = a.upper * a.upper;
+
+    if (containsZero(a))
+        return makeInterval({0.0, std::max(lower, upper)});
+
+    return makeInterval({lower, upper});
+}
+
+Interval squareRoot(const Interval& a)
+{
+    // sqrt of negative values is NaN, the bounds are kept for the rest of the interval
+    return makeInterval({std::sqrt(std::max<FLOAT>(0.0, a.lower)), std::sqrt(std::max<FLOAT>(0.0, a.upper))});
+}
+} // namespace
+
+template <class Visitor> void ShapeExpression::visitOperation(Operation operation, const Visitor& visitor)
+{
+    using std::sqrt;
+
+    switch (operation)
+    {
+    case Operation::Add:
+        visitor([](const auto& a, const auto& b) { return a + b; });
+        break;
+    case Operation::Subtract:
+        visitor([](const auto& a, const auto& b) { return a - b; });
+        break;
+    case Operation::Multiply:
+        visitor([](const auto& a, const auto& b) { return a * b; });
+        break;
+    case Operation::Divide:
+        visitor([](const auto& a, const auto& b) { return a / b; });
+        break;
+    case Operation::Negate:
+        visitor([](const auto& a, const auto&) { return 0.0 - a; });
+        break;
+    case Operation::Square:
+        visitor([](const auto& a, const auto&) { return a * a; });
+        break;
+    case Operation::SquareRoot:
+        visitor([](const auto& a, const auto&) { return sqrt(a); });
+        break;
+    case Operation::Conjunction:
+        visitor([](const auto& a, const auto& b) { return ROperations::conjunction(a, b); });
+        break;
+    case Operation::Disjunction:
+        visitor([](const auto& a, const auto& b) { return ROperations::disjunction(a, b); });
+        break;
+    default:
+        break;
+    }
+}
+
+/**
+ * @brief Compiler class appends the nodes of the expression, equal ones are emitted once and the ones
+ * of constants are folded, then assigns registers to the nodes the shape depends on.
+ */
+class ShapeExpression::Compiler
+{
+public:
+    uint32_t emitConstant(FLOAT value)
+    {
+        return append({Operation::Constant, 0u, 0u, value});
+    }
+
+    uint32_t emitVariable(Operation variable)
+    {
+        return append({variable, 0u, 0u, 0.0});
+    }
+
+    uint32_t emit(Operation operation, uint32_t first, uint32_t second)
+    {
+        // The R-operations are symmetric in floating point as well
+        const bool isCommutative = operation == Operation::Add || operation == Operation::Multiply ||
+                                   operation == Operation::Conjunction || operation == Operation::Disjunction;
+
+        if (isCommutative && second < first)
+            std::swap(first, second);
+
+        if (m_nodes[first].operation == Operation::Constant && m_nodes[second].operation == Operation::Constant)
+        {
+            FLOAT value = 0.0;
+            visitOperation(operation, [this, first, second, &value](const auto& apply) {
+                value = apply(m_nodes[first].constant, m_nodes[second].constant);
+            });
+
+            return emitConstant(value);
+        }
+
+        return append({operation, first, second, 0.0});
+    }
+
+    uint32_t emit(Operation operation, uint32_t argument)
+    {
+        return emit(operation, argument, argument);
+    }
+
+    /**
+     * @brief Returns the program of the result without the nodes it does not depend on.
+     */
+    ShapeExpression finish(uint32_t result) const
+    {
+        std::vector<bool> isUsed(m_nodes.size(), false);
+        isUsed[result] = true;
+
+        // The node reading the value for the last time
+        std::vector<uint32_t> lastUses(m_nodes.size(), 0u);
+
+        for (uint32_t i = result + 1u; i-- > 0u;)
+            if (isUsed[i] && isArithmetic(m_nodes[i].operation))
+                for (const uint32_t argument : {m_nodes[i].first, m_nodes[i].second})
+                {
+                    isUsed[argument] = true;
+                    lastUses[argument] = std::max(lastUses[argument], i);
+                }
+
+        ShapeExpression expression;
+        std::vector<uint32_t> registers(m_nodes.size(), 0u);
+
+        for (uint32_t i = 0u; i <= result; ++i)
+        {
+            if (!isUsed[i] || isArithmetic(m_nodes[i].operation))
+                continue;
+
+            if (m_nodes[i].operation == Operation::Constant)
+            {
+                registers[i] = ConstantsStart + static_cast<uint32_t>(expression.m_constants.size());
+                expression.m_constants.push_back(m_nodes[i].constant);
+            }
+            else
+            {
+                const Operation variable = m_nodes[i].operation;
+                registers[i] = variable == Operation::X ? 0u : (variable == Operation::Y ? 1u : 2u);
+            }
+        }
+
+        // Linear scan, a register read for the last time may keep the result of the same instruction,
+        // operations are lane-wise, so every lane is read before it is written
+        expression.m_registersNumber = ConstantsStart + expression.m_constants.size();
+        std::vector<uint32_t> freeRegisters;
+
+        for (uint32_t i = 0u; i <= result; ++i)
+        {
+            const Node& node = m_nodes[i];
+            if (!isUsed[i] || !isArithmetic(node.operation))
+                continue;
+
+            for (const uint32_t argument : {node.first, node.second})
+                if (isArithmetic(m_nodes[argument].operation) && lastUses[argument] == i &&
+                    std::find(freeRegisters.begin(), freeRegisters.end(), registers[argument]) == freeRegisters.end())
+                    freeRegisters.push_back(registers[argument]);
+
+            if (freeRegisters.empty())
+            {
+                registers[i] = static_cast<uint32_t>(expression.m_registersNumber++);
+            }
+            else
+            {
+                registers[i] = freeRegisters.back();
+                freeRegisters.pop_back();
+            }
+
+            expression.m_instructions.push_back(
+                {node.operation, registers[i], registers[node.first], registers[node.second]});
+        }
+
+        expression.m_result = registers[result];
+
+        return expression;
+    }
+
+private:
+    struct Node
+    {
+        Operation operation;
+        uint32_t first;
+        uint32_t second;
+        FLOAT constant;
+    };
+
+    static bool isArithmetic(Operation operation)
+    {
+        return operation != Operation::Constant && operation != Operation::X && operation != Operation::Y &&
+               operation != Operation::Z;
+    }
+
+    uint32_t append(const Node& node)
+    {
+        // Constants are told apart by their bits, so 0 and -0 stay different
+        uint64_t constantBits = 0u;
+        std::memcpy(&constantBits, &node.constant, sizeof(node.constant));
+
+        const auto key = std::make_tuple(node.operation, node.first, node.second, constantBits);
+        const auto found = m_indices.find(key);
+
+        if (found != m_indices.end())
+            return found->second;
+
+        const uint32_t index = static_cast<uint32_t>(m_nodes.size());
+        m_nodes.push_back(node);
+        m_indices.emplace(key, index);
+
+        return index;
+    }
+
+private:
+    std::vector<Node> m_nodes;
+
+    std::map<std::tuple<Operation, uint32_t, uint32_t, uint64_t>, uint32_t> m_indices;
+};
+
+/**
+ * @brief Parser class compiles the description by recursive descent, see ShapeExpression.
+ */
+class ShapeExpression::Parser
+{
+public:
+    explicit Parser(const std::string& text)
+        : m_tokens(tokenize(text))
+    {
+    }
+
+    ShapeExpression parse()
+    {
+        while (peek().type == Token::Type::Name && isSymbol(peek(1u), '='))
+        {
+            const Token& name = next();
+            if (name.text == "x" || name.text == "y" || name.text == "z")
+                fail(name.text + " can not be redefined", name.line);
+
+            next();
+            const uint32_t value = parseSum();
+            expect(';');
+
+            m_names[name.text] = value;
+        }
+
+        if (peek().type == Token::Type::End)
+            fail("the shape is missing", peek().line);
+
+        const uint32_t result = parseSum();
+
+        if (isSymbol(peek(), ';'))
+            next();
+
+        if (peek().type != Token::Type::End)
+            fail("unexpected '" + peek().text + "'", peek().line);
+
+        return m_compiler.finish(result);
+    }
+
+private:
+    uint32_t parseSum()
+    {
+        uint32_t result = parseProduct();
+
+        while (isSymbol(peek(), '+') || isSymbol(peek(), '-'))
+        {
+            const Operation operation = next().text == "+" ? Operation::Add : Operation::Subtract;
+            result = m_compiler.emit(operation, result, parseProduct());
+        }
+
+        return result;
+    }
+
+    uint32_t parseProduct()
+    {
+        uint32_t result = parseUnary();
+
+        while (isSymbol(peek(), '*') || isSymbol(peek(), '/'))
+        {
+            const Operation operation = next().text == "*" ? Operation::Multiply : Operation::Divide;
+            result = m_compiler.emit(operation, result, parseUnary());
+        }
+
+        return result;
+    }
+
+    uint32_t parseUnary()
+    {
+        if (!isSymbol(peek(), '-'))
+            return parsePrimary();
+
+        next();
+        return m_compiler.emit(Operation::Negate, parseUnary());
+    }
+
+    uint32_t parsePrimary()
+    {
+        const Token& token = next();
+
+        if (token.type == Token::Type::Number)
+            return m_compiler.emitConstant(token.value);
+
+        if (isSymbol(token, '('))
+        {
+            const uint32_t result = parseSum();
+            expect(')');
+            return result;
+        }
+
+        if (token.type != Token::Type::Name)
+            fail(token.type == Token::Type::End ? "unexpected end" : "unexpected '" + token.text + "'", token.line);
+
+        if (isSymbol(peek(), '('))
+            return parseCall(token);
+
+        if (token.text == "x")
+            return m_compiler.emitVariable(Operation::X);
+        if (token.text == "y")
+            return m_compiler.emitVariable(Operation::Y);
+        if (token.text == "z")
+            return m_compiler.emitVariable(Operation::Z);
+
+        const auto found = m_names.find(token.text);
+        if (found == m_names.end())
+            fail("unknown name '" + token.text + "'", token.line);
+
+        return found->second;
+    }
+
+    uint32_t parseCall(const Token& function)
+    {
+        next();
+
+        std::vector<uint32_t> arguments;
+        if (!isSymbol(peek(), ')'))
+        {
+            arguments.push_back(parseSum());
+            while (isSymbol(peek(), ','))
+            {
+                next();
+                arguments.push_back(parseSum());
+            }
+        }
+        expect(')');
+
+        const auto checkArguments = [&function, &arguments](size_t number) {
+            if (arguments.size() != number)
+                fail(function.text + " takes " + std::to_string(number) + " arguments", function.line);
+        };
+
+        const std::string& name = function.text;
+
+        if (name == "sqr" || name == "sqrt" || name == "not")
+        {
+            checkArguments(1u);
+
+            // Negation of the R-function is the negated function
+            const Operation operation =
+                name == "sqr" ? Operation::Square : (name == "sqrt" ? Operation::SquareRoot : Operation::Negate);
+            return m_compiler.emit(operation, arguments[0]);
+        }
+
+        if (name == "and" || name == "or")
+        {
+            if (arguments.size() < 2u)
+                fail(name + " takes at least 2 arguments", function.line);
+
+            const Operation operation = name == "and" ? Operation::Conjunction : Operation::Disjunction;
+
+            uint32_t result = arguments[0];
+            for (size_t i = 1u; i < arguments.size(); ++i)
+                result = m_compiler.emit(operation, result, arguments[i]);
+
+            return result;
+        }
+
+        const uint32_t variables[3] = {m_compiler.emitVariable(Operation::X), m_compiler.emitVariable(Operation::Y),
+                                       m_compiler.emitVariable(Operation::Z)};
+
+        const auto squaredDistance = [this, &variables](size_t axis, uint32_t center) {
+            return m_compiler.emit(Operation::Square, m_compiler.emit(Operation::Subtract, variables[axis], center));
+        };
+
+        // (coordinate - lower) * (upper - coordinate) like in Shapes, > 0 between the planes
+        const auto slab = [this, &variables](size_t axis, uint32_t lower, uint32_t upper) {
+            return m_compiler.emit(Operation::Multiply, m_compiler.emit(Operation::Subtract, variables[axis], lower),
+                                   m_compiler.emit(Operation::Subtract, upper, variables[axis]));
+        };
+
+        if (name == "sphere")
+        {
+            checkArguments(4u);
+
+            const uint32_t distance =
+                m_compiler.emit(Operation::Add,
+                                m_compiler.emit(Operation::Add, squaredDistance(0u, arguments[0]),
+                                                squaredDistance(1u, arguments[1])),
+                                squaredDistance(2u, arguments[2]));
+
+            return m_compiler.emit(Operation::Subtract, m_compiler.emit(Operation::Square, arguments[3]), distance);
+        }
+
+        if (name == "box")
+        {
+            checkArguments(6u);
+
+            return m_compiler.emit(
+                Operation::Conjunction,
+                m_compiler.emit(Operation::Conjunction, slab(0u, arguments[0], arguments[3]),
+                                slab(1u, arguments[1], arguments[4])),
+                slab(2u, arguments[2], arguments[5]));
+        }
+
+        if (name == "cylinder")
+        {
+            checkArguments(5u);
+
+            const uint32_t disk = m_compiler.emit(
+                Operation::Subtract,
+                m_compiler.emit(Operation::Subtract, m_compiler.emit(Operation::Square, arguments[2]),
+                                squaredDistance(0u, arguments[0])),
+                squaredDistance(1u, arguments[1]));
+
+            return m_compiler.emit(Operation::Conjunction, disk, slab(2u, arguments[3], arguments[4]));
+        }
+
+        fail("unknown function '" + name + "'", function.line);
+    }
+
+    static bool isSymbol(const Token& token, char symbol)
+    {
+        return token.type == Token::Type::Symbol && token.text[0] == symbol;
+    }
+
+    const Token& peek(size_t offset = 0u) const
+    {
+        return m_tokens[std::min(m_position + offset, m_tokens.size() - 1u)];
+    }
+
+    const Token& next()
+    {
+        const Token& token = peek();
+        m_position = std::min(m_position + 1u, m_tokens.size() - 1u);
+        return token;
+    }
+
+    void expect(char symbol)
+    {
+        if (!isSymbol(peek(), symbol))
+            fail(std::string("expected '") + symbol + "'", peek().line);
+
+        next();
+    }
+
+private:
+    std::vector<Token> m_tokens;
+
+    size_t m_position = 0u;
+
+    Compiler m_compiler;
+
+    std::map<std::string, uint32_t> m_names;
+};
+
+ShapeExpression ShapeExpression::parse(const std::string& text)
+{
+    return Parser(text).parse();
+}
+
+ShapeExpression ShapeExpression::loadFromFile(const std::string& fileName)
+{
+    std::ifstream file(fileName);
+    if (!file)
+        throw std::runtime_error("Can not open shape file " + fileName);
+
+    std::ostringstream text;
+    text << file.rdbuf();
+
+    return parse(text.str());
+}
+
+FLOAT ShapeExpression::operator()(FLOAT x, FLOAT y, FLOAT z) const
+{
+    // Reused by the calls of the thread, the marching cubes call it for every vertex
+    thread_local std::vector<FLOAT> registers;
+    registers.resize(m_registersNumber);
+
+    registers[0] = x;
+    registers[1] = y;
+    registers[2] = z;
+    std::copy(m_constants.begin(), m_constants.end(), registers.begin() + ConstantsStart);
+
+    for (const Instruction& instruction : m_instructions)
+        visitOperation(instruction.operation, [&instruction](const auto& apply) {
+            registers[instruction.result] = apply(registers[instruction.first], registers[instruction.second]);
+        });
+
+    return registers[m_result];
+}
+
+void ShapeExpression::operator()(const FLOAT* xs, const FLOAT* ys, const FLOAT* zs, FLOAT* out, size_t n) const
+{
+    if (n == 0u)
+        return;
+
+    // Only a constant shape has no instructions and reads a register of constants
+    if (m_instructions.empty() && m_result >= ConstantsStart)
+    {
+        std::fill_n(out, n, m_constants[m_result - ConstantsStart]);
+        return;
+    }
+
+    // Registers of constants are not used, instructions broadcast them
+    thread_local std::vector<FLOAT> registers;
+    registers.resize(m_registersNumber * ChunkSize);
+
+    const FLOAT* coordinates[3] = {xs, ys, zs};
+    const FLOAT* result = registers.data() + m_result * ChunkSize;
+
+    for (size_t begin = 0u; begin < n; begin += ChunkSize)
+    {
+        const size_t count = std::min(ChunkSize, n - begin);
+        const size_t lanesNumber = (count + FloatPack::Size - 1u) / FloatPack::Size * FloatPack::Size;
+
+        // The last pack is filled up with the last point
+        for (size_t axis = 0u; axis < 3u; ++axis)
+        {
+            FLOAT* chunk = registers.data() + axis * ChunkSize;
+            std::fill(std::copy_n(coordinates[axis] + begin, count, chunk), chunk + lanesNumber,
+                      coordinates[axis][n - 1u]);
+        }
+
+        evaluateChunk(registers.data(), lanesNumber);
+
+        std::copy_n(result, count, out + begin);
+    }
+}
+
+ShapeExpression::Interval ShapeExpression::getBounds(const Point3F& min, const Point3F& max) const
+{
+    std::vector<Interval> registers(m_registersNumber);
+
+    registers[0] = {min.x, max.x};
+    registers[1] = {min.y, max.y};
+    registers[2] = {min.z, max.z};
+
+    for (size_t i = 0u; i < m_constants.size(); ++i)
+        registers[ConstantsStart + i] = {m_constants[i], m_constants[i]};
+
+    for (const Instruction& instruction : m_instructions)
+    {
+        const Interval a = registers[instruction.first];
+        const Interval b = registers[instruction.second];
+        Interval& result = registers[instruction.result];
+
+        switch (instruction.operation)
+        {
+        case Operation::Add:
+            result = makeInterval({a.lower + b.lower, a.upper + b.upper});
+            break;
+        case Operation::Subtract:
+            result = makeInterval({a.lower - b.upper, a.upper - b.lower});
+            break;
+        case Operation::Multiply:
+            result = multiply(a, b);
+            break;
+        case Operation::Divide:
+            result = divide(a, b);
+            break;
+        case Operation::Negate:
+            result = {-a.upper, -a.lower};
+            break;
+        case Operation::Square:
+            result = square(a);
+            break;
+        case Operation::SquareRoot:
+            result = squareRoot(a);
+            break;
+        case Operation::Conjunction:
+            result = makeInterval(
+                {ROperations::conjunction(a.lower, b.lower), ROperations::conjunction(a.upper, b.upper)});
+            break;
+        case Operation::Disjunction:
+            result = makeInterval(
+                {ROperations::disjunction(a.lower, b.lower), ROperations::disjunction(a.upper, b.upper)});
+            break;
+        default:
+            break;
+        }
+    }
+
+    return registers[m_result];
+}
+
+bool ShapeExpression::mayContainSurface(const Point3F& min, const Point3F& max) const
+{
+    return containsZero(getBounds(min, max));
+}
+
+size_t ShapeExpression::getInstructionsNumber() const
+{
+    return m_instructions.size();
+}
+
+void ShapeExpression::evaluateChunk(FLOAT* registers, size_t lanesNumber) const
+{
+    const auto isConstant = [this](uint32_t index) {
+        return index >= ConstantsStart && index < ConstantsStart + m_constants.size();
+    };
+
+    for (const Instruction& instruction : m_instructions)
+    {
+        const FLOAT* first = registers + instruction.first * ChunkSize;
+        const FLOAT* second = registers + instruction.second * ChunkSize;
+        FLOAT* result = registers + instruction.result * ChunkSize;
+
+        // Constants are broadcast rather than loaded, both arguments are never constants after folding
+        const bool isFirstConstant = isConstant(instruction.first);
+        const bool isSecondConstant = isConstant(instruction.second);
+        const FloatPack constant(isFirstConstant ? m_constants[instruction.first - ConstantsStart]
+                                                 : (isSecondConstant ? m_constants[instruction.second - ConstantsStart]
+                                                                     : 0.0));
+
+        // One dispatch for the chunk, the loop is the operation alone
+        visitOperation(instruction.operation, [&](const auto& apply) {
+            if (isFirstConstant)
+            {
+                for (size_t j = 0u; j < lanesNumber; j += FloatPack::Size)
+                    apply(constant, FloatPack::load(second + j)).store(result + j);
+            }
+            else if (isSecondConstant)
+            {
+                for (size_t j = 0u; j < lanesNumber; j += FloatPack::Size)
+                    apply(FloatPack::load(first + j), constant).store(result + j);
+            }
+            else
+            {
+                for (size_t j = 0u; j < lanesNumber; j += FloatPack::Size)
+                    apply(FloatPack::load(first + j), FloatPack::load(second + j)).store(result + j);
+            }
+        });
+    }
+}
+
+} // namespace SPHSDK
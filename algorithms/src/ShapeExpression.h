@@ -0,0 +1,144 @@
+/**
+ * @file ShapeExpression.h
+ * @author Anton Artyukh (artyukhanton@gmail.com)
+ * @date Created Oct 19, 2026
+ **/
+
+#ifndef SHAPE_EXPRESSION_H_E41B7C2D9A0F4D5C8B36F1A27D9E0C84
+#define SHAPE_EXPRESSION_H_E41B7C2D9A0F4D5C8B36F1A27D9E0C84
+
+#include "Defines.h"
+#include "Point.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace SPHSDK
+{
+
+/**
+ * @brief ShapeExpression class is an R-function shape read from text, a value > 0 inside, = 0 on the border
+ * and < 0 outside, like the ones of Shapes. The description is a list of definitions and the shape itself:
+ *
+ *     # Comments run to the end of the line
+ *     r = sqr(x - 1.5) + sqr(y - 1.5);
+ *     or(and(0.25 - r, z * (1 - z)), sphere(1.5, 1.5, 1.2, 0.3))
+ *
+ * with x, y, z, numbers, + - * / and parentheses, sqr(a), sqrt(a), the R-operations and(a, b, ...),
+ * or(a, b, ...) and not(a), and the primitives sphere(cx, cy, cz, r), box(x0, y0, z0, x1, y1, z1)
+ * and cylinder(cx, cy, r, z0, z1) along z.
+ *
+ * The text is compiled once to a flat list of instructions over registers: equal subexpressions are computed
+ * once and constant ones are folded. Points are evaluated in chunks, every instruction runs over the whole
+ * chunk with SIMD (see FloatPack), so the dispatch is paid once per chunk rather than per point.
+ */
+class ShapeExpression
+{
+public:
+    /**
+     * @brief Interval struct keeps the bounds of the shape in a box.
+     */
+    struct Interval
+    {
+        FLOAT lower;
+        FLOAT upper;
+    };
+
+    /**
+     * @brief Compiles the description, throws std::invalid_argument with the line of the error.
+     */
+    static ShapeExpression parse(const std::string& text);
+
+    /**
+     * @brief Compiles the description from the file, throws std::runtime_error if it can not be read.
+     */
+    static ShapeExpression loadFromFile(const std::string& fileName);
+
+    FLOAT operator()(FLOAT x, FLOAT y, FLOAT z) const;
+
+    /**
+     * @brief Evaluates n points, out[i] = (*this)(xs[i], ys[i], zs[i]).
+     * The arguments are the batched field of MarchingCubes::generateMesh().
+     */
+    void operator()(const FLOAT* xs, const FLOAT* ys, const FLOAT* zs, FLOAT* out, size_t n) const;
+
+    /**
+     * @brief Returns the bounds of the shape in the box [min, max] by interval arithmetic.
+     * They may be wider than the exact range but always contain it, the R-operations are monotonic
+     * in both arguments, so they are bounded by their values in the ends of the intervals.
+     */
+    Interval getBounds(const Point3F& min, const Point3F& max) const;
+
+    /**
+     * @brief Returns false if the border of the shape surely misses the box,
+     * the predicate of MarchingCubes::generateCulledMesh().
+     */
+    bool mayContainSurface(const Point3F& min, const Point3F& max) const;
+
+    /**
+     * @brief Returns the number of arithmetic instructions, constants and coordinates are not counted.
+     */
+    size_t getInstructionsNumber() const;
+
+private:
+    enum class Operation : uint8_t
+    {
+        Constant,
+        X,
+        Y,
+        Z,
+        Add,
+        Subtract,
+        Multiply,
+        Divide,
+        Negate,
+        Square,
+        SquareRoot,
+        Conjunction,
+        Disjunction
+    };
+
+    // Computes the result register from the first and the second one, unary operations read only the first
+    struct Instruction
+    {
+        Operation operation;
+        uint32_t result;
+        uint32_t first;
+        uint32_t second;
+    };
+
+    class Compiler;
+    class Parser;
+
+    ShapeExpression() = default;
+
+    // Calls visitor(apply) with a generic apply(first, second) computing the operation of two or one register
+    // on FLOATs and FloatPacks, the operations without arguments are not visited
+    template <class Visitor> static void visitOperation(Operation operation, const Visitor& visitor);
+
+    // Points evaluated by one pass over the instructions
+    static constexpr size_t ChunkSize = 64u;
+
+    // Registers 0, 1 and 2 are x, y and z, the constants follow them
+    static constexpr uint32_t ConstantsStart = 3u;
+
+    // Runs the instructions over the first lanesNumber values of registers of ChunkSize values each,
+    // lanesNumber is a multiple of FloatPack::Size
+    void evaluateChunk(FLOAT* registers, size_t lanesNumber) const;
+
+private:
+    std::vector<FLOAT> m_constants;
+
+    std::vector<Instruction> m_instructions;
+
+    // Registers of instructions are reused once their values are read for the last time,
+    // so the registers of a chunk stay in the L1 cache
+    size_t m_registersNumber = ConstantsStart;
+
+    uint32_t m_result = 0u;
+};
+
+} // namespace SPHSDK
+
+#endif // SHAPE_EXPRESSION_H_E41B7C2D9A0F4D5C8B36F1A27D9E0C84
@@ -7,6 +7,7 @@
 #ifndef SHAPES_H_19D5A367806A431C96F39D5F50B94D31
 #define SHAPES_H_19D5A367806A431C96F39D5F50B94D31
 
+#include "FloatPack.h"
 #include "ROperations.h"
 
 namespace SPHSDK
@@ -17,10 +18,6 @@ namespace SPHSDK
  */
 class Shapes
 {
-private:
-    static constexpr auto dis = ROperations::disjunction<FLOAT>;
-    static constexpr auto con = ROperations::conjunction<FLOAT>;
-
 public:
     /**
      * @brief Represents a pawn in 3D.
@@ -31,14 +28,16 @@ public:
      */
     static FLOAT Pawn(FLOAT x, FLOAT y, FLOAT z)
     {
-        const FLOAT x_sqr = (x - 1.5f) * (x - 1.5f);
-        const FLOAT y_sqr = (y - 1.5f) * (y - 1.5f);
-        const FLOAT z1_sqr = (z - 0.75f) * (z - 0.75f);
-        const FLOAT z2_sqr = (1.f - z) * (1.f - z);
-        const FLOAT z3_sqr = (1.25f - z) * (1.25f - z);
+        return pawn(x, y, z);
+    }
 
-        return dis(con(con(0.25f - x_sqr - y_sqr, -20.f * (x_sqr + y_sqr) + 1.f + 10.f * z1_sqr), z * (1.f - z)),
-                   dis(0.125f - x_sqr - y_sqr - 20.f * z2_sqr, 0.05f - x_sqr - y_sqr - z3_sqr));
+    /**
+     * @brief Evaluates the pawn in n points, out[i] = Pawn(xs[i], ys[i], zs[i]), several points at a time
+     * with SIMD, see FloatPack. The arguments are the batched field of MarchingCubes::generateMesh().
+     */
+    static void PawnBatch(const FLOAT* xs, const FLOAT* ys, const FLOAT* zs, FLOAT* out, size_t n)
+    {
+        evaluateInPacks([](const auto& x, const auto& y, const auto& z) { return pawn(x, y, z); }, xs, ys, zs, out, n);
     }
 
     /**
@@ -50,11 +49,45 @@ public:
      */
     static FLOAT Bishop(FLOAT x, FLOAT y, FLOAT z)
     {
-        const FLOAT x_sqr = (x - 1.5f) * (x - 1.5f);
-        const FLOAT y_sqr = (y - 1.5f) * (y - 1.5f);
-        const FLOAT z1_sqr = (z - 0.85f) * (z - 0.85f);
-        const FLOAT z2_sqr = (1.25f - z) * (1.25f - z);
-        const FLOAT z3_sqr = (1.4f - z) * (1.4f - z);
+        return bishop(x, y, z);
+    }
+
+    /**
+     * @brief Evaluates the bishop in n points, out[i] = Bishop(xs[i], ys[i], zs[i]), see PawnBatch().
+     */
+    static void BishopBatch(const FLOAT* xs, const FLOAT* ys, const FLOAT* zs, FLOAT* out, size_t n)
+    {
+        evaluateInPacks([](const auto& x, const auto& y, const auto& z) { return bishop(x, y, z); }, xs, ys, zs, out,
+                        n);
+    }
+
+private:
+    // The equations are written once for FLOAT and FloatPack
+    template <class T> static T pawn(const T& x, const T& y, const T& z)
+    {
+        const auto dis = ROperations::disjunction<T>;
+        const auto con = ROperations::conjunction<T>;
+
+        const T x_sqr = (x - 1.5f) * (x - 1.5f);
+        const T y_sqr = (y - 1.5f) * (y - 1.5f);
+        const T z1_sqr = (z - 0.75f) * (z - 0.75f);
+        const T z2_sqr = (1.f - z) * (1.f - z);
+        const T z3_sqr = (1.25f - z) * (1.25f - z);
+
+        return dis(con(con(0.25f - x_sqr - y_sqr, -20.f * (x_sqr + y_sqr) + 1.f + 10.f * z1_sqr), z * (1.f - z)),
+                   dis(0.125f - x_sqr - y_sqr - 20.f * z2_sqr, 0.05f - x_sqr - y_sqr - z3_sqr));
+    }
+
+    template <class T> static T bishop(const T& x, const T& y, const T& z)
+    {
+        const auto dis = ROperations::disjunction<T>;
+        const auto con = ROperations::conjunction<T>;
+
+        const T x_sqr = (x - 1.5f) * (x - 1.5f);
+        const T y_sqr = (y - 1.5f) * (y - 1.5f);
+        const T z1_sqr = (z - 0.85f) * (z - 0.85f);
+        const T z2_sqr = (1.25f - z) * (1.25f - z);
+        const T z3_sqr = (1.4f - z) * (1.4f - z);
 
         return dis(con(con(0.25f - x_sqr - y_sqr, -20.f * (x_sqr + y_sqr) + 1.f + 10.f * z1_sqr), z * (1.25f - z)),
                    dis(0.2f - x_sqr - y_sqr - 20.f * z2_sqr, 0.2f - 5.f * x_sqr - 4.f * y_sqr - z3_sqr));
@@ -0,0 +1,414 @@
+/**
+ * @file SignedDistanceField.cpp
+ * @author Anton Artyukh (artyukhanton@gmail.com)
+ * @date Created Oct 19, 2026
+ **/
+
+#include "SignedDistanceField.h"
+
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+namespace SPHSDK
+{
+
+namespace
+{
+// Samples along one side of a brick
+const size_t BrickNodes = SignedDistanceField::BrickSize + 1u;
+
+// Nodes along one side of a brick with one more node on every side for central differences
+const size_t PaddedNodes = BrickNodes + 2u;
+
+inline size_t nodeIndex(size_t x, size_t y, size_t z, size_t side)
+{
+    return x + side * (y + side * z);
+}
+
+inline FLOAT lerp(FLOAT a, FLOAT b, FLOAT t)
+{
+    return a + (b - a) * t;
+}
+
+// Cells along one axis of a loaded field, keeps the number of bricks far from overflow
+const size_t MaxCellsPerAxis = static_cast<size_t>(1u) << 20u;
+
+// Marks the beginning of a saved field, the last symbols are the version of the format
+const char FileSignature[8] = {'S', 'P', 'H', 'S', 'D', 'F', '0', '1'};
+
+template <class T> void write(std::ostream& stream, const T& value)
+{
+    stream.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+template <class T> T read(std::istream& stream)
+{
+    T value;
+    if (!stream.read(reinterpret_cast<char*>(&value), sizeof(value)))
+        throw std::runtime_error("Truncated signed distance field");
+
+    return value;
+}
+} // namespace
+
+SignedDistanceField::SignedDistanceField()
+    : m_origin()
+    , m_cellSize(1.0)
+    , m_bandWidth(0.0)
+    , m_cells{0u, 0u, 0u}
+    , m_bricks{0u, 0u, 0u}
+{
+}
+
+SignedDistanceField::SignedDistanceField(
+    const Function& function, const Cuboid& bounds, FLOAT cellSize, FLOAT bandWidth, ThreadPool* pool)
+    : m_origin(bounds.startingPoint)
+    , m_cellSize(cellSize)
+    , m_bandWidth(std::max(bandWidth, 2.0 * cellSize))
+{
+    const FLOAT extents[3] = {bounds.width, bounds.length, bounds.height};
+
+    for (size_t axis = 0u; axis < 3u; ++axis)
+    {
+        m_cells[axis] = std::max<size_t>(1u, static_cast<size_t>(std::ceil(extents[axis] / m_cellSize)));
+        m_bricks[axis] = (m_cells[axis] + BrickSize - 1u) / BrickSize;
+    }
+
+    const size_t bricksNumber = m_bricks[0] * m_bricks[1] * m_bricks[2];
+    const size_t layerBricks = m_bricks[0] * m_bricks[1];
+
+    // Bricks far from the surface leave their samples empty
+    std::vector<std::vector<Sample>> brickSamples(bricksNumber);
+
+    const auto forRange = [pool](size_t count, const ThreadPool::RangeFunction& body) {
+        if (pool != nullptr)
+            pool->parallelFor(0u, count, body);
+        else
+            body(0u, count);
+    };
+
+    // Function values of the nodes of one layer of bricks with one more node on every side, x changes fastest,
+    // the next layer of bricks shares the last keptLayers node layers, so they are moved, not evaluated again
+    const size_t keptLayers = PaddedNodes - BrickSize;
+    const size_t rowNodes = m_bricks[0] * BrickSize + keptLayers;
+    const size_t rowsPerLayer = m_bricks[1] * BrickSize + keptLayers;
+    const size_t layerNodes = rowNodes * rowsPerLayer;
+
+    std::vector<FLOAT> values(layerNodes * PaddedNodes);
+
+    for (size_t brickZ = 0u; brickZ < m_bricks[2]; ++brickZ)
+    {
+        const size_t firstLayer = brickZ == 0u ? 0u : keptLayers;
+        if (firstLayer > 0u)
+            std::copy(values.end() - static_cast<std::ptrdiff_t>(keptLayers * layerNodes), values.end(),
+                      values.begin());
+
+        // Node (i, j, k) of values is the grid node (i - 1, j - 1, brickZ * BrickSize + k - 1)
+        const auto evaluateRows = [this, &function, &values, brickZ, firstLayer, rowNodes, rowsPerLayer](
+                                      size_t begin, size_t end) {
+            for (size_t row = begin; row < end; ++row)
+            {
+                const size_t j = row % rowsPerLayer;
+                const size_t k = firstLayer + row / rowsPerLayer;
+
+                const FLOAT py = m_origin.y + (static_cast<FLOAT>(j) - 1.0) * m_cellSize;
+                const FLOAT pz = m_origin.z + (static_cast<FLOAT>(brickZ * BrickSize + k) - 1.0) * m_cellSize;
+
+                FLOAT* rowValues = &values[rowNodes * (j + rowsPerLayer * k)];
+                for (size_t i = 0u; i < rowNodes; ++i)
+                    rowValues[i] = function(m_origin.x + (static_cast<FLOAT>(i) - 1.0) * m_cellSize, py, pz);
+            }
+        };
+
+        forRange((PaddedNodes - firstLayer) * rowsPerLayer, evaluateRows);
+
+        const auto sampleRange = [this, &values, &brickSamples, brickZ, layerBricks](size_t begin, size_t end) {
+            for (size_t brick = begin; brick < end; ++brick)
+                sampleBrick(values, brickZ * layerBricks + brick, brickSamples[brickZ * layerBricks + brick]);
+        };
+
+        forRange(layerBricks, sampleRange);
+    }
+
+    m_brickSlots.resize(bricksNumber);
+
+    int32_t bandBricks = 0;
+    for (size_t brick = 0u; brick < bricksNumber; ++brick)
+    {
+        if (brickSamples[brick].size() == 1u)
+        {
+            m_brickSlots[brick] = brickSamples[brick].front().distance > 0.0 ? FarInside : FarOutside;
+            continue;
+        }
+
+        m_brickSlots[brick] = bandBricks++;
+        m_samples.insert(m_samples.end(), brickSamples[brick].begin(), brickSamples[brick].end());
+
+        std::vector<Sample>().swap(brickSamples[brick]);
+    }
+}
+
+FLOAT SignedDistanceField::getCellSize() const
+{
+    return m_cellSize;
+}
+
+FLOAT SignedDistanceField::getBandWidth() const
+{
+    return m_bandWidth;
+}
+
+Cuboid SignedDistanceField::getBounds() const
+{
+    return Cuboid(m_origin, m_cells[0] * m_cellSize, m_cells[1] * m_cellSize, m_cells[2] * m_cellSize);
+}
+
+FLOAT SignedDistanceField::getDistance(const Point3F& point) const
+{
+    size_t brick = 0u;
+    Point3F local;
+
+    if (!locate(point, brick, local))
+        return -m_bandWidth;
+
+    const int32_t slot = m_brickSlots[brick];
+    if (slot < 0)
+        return slot == FarInside ? m_bandWidth : -m_bandWidth;
+
+    const size_t x = std::min(static_cast<size_t>(local.x), BrickSize - 1u);
+    const size_t y = std::min(static_cast<size_t>(local.y), BrickSize - 1u);
+    const size_t z = std::min(static_cast<size_t>(local.z), BrickSize - 1u);
+
+    const FLOAT tx = local.x - x;
+    const FLOAT ty = local.y - y;
+    const FLOAT tz = local.z - z;
+
+    const Sample* samples = &m_samples[static_cast<size_t>(slot) * BrickNodes * BrickNodes * BrickNodes];
+    const auto at = [samples, x, y, z](size_t dx, size_t dy, size_t dz) {
+        return samples[nodeIndex(x + dx, y + dy, z + dz, BrickNodes)].distance;
+    };
+
+    return lerp(lerp(lerp(at(0, 0, 0), at(1, 0, 0), tx), lerp(at(0, 1, 0), at(1, 1, 0), tx), ty),
+                lerp(lerp(at(0, 0, 1), at(1, 0, 1), tx), lerp(at(0, 1, 1), at(1, 1, 1), tx), ty), tz);
+}
+
+bool SignedDistanceField::sample(const Point3F& point, FLOAT& distance, Point3F& gradient) const
+{
+    gradient = Point3F();
+
+    size_t brick = 0u;
+    Point3F local;
+
+    if (!locate(point, brick, local))
+    {
+        distance = -m_bandWidth;
+        return false;
+    }
+
+    const int32_t slot = m_brickSlots[brick];
+    if (slot < 0)
+    {
+        distance = slot == FarInside ? m_bandWidth : -m_bandWidth;
+        return false;
+    }
+
+    const size_t x = std::min(static_cast<size_t>(local.x), BrickSize - 1u);
+    const size_t y = std::min(static_cast<size_t>(local.y), BrickSize - 1u);
+    const size_t z = std::min(static_cast<size_t>(local.z), BrickSize - 1u);
+
+    const FLOAT t[3] = {local.x - x, local.y - y, local.z - z};
+
+    const Sample* samples = &m_samples[static_cast<size_t>(slot) * BrickNodes * BrickNodes * BrickNodes];
+
+    distance = 0.0;
+    for (size_t corner = 0u; corner < 8u; ++corner)
+    {
+        const size_t dx = corner & 1u;
+        const size_t dy = (corner >> 1) & 1u;
+        const size_t dz = (corner >> 2) & 1u;
+
+        const FLOAT weight = (dx ? t[0] : 1.0 - t[0]) * (dy ? t[1] : 1.0 - t[1]) * (dz ? t[2] : 1.0 - t[2]);
+        const Sample& node = samples[nodeIndex(x + dx, y + dy, z + dz, BrickNodes)];
+
+        distance += weight * node.distance;
+        gradient += node.gradient * weight;
+    }
+
+    return true;
+}
+
+void SignedDistanceField::save(std::ostream& stream) const
+{
+    stream.write(FileSignature, sizeof(FileSignature));
+
+    write(stream, m_origin.x);
+    write(stream, m_origin.y);
+    write(stream, m_origin.z);
+    write(stream, m_cellSize);
+    write(stream, m_bandWidth);
+
+    for (size_t axis = 0u; axis < 3u; ++axis)
+        write(stream, static_cast<uint64_t>(m_cells[axis]));
+
+    write(stream, static_cast<uint64_t>(m_samples.size()));
+
+    stream.write(reinterpret_cast<const char*>(m_brickSlots.data()),
+                 static_cast<std::streamsize>(m_brickSlots.size() * sizeof(int32_t)));
+
+    for (const Sample& sample : m_samples)
+    {
+        write(stream, sample.distance);
+        write(stream, sample.gradient.x);
+        write(stream, sample.gradient.y);
+        write(stream, sample.gradient.z);
+    }
+}
+
+SignedDistanceField SignedDistanceField::load(std::istream& stream)
+{
+    char signature[sizeof(FileSignature)];
+    if (!stream.read(signature, sizeof(signature)) || std::memcmp(signature, FileSignature, sizeof(signature)) != 0)
+        throw std::runtime_error("Stream does not contain signed distance field");
+
+    SignedDistanceField field;
+
+    field.m_origin.x = read<FLOAT>(stream);
+    field.m_origin.y = read<FLOAT>(stream);
+    field.m_origin.z = read<FLOAT>(stream);
+    field.m_cellSize = read<FLOAT>(stream);
+    field.m_bandWidth = read<FLOAT>(stream);
+
+    if (!(field.m_cellSize > 0.0))
+        throw std::runtime_error("Corrupted signed distance field");
+
+    for (size_t axis = 0u; axis < 3u; ++axis)
+    {
+        field.m_cells[axis] = static_cast<size_t>(read<uint64_t>(stream));
+        if (field.m_cells[axis] == 0u || field.m_cells[axis] > MaxCellsPerAxis)
+            throw std::runtime_error("Corrupted signed distance field");
+
+        field.m_bricks[axis] = (field.m_cells[axis] + BrickSize - 1u) / BrickSize;
+    }
+
+    const size_t bricksNumber = field.m_bricks[0] * field.m_bricks[1] * field.m_bricks[2];
+    const size_t brickSamples = BrickNodes * BrickNodes * BrickNodes;
+
+    // Samples come in whole bricks and no more bricks than the grid has, checked before anything is allocated
+    const size_t samplesNumber = static_cast<size_t>(read<uint64_t>(stream));
+    if (samplesNumber % brickSamples != 0u || samplesNumber / brickSamples > bricksNumber)
+        throw std::runtime_error("Corrupted signed distance field");
+
+    // Slots are read in chunks, so corrupted extents of the grid end up in a truncated stream, not a huge allocation
+    const size_t SlotsChunk = 4096u;
+    while (field.m_brickSlots.size() < bricksNumber)
+    {
+        const size_t begin = field.m_brickSlots.size();
+        field.m_brickSlots.resize(std::min(bricksNumber, begin + SlotsChunk));
+
+        if (!stream.read(reinterpret_cast<char*>(field.m_brickSlots.data() + begin),
+                         static_cast<std::streamsize>((field.m_brickSlots.size() - begin) * sizeof(int32_t))))
+            throw std::runtime_error("Truncated signed distance field");
+    }
+
+    for (const int32_t slot : field.m_brickSlots)
+    {
+        const bool isFar = slot == FarInside || slot == FarOutside;
+        if (!isFar && (slot < 0 || static_cast<size_t>(slot) >= samplesNumber / brickSamples))
+            throw std::runtime_error("Corrupted signed distance field");
+    }
+
+    field.m_samples.resize(samplesNumber);
+    for (Sample& sample : field.m_samples)
+    {
+        sample.distance = read<FLOAT>(stream);
+        sample.gradient.x = read<FLOAT>(stream);
+        sample.gradient.y = read<FLOAT>(stream);
+        sample.gradient.z = read<FLOAT>(stream);
+    }
+
+    return field;
+}
+
+void SignedDistanceField::sampleBrick(const std::vector<FLOAT>& values,
+                                      size_t                    brick,
+                                      std::vector<Sample>&      samples) const
+{
+    const size_t firstX = (brick % m_bricks[0]) * BrickSize;
+    const size_t firstY = (brick / m_bricks[0] % m_bricks[1]) * BrickSize;
+
+    const size_t rowNodes = m_bricks[0] * BrickSize + PaddedNodes - BrickSize;
+    const size_t rowsPerLayer = m_bricks[1] * BrickSize + PaddedNodes - BrickSize;
+
+    samples.resize(BrickNodes * BrickNodes * BrickNodes);
+
+    bool inBand = false;
+    for (size_t k = 0u; k < BrickNodes; ++k)
+        for (size_t j = 0u; j < BrickNodes; ++j)
+            for (size_t i = 0u; i < BrickNodes; ++i)
+            {
+                // Node (i, j, k) of the padded brick is the grid node (first + i - 1, first + j - 1, first + k - 1)
+                const auto value = [&values, firstX, firstY, rowNodes, rowsPerLayer, i, j, k](size_t di, size_t dj,
+                                                                                              size_t dk) {
+                    return values[firstX + i + di + rowNodes * (firstY + j + dj + rowsPerLayer * (k + dk))];
+                };
+
+                const FLOAT f = value(1u, 1u, 1u);
+                const Point3F gradient((value(2u, 1u, 1u) - value(0u, 1u, 1u)) / (2.0 * m_cellSize),
+                                       (value(1u, 2u, 1u) - value(1u, 0u, 1u)) / (2.0 * m_cellSize),
+                                       (value(1u, 1u, 2u) - value(1u, 1u, 0u)) / (2.0 * m_cellSize));
+                const FLOAT gradientNorm = gradient.calcNorm();
+
+                Sample& sample = samples[nodeIndex(i, j, k, BrickNodes)];
+
+                if (gradientNorm > 0.0)
+                {
+                    sample.distance = std::max(-m_bandWidth, std::min(m_bandWidth, f / gradientNorm));
+                    sample.gradient = gradient / gradientNorm;
+                }
+                else
+                {
+                    sample.distance = f > 0.0 ? m_bandWidth : -m_bandWidth;
+                    sample.gradient = Point3F();
+                }
+
+                inBand = inBand || std::fabs(sample.distance) < m_bandWidth;
+            }
+
+    // A far brick keeps only its central sample to tell the side of the surface
+    if (!inBand)
+    {
+        const Sample centre = samples[nodeIndex(BrickSize / 2u, BrickSize / 2u, BrickSize / 2u, BrickNodes)];
+        samples.assign(1u, centre);
+    }
+}
+
+bool SignedDistanceField::locate(const Point3F& point, size_t& brick, Point3F& local) const
+{
+    const FLOAT coordinates[3] = {(point.x - m_origin.x) / m_cellSize, (point.y - m_origin.y) / m_cellSize,
+                                  (point.z - m_origin.z) / m_cellSize};
+
+    size_t brickCoordinates[3];
+    FLOAT localCoordinates[3];
+
+    for (size_t axis = 0u; axis < 3u; ++axis)
+    {
+        // Also rejects NaN
+        if (!(coordinates[axis] >= 0.0 && coordinates[axis] <= static_cast<FLOAT>(m_cells[axis])))
+            return false;
+
+        const size_t cell = std::min(static_cast<size_t>(coordinates[axis]), m_cells[axis] - 1u);
+        brickCoordinates[axis] = cell / BrickSize;
+        localCoordinates[axis] = coordinates[axis] - static_cast<FLOAT>(brickCoordinates[axis] * BrickSize);
+    }
+
+    brick = brickCoordinates[0] + m_bricks[0] * (brickCoordinates[1] + m_bricks[1] * brickCoordinates[2]);
+    local = Point3F(localCoordinates[0], localCoordinates[1], localCoordinates[2]);
+
+    return true;
+}
+
+} // namespace SPHSDK
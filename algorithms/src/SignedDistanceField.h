@@ -0,0 +1,136 @@
+/**
+ * @file SignedDistanceField.h
+ * @author Anton Artyukh (artyukhanton@gmail.com)
+ * @date Created Oct 19, 2026
+ **/
+
+#ifndef SIGNED_DISTANCE_FIELD_H_00F70B5354954873838408B5A9804199
+#define SIGNED_DISTANCE_FIELD_H_00F70B5354954873838408B5A9804199
+
+#include "Area.h"
+#include "Point.h"
+
+#include <cstdint>
+#include <functional>
+#include <istream>
+#include <ostream>
+#include <vector>
+
+namespace SPHSDK
+{
+
+class ThreadPool;
+
+namespace TestEnvironment
+{
+class SignedDistanceFieldTestSuite;
+} // namespace TestEnvironment
+
+/**
+ * @brief SignedDistanceField class caches an R-function as distances to its zero level sampled on a voxel grid.
+ * Only a narrow band around the surface is stored: the grid is split into bricks of BrickSize cells
+ * and a brick keeps its samples only if one of them is closer to the surface than the band width,
+ * other bricks keep just the side of the surface they lie on.
+ *
+ * Distances have the sign of the function, > 0 inside the object and < 0 outside,
+ * they are estimated as f / |grad f| and clamped to the band width.
+ * Points outside of the grid are treated as far outside of the object.
+ */
+class SignedDistanceField
+{
+    friend class TestEnvironment::SignedDistanceFieldTestSuite;
+
+public:
+    using Function = std::function<FLOAT(FLOAT, FLOAT, FLOAT)>;
+
+    // Cells along one side of a brick
+    static constexpr size_t BrickSize = 8u;
+
+    SignedDistanceField();
+
+    /**
+     * @brief Samples the function at the nodes of the grid covering bounds.
+     * @param function     The R-function of the object, > 0 inside
+     * @param bounds       The region the field covers
+     * @param cellSize     The side of one voxel
+     * @param bandWidth    The distance from the surface kept in the field, at least two cells
+     * @param pool         The pool sampling bricks in parallel, nullptr samples them on the calling thread
+     */
+    SignedDistanceField(const Function& function,
+                        const Cuboid&   bounds,
+                        FLOAT           cellSize,
+                        FLOAT           bandWidth,
+                        ThreadPool*     pool = nullptr);
+
+    FLOAT getCellSize() const;
+
+    FLOAT getBandWidth() const;
+
+    /**
+     * @brief Returns the region covered by the grid, it may exceed the bounds given on construction by a cell.
+     */
+    Cuboid getBounds() const;
+
+    /**
+     * @brief Returns the trilinearly interpolated distance,
+     * points in bricks without samples get +-bandWidth without interpolation.
+     */
+    FLOAT getDistance(const Point3F& point) const;
+
+    /**
+     * @brief Returns distance and its gradient, the gradient points into the object.
+     * @return false if the point lies in a brick without samples,
+     * then distance is +-bandWidth and gradient is zero
+     */
+    bool sample(const Point3F& point, FLOAT& distance, Point3F& gradient) const;
+
+    /**
+     * @brief Writes the field in binary form, the stream must be opened in binary mode.
+     */
+    void save(std::ostream& stream) const;
+
+    /**
+     * @brief Reads the field written by save().
+     * @throw std::runtime_error if the stream does not contain a field, the field is truncated
+     * or its brick slots do not match its samples
+     */
+    static SignedDistanceField load(std::istream& stream);
+
+private:
+    struct Sample
+    {
+        FLOAT distance;
+        Point3F gradient;
+    };
+
+    // Slots of bricks without samples
+    static constexpr int32_t FarInside = -1;
+    static constexpr int32_t FarOutside = -2;
+
+    // Samples the brick from the function values of the node layers of its layer of bricks, see the constructor
+    void sampleBrick(const std::vector<FLOAT>& values, size_t brick, std::vector<Sample>& samples) const;
+
+    // Returns false if the point is outside of the grid, otherwise the brick and the position inside it in cells
+    bool locate(const Point3F& point, size_t& brick, Point3F& local) const;
+
+private:
+    Point3F m_origin;
+    FLOAT m_cellSize;
+    FLOAT m_bandWidth;
+
+    // Cells along x, y, z
+    size_t m_cells[3];
+
+    // Bricks along x, y, z
+    size_t m_bricks[3];
+
+    // Offset of the samples of every brick divided by the number of samples in a brick, or FarInside, FarOutside
+    std::vector<int32_t> m_brickSlots;
+
+    // (BrickSize + 1)^3 samples of every band brick, x changes fastest
+    std::vector<Sample> m_samples;
+};
+
+} // namespace SPHSDK
+
+#endif // SIGNED_DISTANCE_FIELD_H_00F70B5354954873838408B5A9804199
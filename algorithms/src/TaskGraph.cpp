@@ -0,0 +1,102 @@
+/**
+ * @file TaskGraph.cpp
+ * @author Anton Artyukh (artyukhanton@gmail.com)
+ * @date Created Oct 19, 2026
+ **/
+
+#include "TaskGraph.h"
+
+#include <atomic>
+#include <stdexcept>
+
+namespace SPHSDK
+{
+
+size_t TaskGraph::addTask(Task task)
+{
+    return addTask(std::move(task), NoHomeWorker);
+}
+
+size_t TaskGraph::addTask(Task task, size_t homeWorker)
+{
+    m_nodes.push_back(Node{std::move(task), SizetVector(), 0u, homeWorker});
+    return m_nodes.size() - 1u;
+}
+
+void TaskGraph::addDependency(size_t predecessor, size_t successor)
+{
+    m_nodes[predecessor].successors.push_back(successor);
+    ++m_nodes[successor].predecessorsNumber;
+}
+
+size_t TaskGraph::getTasksNumber() const
+{
+    return m_nodes.size();
+}
+
+void TaskGraph::run(ThreadPool& pool) const
+{
+    if (m_nodes.empty())
+        return;
+
+    checkAcyclic();
+
+    std::vector<std::atomic<size_t>> pending(m_nodes.size());
+    SizetVector ready;
+
+    for (size_t i = 0u; i < m_nodes.size(); ++i)
+    {
+        pending[i] = m_nodes[i].predecessorsNumber;
+        if (pending[i] == 0u)
+            ready.push_back(i);
+    }
+
+    pool.runTasks(ready, [this, &pool, &pending](size_t taskIndex) {
+        m_nodes[taskIndex].task();
+
+        // The worker runs the newest spawned task first, so the first successor goes last
+        const SizetVector& successors = m_nodes[taskIndex].successors;
+        for (size_t i = successors.size(); i > 0u; --i)
+        {
+            const size_t successor = successors[i - 1u];
+            if (--pending[successor] != 0u)
+                continue;
+
+            if (m_nodes[successor].homeWorker == NoHomeWorker)
+                pool.spawn(successor);
+            else
+                pool.spawn(successor, m_nodes[successor].homeWorker);
+        }
+    });
+}
+
+void TaskGraph::checkAcyclic() const
+{
+    SizetVector pending(m_nodes.size());
+    SizetVector ready;
+
+    for (size_t i = 0u; i < m_nodes.size(); ++i)
+    {
+        pending[i] = m_nodes[i].predecessorsNumber;
+        if (pending[i] == 0u)
+            ready.push_back(i);
+    }
+
+    size_t visited = 0u;
+
+    while (!ready.empty())
+    {
+        const size_t taskIndex = ready.back();
+        ready.pop_back();
+        ++visited;
+
+        for (size_t successor : m_nodes[taskIndex].successors)
+            if (--pending[successor] == 0u)
+                ready.push_back(successor);
+    }
+
+    if (visited != m_nodes.size())
+        throw std::logic_error("TaskGraph contains a cycle");
+}
+
+} // namespace SPHSDK
@@ -0,0 +1,78 @@
+/**
+ * @file TaskGraph.h
+ * @author Anton Artyukh (artyukhanton@gmail.com)
+ * @date Created Oct 19, 2026
+ **/
+
+#ifndef TASK_GRAPH_H_5F0C3A9E2B7D4C41A6E8D1F27B93C640
+#define TASK_GRAPH_H_5F0C3A9E2B7D4C41A6E8D1F27B93C640
+
+#include "Defines.h"
+#include "ThreadPool.h"
+
+#include <functional>
+#include <vector>
+
+namespace SPHSDK
+{
+
+/**
+ * @brief TaskGraph class runs a set of tasks with dependencies on ThreadPool.
+ * A task starts as soon as all its predecessors are finished, there are no barriers
+ * between groups of tasks, so independent chains of work overlap.
+ * Tasks made ready by a finished task are queued on the same worker or on their home worker,
+ * idle workers steal them.
+ */
+class TaskGraph
+{
+public:
+    using Task = std::function<void()>;
+
+    /**
+     * @brief Adds task to the graph.
+     * @return index of the task to be used in addDependency()
+     */
+    size_t addTask(Task task);
+
+    /**
+     * @brief Adds task which is queued on the given worker of the pool once it is ready,
+     * e.g. so a task runs on the NUMA node of the data it works on.
+     * Tasks without predecessors are split among the workers by runTasks() instead.
+     */
+    size_t addTask(Task task, size_t homeWorker);
+
+    /**
+     * @brief Makes task successor wait for task predecessor.
+     */
+    void addDependency(size_t predecessor, size_t successor);
+
+    size_t getTasksNumber() const;
+
+    /**
+     * @brief Runs all tasks on the pool and returns when every task is finished.
+     * @throw std::logic_error if dependencies contain a cycle
+     */
+    void run(ThreadPool& pool) const;
+
+private:
+    void checkAcyclic() const;
+
+private:
+    struct Node
+    {
+        Task task;
+        SizetVector successors;
+        size_t predecessorsNumber;
+
+        // NoHomeWorker queues the task on the worker which finished its last predecessor
+        size_t homeWorker;
+    };
+
+    static constexpr size_t NoHomeWorker = static_cast<size_t>(-1);
+
+    std::vector<Node> m_nodes;
+};
+
+} // namespace SPHSDK
+
+#endif // TASK_GRAPH_H_5F0C3A9E2B7D4C41A6E8D1F27B93C640
@@ -0,0 +1,569 @@
+/**
+ * @file ThreadPool.cpp
+ * @author Anton Artyukh (artyukhanton@gmail.com)
+ * @date Created Oct 19, 2026
+ **/
+
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <exception>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace SPHSDK
+{
+
+namespace
+{
+// Set for the pool threads, used to run nested parallel loops serially
+thread_local bool isPoolWorker = false;
+
+// The pool and the index of the worker running on this thread, used to account statistics
+thread_local const ThreadPool* workerPool = nullptr;
+thread_local size_t workerIndex = 0u;
+
+#ifdef __linux__
+// Parses lists like "0-3,8,10-11" used by sysfs
+SizetVector parseCpuList(const std::string& text)
+{
+    SizetVector result;
+
+    std::istringstream stream(text);
+    std::string range;
+
+    while (std::getline(stream, range, ','))
+    {
+        const size_t dash = range.find('-');
+
+        try
+        {
+            const size_t first = std::stoul(range.substr(0u, dash));
+            const size_t last = dash == std::string::npos ? first : std::stoul(range.substr(dash + 1u));
+
+            for (size_t cpu = first; cpu <= last; ++cpu)
+                result.push_back(cpu);
+        }
+        catch (const std::exception&)
+        {
+            return SizetVector();
+        }
+    }
+
+    return result;
+}
+
+SizetVector getAvailableCpus()
+{
+    SizetVector result;
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+
+    if (sched_getaffinity(0, sizeof(set), &set) != 0)
+        return result;
+
+    for (size_t cpu = 0u; cpu < CPU_SETSIZE; ++cpu)
+        if (CPU_ISSET(cpu, &set))
+            result.push_back(cpu);
+
+    return result;
+}
+
+// Returns available CPUs of every NUMA node, all CPUs form one node if the topology is unknown
+VectorOfSizetVectors getNumaNodesCpus(const SizetVector& availableCpus)
+{
+    VectorOfSizetVectors result;
+
+    std::ifstream onlineFile("/sys/devices/system/node/online");
+    std::string online;
+
+    if (onlineFile && std::getline(onlineFile, online))
+    {
+        for (const size_t node : parseCpuList(online))
+        {
+            std::ifstream cpuListFile("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+            std::string cpuList;
+
+            if (!cpuListFile || !std::getline(cpuListFile, cpuList))
+                continue;
+
+            SizetVector nodeCpus;
+            for (const size_t cpu : parseCpuList(cpuList))
+                if (std::find(availableCpus.begin(), availableCpus.end(), cpu) != availableCpus.end())
+                    nodeCpus.push_back(cpu);
+
+            if (!nodeCpus.empty())
+                result.push_back(nodeCpus);
+        }
+    }
+
+    if (result.empty())
+        result.push_back(availableCpus);
+
+    return result;
+}
+
+void pinCurrentThread(const SizetVector& cpus)
+{
+    cpu_set_t set;
+    CPU_ZERO(&set);
+
+    for (const size_t cpu : cpus)
+        CPU_SET(cpu, &set);
+
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+}
+#endif
+} // namespace
+
+ThreadPoolOptions::ThreadPoolOptions()
+    : threadsNumber(0u)
+    , affinity(ThreadAffinity::None)
+    , grainSize(0u)
+{
+}
+
+WorkerStats::WorkerStats()
+    : tasksRun(0u)
+    , steals(0u)
+    , idleSeconds(0.0)
+{
+}
+
+/**
+ * @brief Queues and counters of one runTasks() call.
+ * outstanding counts queued and running tasks, queued counts only the waiting ones.
+ * The first exception of a task is kept in error, the tasks queued after it are dropped.
+ */
+struct ThreadPool::TaskRegion
+{
+    struct Queue
+    {
+        std::mutex mutex;
+        std::deque<size_t> tasks;
+    };
+
+    TaskRegion(const TaskFunction& body, size_t queuesNumber)
+        : body(body)
+        , queues(queuesNumber)
+        , outstanding(0u)
+        , queued(0u)
+        , isFailed(false)
+    {
+    }
+
+    const TaskFunction& body;
+
+    std::vector<Queue> queues;
+
+    std::atomic<size_t> outstanding;
+    std::atomic<size_t> queued;
+
+    std::atomic<bool> isFailed;
+
+    std::mutex mutex;
+    std::condition_variable condition;
+
+    // Guarded by mutex
+    std::exception_ptr error;
+};
+
+namespace
+{
+// The region and the queue of the worker running on this thread, used by spawn()
+thread_local void* currentRegion = nullptr;
+thread_local size_t currentQueue = 0u;
+} // namespace
+
+ThreadPool::ThreadPool(size_t threadsNumber)
+    : ThreadPool([threadsNumber] {
+        ThreadPoolOptions options;
+        options.threadsNumber = threadsNumber;
+        return options;
+    }())
+{
+}
+
+ThreadPool::ThreadPool(const ThreadPoolOptions& options)
+    : m_body(nullptr)
+    , m_begin(0u)
+    , m_end(0u)
+    , m_generation(0u)
+    , m_pendingWorkers(0u)
+    , m_stopping(false)
+    , m_grainSize(options.grainSize)
+{
+    size_t threadsNumber = options.threadsNumber;
+
+    if (threadsNumber == 0u)
+        threadsNumber = std::thread::hardware_concurrency();
+
+    if (threadsNumber == 0u)
+        threadsNumber = 1u;
+
+    m_workerCpus.resize(threadsNumber);
+    m_stats.resize(threadsNumber);
+
+    setupAffinity(options.affinity);
+
+    m_workers.reserve(threadsNumber - 1u);
+
+    for (size_t index = 1u; index < threadsNumber; ++index)
+        m_workers.emplace_back(&ThreadPool::workerLoop, this, index);
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+
+    m_wakeCondition.notify_all();
+
+    for (auto& worker : m_workers)
+        worker.join();
+}
+
+size_t ThreadPool::getThreadsNumber() const
+{
+    return m_workers.size() + 1u;
+}
+
+size_t ThreadPool::getGrainSize() const
+{
+    return m_grainSize;
+}
+
+void ThreadPool::setGrainSize(size_t grainSize)
+{
+    m_grainSize = grainSize;
+}
+
+const SizetVector& ThreadPool::getWorkerCpus(size_t index) const
+{
+    return m_workerCpus[index];
+}
+
+std::vector<WorkerStats> ThreadPool::getWorkerStats() const
+{
+    return m_stats;
+}
+
+void ThreadPool::resetWorkerStats()
+{
+    std::fill(m_stats.begin(), m_stats.end(), WorkerStats());
+}
+
+void ThreadPool::parallelFor(size_t begin, size_t end, const RangeFunction& body)
+{
+    dispatch(begin, end, [this, &body](size_t chunkBegin, size_t chunkEnd) {
+        body(chunkBegin, chunkEnd);
+        ++m_stats[workerPool == this ? workerIndex : 0u].tasksRun;
+    });
+}
+
+void ThreadPool::parallelForDynamic(size_t begin, size_t end, const RangeFunction& body)
+{
+    if (begin >= end)
+        return;
+
+    const size_t size = end - begin;
+    const size_t grainSize =
+        m_grainSize != 0u ? m_grainSize : std::max<size_t>(1u, size / (8u * getThreadsNumber()));
+
+    SizetVector tasks((size + grainSize - 1u) / grainSize);
+    for (size_t task = 0u; task < tasks.size(); ++task)
+        tasks[task] = task;
+
+    runTasks(tasks, [begin, end, grainSize, &body](size_t task) {
+        const size_t taskBegin = begin + task * grainSize;
+        body(taskBegin, std::min(end, taskBegin + grainSize));
+    });
+}
+
+void ThreadPool::runTasks(const SizetVector& initialTasks, const TaskFunction& body)
+{
+    if (initialTasks.empty())
+        return;
+
+    const size_t threadsNumber = getThreadsNumber();
+    const size_t size = initialTasks.size();
+
+    TaskRegion region(body, threadsNumber);
+
+    // Owners take tasks from the back, so chunks are pushed in reverse to be run from the front
+    for (size_t queueIndex = 0u; queueIndex < threadsNumber; ++queueIndex)
+    {
+        const size_t chunkBegin = size * queueIndex / threadsNumber;
+        const size_t chunkEnd = size * (queueIndex + 1u) / threadsNumber;
+
+        for (size_t i = chunkEnd; i > chunkBegin; --i)
+            region.queues[queueIndex].tasks.push_back(initialTasks[i - 1u]);
+    }
+
+    region.outstanding = size;
+    region.queued = size;
+
+    dispatch(0u, threadsNumber, [this, &region](size_t queueIndex, size_t) { runRegion(region, queueIndex); });
+
+    if (region.error)
+        std::rethrow_exception(region.error);
+}
+
+void ThreadPool::spawn(size_t task)
+{
+    spawn(task, currentQueue);
+}
+
+void ThreadPool::spawn(size_t task, size_t workerIndex)
+{
+    TaskRegion& region = *static_cast<TaskRegion*>(currentRegion);
+    TaskRegion::Queue& queue = region.queues[workerIndex % region.queues.size()];
+
+    ++region.outstanding;
+
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.push_back(task);
+    }
+
+    ++region.queued;
+
+    {
+        std::lock_guard<std::mutex> lock(region.mutex);
+    }
+
+    region.condition.notify_one();
+}
+
+void ThreadPool::dispatch(size_t begin, size_t end, const RangeFunction& body)
+{
+    if (begin >= end)
+        return;
+
+    // Calls of other threads take turns, the workers of a running call must not wait for it
+    std::unique_lock<std::recursive_mutex> callerLock(m_callerMutex, std::defer_lock);
+    if (workerPool != this)
+        callerLock.lock();
+
+    if (m_workers.empty() || isPoolWorker || end - begin == 1u)
+    {
+        body(begin, end);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_body = &body;
+        m_begin = begin;
+        m_end = end;
+        m_pendingWorkers = m_workers.size();
+        ++m_generation;
+    }
+
+    m_wakeCondition.notify_all();
+
+    const ThreadPool* const previousPool = workerPool;
+    const size_t previousIndex = workerIndex;
+
+    isPoolWorker = true;
+    workerPool = this;
+    workerIndex = 0u;
+
+    runChunk(0u);
+
+    isPoolWorker = false;
+    workerPool = previousPool;
+    workerIndex = previousIndex;
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_doneCondition.wait(lock, [this] { return m_pendingWorkers == 0u; });
+    m_body = nullptr;
+}
+
+void ThreadPool::workerLoop(size_t index)
+{
+    isPoolWorker = true;
+    workerPool = this;
+    workerIndex = index;
+
+#ifdef __linux__
+    if (!m_workerCpus[index].empty())
+        pinCurrentThread(m_workerCpus[index]);
+#endif
+
+    size_t seenGeneration = 0u;
+
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wakeCondition.wait(lock, [this, seenGeneration] {
+                return m_stopping || m_generation != seenGeneration;
+            });
+
+            if (m_stopping)
+                return;
+
+            seenGeneration = m_generation;
+        }
+
+        runChunk(index);
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            --m_pendingWorkers;
+        }
+
+        m_doneCondition.notify_one();
+    }
+}
+
+void ThreadPool::runChunk(size_t index)
+{
+    const size_t threadsNumber = getThreadsNumber();
+    const size_t size = m_end - m_begin;
+
+    const size_t chunkBegin = m_begin + size * index / threadsNumber;
+    const size_t chunkEnd = m_begin + size * (index + 1u) / threadsNumber;
+
+    if (chunkBegin < chunkEnd)
+        (*m_body)(chunkBegin, chunkEnd);
+}
+
+void ThreadPool::runRegion(TaskRegion& region, size_t queueIndex)
+{
+    void* const previousRegion = currentRegion;
+    const size_t previousQueue = currentQueue;
+
+    currentRegion = &region;
+    currentQueue = queueIndex;
+
+    WorkerStats& stats = m_stats[workerPool == this ? workerIndex : 0u];
+    const size_t queuesNumber = region.queues.size();
+
+    for (;;)
+    {
+        size_t task = 0u;
+        bool found = false;
+
+        {
+            TaskRegion::Queue& own = region.queues[queueIndex];
+            std::lock_guard<std::mutex> lock(own.mutex);
+
+            if (!own.tasks.empty())
+            {
+                task = own.tasks.back();
+                own.tasks.pop_back();
+                found = true;
+            }
+        }
+
+        for (size_t offset = 1u; !found && offset < queuesNumber; ++offset)
+        {
+            TaskRegion::Queue& victim = region.queues[(queueIndex + offset) % queuesNumber];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+
+            if (!victim.tasks.empty())
+            {
+                task = victim.tasks.front();
+                victim.tasks.pop_front();
+                found = true;
+                ++stats.steals;
+            }
+        }
+
+        if (found)
+        {
+            --region.queued;
+
+            // Tasks are still taken after a failure, so outstanding drops to zero and the caller wakes up
+            if (!region.isFailed)
+            {
+                try
+                {
+                    region.body(task);
+                }
+                catch (...)
+                {
+                    std::lock_guard<std::mutex> lock(region.mutex);
+
+                    if (!region.error)
+                        region.error = std::current_exception();
+
+                    region.isFailed = true;
+                }
+            }
+
+            ++stats.tasksRun;
+
+            if (--region.outstanding == 0u)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(region.mutex);
+                }
+
+                region.condition.notify_all();
+            }
+
+            continue;
+        }
+
+        const auto idleBegin = std::chrono::steady_clock::now();
+
+        {
+            std::unique_lock<std::mutex> lock(region.mutex);
+            region.condition.wait(lock, [&region] { return region.queued > 0u || region.outstanding == 0u; });
+        }
+
+        stats.idleSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - idleBegin).count();
+
+        if (region.outstanding == 0u)
+            break;
+    }
+
+    currentRegion = previousRegion;
+    currentQueue = previousQueue;
+}
+
+void ThreadPool::setupAffinity(ThreadAffinity affinity)
+{
+#ifdef __linux__
+    if (affinity == ThreadAffinity::None)
+        return;
+
+    const SizetVector availableCpus = getAvailableCpus();
+    if (availableCpus.empty())
+        return;
+
+    const size_t threadsNumber = m_workerCpus.size();
+
+    if (affinity == ThreadAffinity::Cores)
+    {
+        for (size_t index = 1u; index < threadsNumber; ++index)
+            m_workerCpus[index] = SizetVector(1u, availableCpus[index % availableCpus.size()]);
+    }
+    else
+    {
+        const VectorOfSizetVectors nodesCpus = getNumaNodesCpus(availableCpus);
+
+        for (size_t index = 1u; index < threadsNumber; ++index)
+            m_workerCpus[index] = nodesCpus[index * nodesCpus.size() / threadsNumber];
+    }
+#else
+    (void)affinity;
+#endif
+}
+
+} // namespace SPHSDK
@@ -0,0 +1,191 @@
+/**
+ * @file ThreadPool.h
+ * @author Anton Artyukh (artyukhanton@gmail.com)
+ * @date Created Oct 19, 2026
+ **/
+
+#ifndef THREAD_POOL_H_1E192112A6684D6EB9FF0C91552627B7
+#define THREAD_POOL_H_1E192112A6684D6EB9FF0C91552627B7
+
+#include "Defines.h"
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace SPHSDK
+{
+
+namespace TestEnvironment
+{
+class ThreadPoolTestSuite;
+} // namespace TestEnvironment
+
+enum class ThreadAffinity
+{
+    None,     // threads are not pinned
+    Cores,    // worker k is pinned to the k-th CPU available to the process
+    NumaNodes // workers are split into contiguous groups, one per NUMA node, pinned to the CPUs of their node
+};
+
+struct ThreadPoolOptions
+{
+    ThreadPoolOptions();
+
+    // The total number of threads including the calling one, 0 means hardware concurrency
+    size_t threadsNumber;
+
+    ThreadAffinity affinity;
+
+    // Iterations in one task of parallelForDynamic(), 0 means about 8 tasks per thread
+    size_t grainSize;
+};
+
+/**
+ * @brief Counters of one worker, accumulated since creation of the pool or resetWorkerStats().
+ */
+struct WorkerStats
+{
+    WorkerStats();
+
+    // Tasks and parallelFor() chunks executed by the worker
+    size_t tasksRun;
+
+    // Tasks taken from queues of other workers
+    size_t steals;
+
+    // Time spent inside runTasks() and parallelForDynamic() without a task to run
+    double idleSeconds;
+};
+
+/**
+ * @brief ThreadPool class keeps a fixed set of persistent worker threads.
+ * The calling thread takes part in every parallel loop as worker 0,
+ * so a pool of N threads spawns only N - 1 additional threads.
+ * The calling thread is never pinned, only the spawned workers follow ThreadPoolOptions::affinity.
+ *
+ * Besides static loops the pool schedules dynamic tasks: every worker owns a queue,
+ * takes its own tasks newest first and steals the oldest tasks of other workers when idle.
+ *
+ * Several threads may share one pool, their parallel calls take turns: a call from outside of the pool waits
+ * until the call of another thread is done, nested calls from inside of the running one do not wait.
+ */
+class ThreadPool
+{
+    friend class TestEnvironment::ThreadPoolTestSuite;
+
+public:
+    using RangeFunction = std::function<void(size_t begin, size_t end)>;
+
+    using TaskFunction = std::function<void(size_t task)>;
+
+    /**
+     * @brief Creates pool with given number of threads.
+     * @param threadsNumber    The total number of threads including the calling one, 0 means hardware concurrency
+     */
+    explicit ThreadPool(size_t threadsNumber = 0);
+
+    explicit ThreadPool(const ThreadPoolOptions& options);
+
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    size_t getThreadsNumber() const;
+
+    size_t getGrainSize() const;
+
+    void setGrainSize(size_t grainSize);
+
+    /**
+     * @brief Returns CPUs the worker is pinned to, empty if it is not pinned.
+     */
+    const SizetVector& getWorkerCpus(size_t workerIndex) const;
+
+    std::vector<WorkerStats> getWorkerStats() const;
+
+    void resetWorkerStats();
+
+    /**
+     * @brief Splits [begin, end) into one contiguous chunk per thread and waits for all of them.
+     * Chunk k is always executed by worker k, so repeated calls over the same range
+     * touch the same data from the same thread.
+     * Nested calls from inside a worker run serially on the calling thread.
+     */
+    void parallelFor(size_t begin, size_t end, const RangeFunction& body);
+
+    /**
+     * @brief Splits [begin, end) into tasks of the grain size and waits for all of them.
+     * Worker k starts with the tasks of chunk k of parallelFor(), then steals from the others,
+     * so uneven iterations are balanced.
+     */
+    void parallelForDynamic(size_t begin, size_t end, const RangeFunction& body);
+
+    /**
+     * @brief Runs body for every task and for every task spawned by it, waits for all of them.
+     * initialTasks are split into contiguous chunks like in parallelFor(), every worker
+     * starts from the front of its chunk.
+     * If a task throws, the tasks not started yet are skipped and the first exception is rethrown
+     * once all running tasks have finished.
+     */
+    void runTasks(const SizetVector& initialTasks, const TaskFunction& body);
+
+    /**
+     * @brief Queues one more task of the current runTasks() on the calling worker.
+     * Must be called from the body of runTasks() only, the newest task is run first.
+     */
+    void spawn(size_t task);
+
+    /**
+     * @brief Queues one more task of the current runTasks() on the given worker (modulo the threads number),
+     * which runs it unless an idle worker steals it first. Must be called from the body of runTasks() only.
+     */
+    void spawn(size_t task, size_t workerIndex);
+
+private:
+    struct TaskRegion;
+
+    // parallelFor() without accounting of statistics
+    void dispatch(size_t begin, size_t end, const RangeFunction& body);
+
+    void workerLoop(size_t workerIndex);
+
+    void runChunk(size_t workerIndex);
+
+    void runRegion(TaskRegion& region, size_t queueIndex);
+
+    void setupAffinity(ThreadAffinity affinity);
+
+private:
+    std::vector<std::thread> m_workers;
+
+    // Held by the outside thread whose call runs, recursive for nested calls of a pool without workers
+    std::recursive_mutex m_callerMutex;
+
+    std::mutex m_mutex;
+    std::condition_variable m_wakeCondition;
+    std::condition_variable m_doneCondition;
+
+    const RangeFunction* m_body;
+    size_t m_begin;
+    size_t m_end;
+
+    size_t m_generation;
+    size_t m_pendingWorkers;
+    bool m_stopping;
+
+    size_t m_grainSize;
+
+    VectorOfSizetVectors m_workerCpus;
+
+    // Written only by the owning worker or the calling thread holding m_callerMutex, read between parallel calls
+    std::vector<WorkerStats> m_stats;
+};
+
+} // namespace SPHSDK
+
+#endif // THREAD_POOL_H_1E192112A6684D6EB9FF0C91552627B7
@@ -0,0 +1,269 @@
+/**
+ * @file TriangleMesh.cpp
+ * @author Anton Artyukh (artyukhanton@gmail.com)
+ * @date Created Oct 19, 2026
+ **/
+
+#include "TriangleMesh.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <tuple>
+
+namespace SPHSDK
+{
+
+namespace
+{
+/**
+ * Welds corners of triangles into shared vertices.
+ * Every vertex is kept in the cell of the weld distance it falls into, a corner closer than that to a vertex
+ * along every axis is in the same or a neighbouring cell, so the 27 cells around the corner are searched.
+ */
+class VertexWelder
+{
+public:
+    VertexWelder(TriangleMesh& mesh, FLOAT weldDistance)
+        : m_mesh(mesh)
+        , m_weldDistance(weldDistance)
+    {
+    }
+
+    size_t add(const Point3F& point)
+    {
+        const Key key(quantize(point.x), quantize(point.y), quantize(point.z));
+
+        // The nearest of the vertices in reach, so the result does not depend on the order of the cells
+        size_t nearest = m_mesh.vertices.size();
+        FLOAT nearestDistance = m_weldDistance;
+
+        for (long long dx = -1; dx <= 1; ++dx)
+            for (long long dy = -1; dy <= 1; ++dy)
+                for (long long dz = -1; dz <= 1; ++dz)
+                {
+                    const auto found = m_indices.find(
+                        Key(std::get<0>(key) + dx, std::get<1>(key) + dy, std::get<2>(key) + dz));
+                    if (found == m_indices.end())
+                        continue;
+
+                    const Point3F difference = m_mesh.vertices[found->second] - point;
+                    const FLOAT distance =
+                        std::max({std::fabs(difference.x), std::fabs(difference.y), std::fabs(difference.z)});
+
+                    if (distance < nearestDistance)
+                    {
+                        nearest = found->second;
+                        nearestDistance = distance;
+                    }
+                }
+
+        if (nearest < m_mesh.vertices.size())
+            return nearest;
+
+        // No other vertex shares the cell, it would have been in reach
+        m_mesh.vertices.push_back(point);
+        m_indices.emplace(key, m_mesh.vertices.size() - 1u);
+
+        return m_mesh.vertices.size() - 1u;
+    }
+
+private:
+    using Key = std::tuple<long long, long long, long long>;
+
+    long long quantize(FLOAT value) const
+    {
+        return static_cast<long long>(std::floor(value / m_weldDistance));
+    }
+
+    TriangleMesh& m_mesh;
+    FLOAT m_weldDistance;
+    std::map<Key, size_t> m_indices;
+};
+
+// Returns index of the vertex referred by an OBJ face token "v", "v/vt", "v//vn" or "v/vt/vn" of the line
+size_t readObjIndex(const std::string& token, size_t verticesNumber, const std::string& line)
+{
+    const std::string vertex = token.substr(0u, token.find('/'));
+
+    char* end = nullptr;
+    errno = 0;
+    const long long index = std::strtoll(vertex.c_str(), &end, 10);
+    if (vertex.empty() || *end != '\0' || errno == ERANGE)
+        throw std::runtime_error("Invalid OBJ face: " + line);
+
+    // Negative indices count from the last vertex
+    const long long resolved = index < 0 ? static_cast<long long>(verticesNumber) + index : index - 1;
+    if (index == 0 || resolved < 0 || resolved >= static_cast<long long>(verticesNumber))
+        throw std::runtime_error("OBJ face refers to missing vertex " + token);
+
+    return static_cast<size_t>(resolved);
+}
+
+std::string toLower(std::string text)
+{
+    std::transform(text.begin(), text.end(), text.begin(),
+                   [](unsigned char symbol) { return static_cast<char>(std::tolower(symbol)); });
+    return text;
+}
+} // namespace
+
+TriangleMesh TriangleMesh::fromTriangleSoup(const Point3FVector& soup, FLOAT weldDistance)
+{
+    TriangleMesh mesh;
+    VertexWelder welder(mesh, weldDistance);
+
+    mesh.triangles.reserve(soup.size() / 3u);
+    for (size_t i = 0u; i + 2u < soup.size(); i += 3u)
+        mesh.triangles.push_back({welder.add(soup[i]), welder.add(soup[i + 1u]), welder.add(soup[i + 2u])});
+
+    return mesh;
+}
+
+TriangleMesh TriangleMesh::loadFromFile(const std::string& fileName)
+{
+    std::ifstream file(fileName, std::ios::binary);
+    if (!file)
+        throw std::runtime_error("Can not open mesh file " + fileName);
+
+    const size_t dot = fileName.rfind('.');
+    const std::string extension = dot == std::string::npos ? std::string() : toLower(fileName.substr(dot + 1u));
+
+    if (extension == "obj")
+        return loadObj(file);
+    if (extension == "stl")
+        return loadStl(file);
+
+    throw std::runtime_error("Unknown mesh file format " + fileName);
+}
+
+TriangleMesh TriangleMesh::loadObj(std::istream& stream)
+{
+    TriangleMesh mesh;
+
+    std::string line;
+    while (std::getline(stream, line))
+    {
+        std::istringstream tokens(line);
+
+        std::string type;
+        if (!(tokens >> type))
+            continue;
+
+        if (type == "v")
+        {
+            Point3F vertex;
+            if (!(tokens >> vertex.x >> vertex.y >> vertex.z))
+                throw std::runtime_error("Invalid OBJ vertex: " + line);
+
+            mesh.vertices.push_back(vertex);
+        }
+        else if (type == "f")
+        {
+            SizetVector polygon;
+
+            std::string token;
+            while (tokens >> token)
+                polygon.push_back(readObjIndex(token, mesh.vertices.size(), line));
+
+            for (size_t i = 2u; i < polygon.size(); ++i)
+                mesh.triangles.push_back({polygon[0], polygon[i - 1u], polygon[i]});
+        }
+    }
+
+    return mesh;
+}
+
+TriangleMesh TriangleMesh::loadStl(std::istream& stream)
+{
+    const std::string data((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+
+    TriangleMesh mesh;
+    VertexWelder welder(mesh, 1e-9);
+
+    // Binary STL: 80 bytes of header, the number of facets and 50 bytes per facet
+    uint32_t facetsNumber = 0u;
+    if (data.size() >= 84u)
+        std::memcpy(&facetsNumber, data.data() + 80u, sizeof(facetsNumber));
+
+    if (data.size() >= 84u && data.size() == 84u + 50u * static_cast<size_t>(facetsNumber))
+    {
+        mesh.triangles.reserve(facetsNumber);
+
+        for (size_t facet = 0u; facet < facetsNumber; ++facet)
+        {
+            // The normal is skipped, the corners follow it
+            const char* corners = data.data() + 84u + 50u * facet + 12u;
+
+            Triangle triangle;
+            for (size_t corner = 0u; corner < 3u; ++corner)
+            {
+                float coordinates[3];
+                std::memcpy(coordinates, corners + 12u * corner, sizeof(coordinates));
+
+                triangle[corner] = welder.add(Point3F(coordinates[0], coordinates[1], coordinates[2]));
+            }
+
+            mesh.triangles.push_back(triangle);
+        }
+
+        return mesh;
+    }
+
+    // ASCII STL, only the vertices of facets matter
+    std::istringstream tokens(data);
+    std::string token;
+
+    Triangle triangle;
+    size_t corner = 0u;
+
+    while (tokens >> token)
+    {
+        if (token != "vertex")
+            continue;
+
+        Point3F vertex;
+        if (!(tokens >> vertex.x >> vertex.y >> vertex.z))
+            throw std::runtime_error("Invalid STL vertex");
+
+        triangle[corner++] = welder.add(vertex);
+        if (corner == 3u)
+        {
+            mesh.triangles.push_back(triangle);
+            corner = 0u;
+        }
+    }
+
+    if (corner != 0u)
+        throw std::runtime_error("Truncated STL facet");
+
+    return mesh;
+}
+
+Cuboid TriangleMesh::getBoundingCuboid() const
+{
+    if (vertices.empty())
+        return Cuboid();
+
+    Point3F min = vertices.front();
+    Point3F max = vertices.front();
+
+    for (const Point3F& vertex : vertices)
+    {
+        min = Point3F(std::min(min.x, vertex.x), std::min(min.y, vertex.y), std::min(min.z, vertex.z));
+        max = Point3F(std::max(max.x, vertex.x), std::max(max.y, vertex.y), std::max(max.z, vertex.z));
+    }
+
+    return Cuboid(min, max.x - min.x, max.y - min.y, max.z - min.z);
+}
+
+} // namespace SPHSDK
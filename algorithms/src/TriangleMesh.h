@@ -0,0 +1,65 @@
+/**
+ * @file TriangleMesh.h
+ * @author Anton Artyukh (artyukhanton@gmail.com)
+ * @date Created Oct 19, 2026
+ **/
+
+#ifndef TRIANGLE_MESH_H_4DAEA46AF7474F4B9BF9CF8C783505C4
+#define TRIANGLE_MESH_H_4DAEA46AF7474F4B9BF9CF8C783505C4
+
+#include "Area.h"
+#include "Defines.h"
+#include "Point.h"
+
+#include <array>
+#include <istream>
+#include <string>
+#include <vector>
+
+namespace SPHSDK
+{
+
+/**
+ * @brief TriangleMesh struct keeps an indexed triangle mesh.
+ * Triangles are counter-clockwise when seen from outside, so their normals point outwards.
+ */
+struct TriangleMesh
+{
+    using Triangle = std::array<size_t, 3>;
+
+    /**
+     * @brief Builds mesh from triangle soup, every three points are one triangle,
+     * e.g. the result of MarchingCubes::generateMesh().
+     * @param soup          The corners of triangles
+     * @param weldDistance  Corners closer than that along every axis become one vertex
+     */
+    static TriangleMesh fromTriangleSoup(const Point3FVector& soup, FLOAT weldDistance = 1e-9);
+
+    /**
+     * @brief Reads mesh from Wavefront OBJ or STL file chosen by extension.
+     * @throw std::runtime_error if the file can not be read or has unknown extension
+     */
+    static TriangleMesh loadFromFile(const std::string& fileName);
+
+    /**
+     * @brief Reads vertices ("v") and faces ("f") of OBJ, polygons are split into fans of triangles.
+     * @throw std::runtime_error if a face refers to a missing vertex
+     */
+    static TriangleMesh loadObj(std::istream& stream);
+
+    /**
+     * @brief Reads ASCII or binary STL, equal corners of facets are welded.
+     * @throw std::runtime_error if an ASCII facet is truncated
+     */
+    static TriangleMesh loadStl(std::istream& stream);
+
+    Cuboid getBoundingCuboid() const;
+
+    Point3FVector vertices;
+
+    std::vector<Triangle> triangles;
+};
+
+} // namespace SPHSDK
+
+#endif // TRIANGLE_MESH_H_4DAEA46AF7474F4B9BF9CF8C783505C4
@@ -0,0 +1,82 @@
+/**
+ * @file BoundingVolumeHierarchyTestSuite.cpp
+ * @author Anton Artyukh (artyukhanton@gmail.com)
+ * @date Created Oct 19, 2026
+ **/
+
+#include "BoundingVolumeHierarchyTestSuite.h"
+
+#include "BoundingVolumeHierarchy.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+namespace SPHSDK
+{
+namespace TestEnvironment
+{
+
+void BoundingVolumeHierarchyTestSuite::queryMatchesBruteForce()
+{
+    // A 5 x 5 x 5 lattice of overlapping boxes
+    std::vector<Cuboid> bounds;
+    for (size_t k = 0u; k < 5u; ++k)
+        for (size_t j = 0u; j < 5u; ++j)
+            for (size_t i = 0u; i < 5u; ++i)
+                bounds.emplace_back(Point3F(0.5 * i, 0.5 * j, 0.5 * k), 0.7, 0.6, 0.8);
+
+    BoundingVolumeHierarchy hierarchy;
+    hierarchy.build(bounds);
+
+    ASSERT_EQ(bounds.size(), hierarchy.getItemsNumber());
+
+    for (const auto& leaf : hierarchy.m_nodes)
+        EXPECT_LE(leaf.count, BoundingVolumeHierarchy::LeafSize);
+
+    const Point3FVector points = {Point3F(0.1, 0.1, 0.1), Point3F(0.55, 1.05, 0.65), Point3F(2.5, 2.5, 2.5),
+                                  Point3F(1.3, 0.2, 2.9), Point3F(3.0, 3.0, 3.0), Point3F(-0.1, 1.0, 1.0)};
+
+    for (const Point3F& point : points)
+    {
+        SizetVector expected;
+        for (size_t i = 0u; i < bounds.size(); ++i)
+        {
+            const Cuboid& box = bounds[i];
+            if (point.x >= box.startingPoint.x && point.x <= box.startingPoint.x + box.width &&
+                point.y >= box.startingPoint.y && point.y <= box.startingPoint.y + box.length &&
+                point.z >= box.startingPoint.z && point.z <= box.startingPoint.z + box.height)
+                expected.push_back(i);
+        }
+
+        SizetVector found = hierarchy.query(point);
+        std::sort(found.begin(), found.end());
+
+        EXPECT_EQ(expected, found);
+    }
+}
+
+void BoundingVolumeHierarchyTestSuite::emptyHierarchyFindsNothing()
+{
+    BoundingVolumeHierarchy hierarchy;
+    EXPECT_TRUE(hierarchy.query(Point3F()).empty());
+
+    hierarchy.build(std::vector<Cuboid>());
+    EXPECT_EQ(0u, hierarchy.getItemsNumber());
+    EXPECT_TRUE(hierarchy.query(Point3F()).empty());
+}
+
+} // namespace TestEnvironment
+} // namespace SPHSDK
+
+using namespace SPHSDK::TestEnvironment;
+
+TEST(BoundingVolumeHierarchyTestSuite, queryMatchesBruteForce)
+{
+    BoundingVolumeHierarchyTestSuite::queryMatchesBruteForce();
+}
+
+TEST(BoundingVolumeHierarchyTestSuite, emptyHierarchyFindsNothing)
+{
+    BoundingVolumeHierarchyTestSuite::emptyHierarchyFindsNothing();
+}
@@ -0,0 +1,27 @@
+/**
+ * @file BoundingVolumeHierarchyTestSuite.h
+ * @author Anton Artyukh (artyukhanton@gmail.com)
+ * @date Created Oct 19, 2026
+ **/
+
+#ifndef BOUNDING_VOLUME_HIERARCHY_TEST_SUITE_H_2E1849CD9D51453A8B7B01439D9DCF2C
+#define BOUNDING_VOLUME_HIERARCHY_TEST_SUITE_H_2E1849CD9D51453A8B7B01439D9DCF2C
+
+namespace SPHSDK
+{
+
+namespace TestEnvironment
+{
+
+class BoundingVolumeHierarchyTestSuite
+{
+public:
+    static void queryMatchesBruteForce();
+
+    static void emptyHierarchyFindsNothing();
+};
+
+} // namespace TestEnvironment
+} // namespace SPHSDK
+
+#endif // BOUNDING_VOLUME_HIERARCHY_TEST_SUITE_H_2E1849CD9D51453A8B7B01439D9DCF2C
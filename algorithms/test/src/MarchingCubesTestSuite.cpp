@@ -9,10 +9,16 @@
 
 #include "MarchingCubes.h"
 #include "Shapes.h"
+#include "ThreadPool.h"
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
 #include <fstream>
+#include <stdexcept>
 
 
 // Generates Obj file in Wavefront format with mesh
@@ -45,6 +51,25 @@ namespace SPHSDK
 namespace TestEnvironment
 {
 
+// Triangles as their corners, sorted, so meshes built in different orders compare equal
+static std::vector<std::array<FLOAT, 9>> getSortedTriangles(const IndexedMesh& mesh)
+{
+    std::vector<std::array<FLOAT, 9>> triangles(mesh.getTrianglesNumber());
+
+    for (size_t triangle = 0u; triangle < triangles.size(); ++triangle)
+        for (size_t corner = 0u; corner < 3u; ++corner)
+        {
+            const Point3F& vertex = mesh.vertices[mesh.indices[3u * triangle + corner]];
+            triangles[triangle][3u * corner] = vertex.x;
+            triangles[triangle][3u * corner + 1u] = vertex.y;
+            triangles[triangle][3u * corner + 2u] = vertex.z;
+        }
+
+    std::sort(triangles.begin(), triangles.end());
+
+    return triangles;
+}
+
 void MarchingCubesTestSuite::generatePawnMesh()
 {
     const Point3FVector mesh = MarchingCubes::generateMesh(Shapes::Pawn);
@@ -63,6 +88,308 @@ void MarchingCubesTestSuite::generateBishopMesh()
     generateObjFile(mesh, "bishop.obj");
 }
 
+void MarchingCubesTestSuite::evaluatesEveryVertexOnce()
+{
+    std::atomic<size_t> evaluations(0u);
+
+    const auto countingPawn = [&evaluations](FLOAT x, FLOAT y, FLOAT z) {
+        ++evaluations;
+        return Shapes::Pawn(x, y, z);
+    };
+
+    ThreadPool pool(4);
+    const Point3FVector mesh = MarchingCubes::generateMesh(countingPawn, &pool);
+
+    // 100 cells along every axis, vertex i is at i * cellSize, so the last one lands on the bounds
+    EXPECT_EQ(101u * 101u * 101u, evaluations.load());
+    EXPECT_EQ(MarchingCubes::generateMesh(Shapes::Pawn), mesh);
+}
+
+void MarchingCubesTestSuite::indexedMeshSharesVertices()
+{
+    const Point3FVector soup = MarchingCubes::generateMesh(Shapes::Pawn);
+
+    IndexedMesh mesh;
+    MarchingCubes::generateMesh(Shapes::Pawn, mesh);
+
+    ASSERT_EQ(soup.size(), mesh.indices.size());
+    EXPECT_EQ(soup.size() / 3u, mesh.getTrianglesNumber());
+
+    // Every vertex is shared by about six triangles
+    EXPECT_LT(4u * mesh.vertices.size(), soup.size());
+
+    for (size_t i = 0u; i < soup.size(); ++i)
+    {
+        ASSERT_LT(mesh.indices[i], mesh.vertices.size());
+        EXPECT_NEAR(0.0, (soup[i] - mesh.vertices[mesh.indices[i]]).calcNorm(), 1e-12);
+    }
+
+    // The same mesh from slabs of several threads, the buffers are reused
+    const IndexedMesh serialMesh = mesh;
+    const Point3F* vertices = mesh.vertices.data();
+    const uint32_t* indices = mesh.indices.data();
+
+    ThreadPool pool(3);
+    MarchingCubes::generateMesh(Shapes::Pawn, mesh, &pool);
+
+    EXPECT_EQ(serialMesh.vertices, mesh.vertices);
+    EXPECT_EQ(serialMesh.indices, mesh.indices);
+    EXPECT_EQ(vertices, mesh.vertices.data());
+    EXPECT_EQ(indices, mesh.indices.data());
+}
+
+void MarchingCubesTestSuite::moreThreadsThanSlabs()
+{
+    const auto ball = [](FLOAT x, FLOAT y, FLOAT z) {
+        return 0.16 - (Point3F(x, y, z) - Point3F(0.5, 0.5, 0.5)).calcNormSqr();
+    };
+
+    // Five slabs, so some threads get no slabs and the planes between ranges are shared across them
+    const Cuboid bounds(Point3F(0.0, 0.0, 0.0), 1.0, 1.0, 1.0);
+
+    IndexedMesh serialMesh;
+    MarchingCubes::generateMesh(ball, bounds, 0.2, serialMesh);
+
+    ThreadPool pool(8);
+    IndexedMesh mesh;
+    MarchingCubes::generateMesh(ball, bounds, 0.2, mesh, &pool);
+
+    ASSERT_FALSE(serialMesh.indices.empty());
+    EXPECT_EQ(serialMesh.vertices, mesh.vertices);
+    EXPECT_EQ(serialMesh.indices, mesh.indices);
+}
+
+void MarchingCubesTestSuite::meshesGivenBounds()
+{
+    const Point3F center(0.5, 0.5, 0.5);
+    const auto ball = [&center](FLOAT x, FLOAT y, FLOAT z) {
+        return 0.01 - (Point3F(x, y, z) - center).calcNormSqr();
+    };
+
+    // A small ball in fine cells of its own bounds
+    IndexedMesh fineMesh;
+    MarchingCubes::generateMesh(ball, Cuboid(Point3F(0.35, 0.35, 0.35), 0.3, 0.3, 0.3), 0.005, fineMesh);
+
+    // The same ball in coarse cells of a larger domain
+    IndexedMesh coarseMesh;
+    MarchingCubes::generateMesh(ball, Cuboid(Point3F(-1.0, -1.0, -1.0), 3.0, 3.0, 3.0), 0.05, coarseMesh);
+
+    ASSERT_FALSE(fineMesh.vertices.empty());
+    ASSERT_FALSE(coarseMesh.vertices.empty());
+    EXPECT_GT(fineMesh.getTrianglesNumber(), 10u * coarseMesh.getTrianglesNumber());
+
+    FLOAT fineError = 0.0;
+    for (const Point3F& vertex : fineMesh.vertices)
+        fineError = std::max(fineError, std::abs((vertex - center).calcNorm() - 0.1));
+
+    FLOAT coarseError = 0.0;
+    for (const Point3F& vertex : coarseMesh.vertices)
+        coarseError = std::max(coarseError, std::abs((vertex - center).calcNorm() - 0.1));
+
+    EXPECT_LT(fineError, 2e-4);
+    EXPECT_LT(fineError, coarseError);
+
+    EXPECT_THROW(MarchingCubes::generateMesh(ball, Cuboid(center, 0.1, 0.1, 0.1), 0.0), std::invalid_argument);
+}
+
+void MarchingCubesTestSuite::adaptiveMeshMatchesUniform()
+{
+    const Point3F center(0.5, 0.5, 0.5);
+    size_t evaluations = 0u;
+
+    const auto ball = [&center, &evaluations](FLOAT x, FLOAT y, FLOAT z) {
+        ++evaluations;
+        return 0.1 - (Point3F(x, y, z) - center).calcNorm();
+    };
+
+    const Cuboid bounds(Point3F(-1.0, -1.0, -1.0), 3.0, 3.0, 3.0);
+
+    IndexedMesh uniformMesh;
+    MarchingCubes::generateMesh(ball, bounds, 0.02, uniformMesh);
+    const size_t uniformEvaluations = evaluations;
+
+    // The distance to the sphere has |grad f| = 1
+    evaluations = 0u;
+    IndexedMesh adaptiveMesh;
+    MarchingCubes::generateAdaptiveMesh(ball, bounds, 0.02, 1.0, adaptiveMesh);
+
+    ASSERT_FALSE(uniformMesh.indices.empty());
+    EXPECT_EQ(uniformMesh.vertices, adaptiveMesh.vertices);
+    EXPECT_EQ(uniformMesh.indices, adaptiveMesh.indices);
+    EXPECT_LT(100u * evaluations, uniformEvaluations);
+}
+
+void MarchingCubesTestSuite::incrementalMeshRemeshesChangedBlocks()
+{
+    const Point3F center(0.5, 0.5, 0.5);
+    const auto ball = [&center](FLOAT x, FLOAT y, FLOAT z) { return 0.3 - (Point3F(x, y, z) - center).calcNorm(); };
+
+    // 40 cells along every axis, 5 blocks of 8 cells
+    const Cuboid bounds(Point3F(), 1.0, 1.0, 1.0);
+    IncrementalMarchingCubes incremental(bounds, 0.025, 8u);
+    ASSERT_EQ(125u, incremental.getBlocksNumber());
+
+    IndexedMesh mesh;
+    IndexedMesh uniformMesh;
+
+    EXPECT_EQ(125u, incremental.update(ball).size());
+    incremental.gatherMesh(mesh);
+    MarchingCubes::generateMesh(ball, bounds, 0.025, uniformMesh);
+
+    ASSERT_FALSE(uniformMesh.indices.empty());
+    EXPECT_EQ(uniformMesh.vertices.size(), mesh.vertices.size());
+    EXPECT_EQ(getSortedTriangles(uniformMesh), getSortedTriangles(mesh));
+
+    EXPECT_TRUE(incremental.update(ball).empty());
+
+    // A bump within 0.06 of the top of the ball, on the face between two blocks along z
+    const Point3F bumpCenter(0.5, 0.5, 0.8);
+    const auto bumpedBall = [&ball, &bumpCenter](FLOAT x, FLOAT y, FLOAT z) {
+        return ball(x, y, z) + 20.0 * std::max(0.0, 0.0036 - (Point3F(x, y, z) - bumpCenter).calcNormSqr());
+    };
+
+    ThreadPool pool(3);
+    const SizetVector updatedBlocks = incremental.update(bumpedBall, &pool);
+
+    EXPECT_EQ(SizetVector({(2u * 5u + 2u) * 5u + 3u, (2u * 5u + 2u) * 5u + 4u}), updatedBlocks);
+
+    incremental.gatherMesh(mesh);
+    MarchingCubes::generateMesh(bumpedBall, bounds, 0.025, uniformMesh);
+    EXPECT_EQ(getSortedTriangles(uniformMesh), getSortedTriangles(mesh));
+
+    // Changes within the tolerance keeping the signs are not remeshed
+    IncrementalMarchingCubes tolerant(bounds, 0.025, 8u, 0.01);
+    tolerant.update(ball);
+
+    const auto scaledBall = [&ball](FLOAT x, FLOAT y, FLOAT z) { return 1.01 * ball(x, y, z); };
+    EXPECT_TRUE(tolerant.update(scaledBall).empty());
+
+    EXPECT_THROW(IncrementalMarchingCubes(bounds, 0.025, 0u), std::invalid_argument);
+}
+
+void MarchingCubesTestSuite::shadedMeshHasOutwardNormals()
+{
+    const Point3F center(0.5, 0.5, 0.5);
+    std::atomic<size_t> evaluations(0u);
+
+    const auto ball = [&center, &evaluations](FLOAT x, FLOAT y, FLOAT z) {
+        ++evaluations;
+        return 0.3 - (Point3F(x, y, z) - center).calcNorm();
+    };
+    const auto ballGradient = [&center](FLOAT x, FLOAT y, FLOAT z) {
+        const Point3F offset = Point3F(x, y, z) - center;
+        return offset * (-1.0 / offset.calcNorm());
+    };
+
+    const Cuboid bounds(Point3F(), 1.0, 1.0, 1.0);
+
+    IndexedMesh mesh;
+    MarchingCubes::generateMesh(ball, bounds, 0.025, mesh);
+    const size_t meshEvaluations = evaluations.load();
+
+    // Normals from the cached values cost no evaluations
+    evaluations = 0u;
+    ThreadPool pool(3);
+    ShadedMesh shadedMesh;
+    MarchingCubes::generateMesh(ball, bounds, 0.025, shadedMesh, &pool);
+    EXPECT_EQ(meshEvaluations, evaluations.load());
+
+    ASSERT_EQ(mesh.vertices.size(), shadedMesh.vertices.size());
+    EXPECT_EQ(mesh.indices, shadedMesh.indices);
+
+    for (size_t i = 0u; i < mesh.vertices.size(); ++i)
+    {
+        const MeshVertex& vertex = shadedMesh.vertices[i];
+        const Point3F radial = (vertex.position - center) * (1.0 / (vertex.position - center).calcNorm());
+
+        EXPECT_EQ(mesh.vertices[i], vertex.position);
+        EXPECT_NEAR(1.0, vertex.normal.calcNorm(), 1e-12);
+        EXPECT_GT(vertex.normal.x * radial.x + vertex.normal.y * radial.y + vertex.normal.z * radial.z, 0.99);
+    }
+
+    MarchingCubes::generateMesh(ball, ballGradient, bounds, 0.025, shadedMesh);
+
+    ASSERT_EQ(mesh.vertices.size(), shadedMesh.vertices.size());
+    EXPECT_EQ(mesh.indices, shadedMesh.indices);
+
+    for (const MeshVertex& vertex : shadedMesh.vertices)
+    {
+        const Point3F radial = (vertex.position - center) * (1.0 / (vertex.position - center).calcNorm());
+        EXPECT_NEAR(0.0, (vertex.normal - radial).calcNorm(), 1e-12);
+    }
+}
+
+void MarchingCubesTestSuite::templatedFieldsMatchStdFunction()
+{
+    const std::function<FLOAT(FLOAT, FLOAT, FLOAT)> pawn = Shapes::Pawn;
+    const Point3FVector soup = MarchingCubes::generateMesh(pawn);
+
+    const auto batchedPawn = [](const FLOAT* xs, const FLOAT* ys, const FLOAT* zs, FLOAT* out, size_t n) {
+        for (size_t i = 0u; i < n; ++i)
+            out[i] = Shapes::Pawn(xs[i], ys[i], zs[i]);
+    };
+
+    ThreadPool pool(3);
+
+    EXPECT_EQ(soup, MarchingCubes::generateMesh(Shapes::Pawn));
+    EXPECT_EQ(soup, MarchingCubes::generateMesh(batchedPawn, &pool));
+
+    IndexedMesh mesh;
+    IndexedMesh batchedMesh;
+    MarchingCubes::generateMesh(pawn, mesh);
+    MarchingCubes::generateMesh(batchedPawn, batchedMesh, &pool);
+
+    EXPECT_EQ(mesh.vertices, batchedMesh.vertices);
+    EXPECT_EQ(mesh.indices, batchedMesh.indices);
+
+    // 5 x 5 rows of 5 vertices along z
+    size_t rows = 0u;
+    const auto batchedBall = [&rows](const FLOAT* xs, const FLOAT* ys, const FLOAT* zs, FLOAT* out, size_t n) {
+        ++rows;
+        EXPECT_EQ(5u, n);
+
+        for (size_t i = 0u; i < n; ++i)
+        {
+            EXPECT_DOUBLE_EQ(xs[0], xs[i]);
+            EXPECT_DOUBLE_EQ(ys[0], ys[i]);
+            out[i] = 0.3 - (Point3F(xs[i], ys[i], zs[i]) - Point3F(0.5, 0.5, 0.5)).calcNorm();
+        }
+    };
+
+    MarchingCubes::generateMesh(batchedBall, Cuboid(Point3F(), 1.0, 1.0, 1.0), 0.25, batchedMesh);
+    EXPECT_EQ(25u, rows);
+    EXPECT_FALSE(batchedMesh.indices.empty());
+}
+
+void MarchingCubesTestSuite::batchedShapesMatchScalar()
+{
+    // An odd number of points, so the last ones are evaluated one by one
+    const size_t n = 1001u;
+    std::vector<FLOAT> xs(n);
+    std::vector<FLOAT> ys(n);
+    std::vector<FLOAT> zs(n);
+
+    for (size_t i = 0u; i < n; ++i)
+    {
+        xs[i] = 1.0 + 0.001 * static_cast<FLOAT>(i);
+        ys[i] = 1.5 + 0.3 * std::sin(0.1 * static_cast<FLOAT>(i));
+        zs[i] = 1.4 * static_cast<FLOAT>(n - i) / n;
+    }
+
+    std::vector<FLOAT> pawns(n);
+    std::vector<FLOAT> bishops(n);
+    Shapes::PawnBatch(xs.data(), ys.data(), zs.data(), pawns.data(), n);
+    Shapes::BishopBatch(xs.data(), ys.data(), zs.data(), bishops.data(), n);
+
+    for (size_t i = 0u; i < n; ++i)
+    {
+        EXPECT_DOUBLE_EQ(Shapes::Pawn(xs[i], ys[i], zs[i]), pawns[i]);
+        EXPECT_DOUBLE_EQ(Shapes::Bishop(xs[i], ys[i], zs[i]), bishops[i]);
+    }
+
+    EXPECT_EQ(MarchingCubes::generateMesh(Shapes::Pawn).size(), MarchingCubes::generateMesh(Shapes::PawnBatch).size());
+}
+
 } // namespace TestEnvironment
 } // namespace SPHSDK
 
@@ -77,3 +404,48 @@ TEST(MarchingCubesTestSuite, generateBishopMesh)
 {
     MarchingCubesTestSuite::generateBishopMesh();
 }
+
+TEST(MarchingCubesTestSuite, evaluatesEveryVertexOnce)
+{
+    MarchingCubesTestSuite::evaluatesEveryVertexOnce();
+}
+
+TEST(MarchingCubesTestSuite, indexedMeshSharesVertices)
+{
+    MarchingCubesTestSuite::indexedMeshSharesVertices();
+}
+
+TEST(MarchingCubesTestSuite, moreThreadsThanSlabs)
+{
+    MarchingCubesTestSuite::moreThreadsThanSlabs();
+}
+
+TEST(MarchingCubesTestSuite, meshesGivenBounds)
+{
+    MarchingCubesTestSuite::meshesGivenBounds();
+}
+
+TEST(MarchingCubesTestSuite, adaptiveMeshMatchesUniform)
+{
+    MarchingCubesTestSuite::adaptiveMeshMatchesUniform();
+}
+
+TEST(MarchingCubesTestSuite, incrementalMeshRemeshesChangedBlocks)
+{
+    MarchingCubesTestSuite::incrementalMeshRemeshesChangedBlocks();
+}
+
+TEST(MarchingCubesTestSuite, shadedMeshHasOutwardNormals)
+{
+    MarchingCubesTestSuite::shadedMeshHasOutwardNormals();
+}
+
+TEST(MarchingCubesTestSuite, templatedFieldsMatchStdFunction)
+{
+    MarchingCubesTestSuite::templatedFieldsMatchStdFunction();
+}
+
+TEST(MarchingCubesTestSuite, batchedShapesMatchScalar)
+{
+    MarchingCubesTestSuite::batchedShapesMatchScalar();
+}
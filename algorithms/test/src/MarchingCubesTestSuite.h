@@ -20,6 +20,24 @@ public:
     static void generatePawnMesh();
 
     static void generateBishopMesh();
+
+    static void evaluatesEveryVertexOnce();
+
+    static void indexedMeshSharesVertices();
+
+    static void moreThreadsThanSlabs();
+
+    static void meshesGivenBounds();
+
+    static void adaptiveMeshMatchesUniform();
+
+    static void incrementalMeshRemeshesChangedBlocks();
+
+    static void shadedMeshHasOutwardNormals();
+
+    static void templatedFieldsMatchStdFunction();
+
+    static void batchedShapesMatchScalar();
 };
 
 } // namespace TestEnvironment
@@ -0,0 +1,129 @@
+/**
+ * @file MeshBoundaryTestSuite.cpp
+ * @author Anton Artyukh (artyukhanton@gmail.com)
+ * @date Created Oct 19, 2026
+ **/
+
+#include "MeshBoundaryTestSuite.h"
+
+#include "MeshBoundary.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+namespace SPHSDK
+{
+namespace TestEnvironment
+{
+
+namespace
+{
+// Unit cube with faces oriented outwards
+TriangleMesh makeCube()
+{
+    std::istringstream stream("v 0 0 0\nv 1 0 0\nv 1 1 0\nv 0 1 0\n"
+                              "v 0 0 1\nv 1 0 1\nv 1 1 1\nv 0 1 1\n"
+                              "f 1 4 3 2\nf 5 6 7 8\nf 1 2 6 5\nf 4 8 7 3\nf 1 5 8 4\nf 2 3 7 6\n");
+
+    return TriangleMesh::loadObj(stream);
+}
+} // namespace
+
+void MeshBoundaryTestSuite::distanceToCube()
+{
+    const auto distance = MeshBoundary::makeDistanceFunction(makeCube(), 0.3);
+
+    // Inside, near a face, an edge and a corner
+    EXPECT_NEAR(0.1, distance(0.5, 0.5, 0.9), 1e-12);
+    EXPECT_NEAR(0.05, distance(0.95, 0.95, 0.5), 1e-12);
+
+    // Outside, near a face, an edge and a corner
+    EXPECT_NEAR(-0.1, distance(1.1, 0.5, 0.5), 1e-12);
+    EXPECT_NEAR(-std::sqrt(0.02), distance(1.1, 1.1, 0.5), 1e-12);
+    EXPECT_NEAR(-std::sqrt(0.03), distance(-0.1, -0.1, -0.1), 1e-12);
+
+    // Far from the surface only the side is known
+    EXPECT_DOUBLE_EQ(0.3, distance(0.5, 0.5, 0.5));
+    EXPECT_DOUBLE_EQ(-0.3, distance(0.5, 0.5, 1.9));
+    EXPECT_DOUBLE_EQ(-0.3, distance(3.0, 3.0, 3.0));
+}
+
+void MeshBoundaryTestSuite::bakedFieldMatchesDistance()
+{
+    const SignedDistanceField field = MeshBoundary::bake(makeCube(), 0.05, 0.15);
+
+    EXPECT_NEAR(0.1, field.getDistance(Point3F(0.5, 0.5, 0.9)), 1e-3);
+    EXPECT_NEAR(-0.1, field.getDistance(Point3F(1.1, 0.5, 0.5)), 1e-3);
+    EXPECT_NEAR(0.15, field.getDistance(Point3F(0.5, 0.5, 0.5)), 1e-9);
+
+    FLOAT distance = 0.0;
+    Point3F gradient;
+
+    // The gradient points into the cube
+    ASSERT_TRUE(field.sample(Point3F(0.5, 0.98, 0.5), distance, gradient));
+    EXPECT_NEAR(0.02, distance, 1e-3);
+    EXPECT_NEAR(-1.0, gradient.y, 1e-2);
+}
+
+void MeshBoundaryTestSuite::cachedFieldIsReused()
+{
+    const std::string cacheFile = "MeshBoundaryTestSuite.sdf";
+    std::remove(cacheFile.c_str());
+
+    const TriangleMesh cube = makeCube();
+    const SignedDistanceField baked = MeshBoundary::bake(cube, 0.05, 0.15, cacheFile);
+
+    // Replace the cached field by the field of a bigger cube keeping the key of the unit one
+    uint64_t key = 0u;
+    {
+        std::ifstream cache(cacheFile, std::ios::binary);
+        ASSERT_TRUE(cache.read(reinterpret_cast<char*>(&key), sizeof(key)));
+    }
+
+    TriangleMesh biggerCube = cube;
+    for (Point3F& vertex : biggerCube.vertices)
+        vertex = vertex * 2.0;
+
+    {
+        std::ofstream cache(cacheFile, std::ios::binary | std::ios::trunc);
+        cache.write(reinterpret_cast<const char*>(&key), sizeof(key));
+        MeshBoundary::bake(biggerCube, 0.05, 0.15).save(cache);
+    }
+
+    const Point3F point(1.1, 0.5, 0.5);
+
+    const SignedDistanceField cached = MeshBoundary::bake(cube, 0.05, 0.15, cacheFile);
+    EXPECT_GT(cached.getDistance(point), 0.0);
+
+    // Other parameters do not match the key, so the field is baked again
+    const SignedDistanceField rebaked = MeshBoundary::bake(cube, 0.04, 0.15, cacheFile);
+    EXPECT_NEAR(baked.getDistance(point), rebaked.getDistance(point), 1e-3);
+    EXPECT_LT(rebaked.getDistance(point), 0.0);
+
+    std::remove(cacheFile.c_str());
+}
+
+} // namespace TestEnvironment
+} // namespace SPHSDK
+
+using namespace SPHSDK::TestEnvironment;
+
+TEST(MeshBoundaryTestSuite, distanceToCube)
+{
+    MeshBoundaryTestSuite::distanceToCube();
+}
+
+TEST(MeshBoundaryTestSuite, bakedFieldMatchesDistance)
+{
+    MeshBoundaryTestSuite::bakedFieldMatchesDistance();
+}
+
+TEST(MeshBoundaryTestSuite, cachedFieldIsReused)
+{
+    MeshBoundaryTestSuite::cachedFieldIsReused();
+}
@@ -0,0 +1,29 @@
+/**
+ * @file MeshBoundaryTestSuite.h
+ * @author Anton Artyukh (artyukhanton@gmail.com)
+ * @date Created Oct 19, 2026
+ **/
+
+#ifndef MESH_BOUNDARY_TEST_SUITE_H_B316D8C056E048268CE1691424F7C6BB
+#define MESH_BOUNDARY_TEST_SUITE_H_B316D8C056E048268CE1691424F7C6BB
+
+namespace SPHSDK
+{
+
+namespace TestEnvironment
+{
+
+class MeshBoundaryTestSuite
+{
+public:
+    static void distanceToCube();
+
+    static void bakedFieldMatchesDistance();
+
+    static void cachedFieldIsReused();
+};
+
+} // namespace TestEnvironment
+} // namespace SPHSDK
+
+#endif // MESH_BOUNDARY_TEST_SUITE_H_B316D8C056E048268CE1691424F7C6BB
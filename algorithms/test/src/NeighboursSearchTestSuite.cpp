@@ -12,6 +12,9 @@
 #include "Area.h"
 #include "NeighboursSearch.h"
 
+#include <algorithm>
+#include <cmath>
+#include <random>
 #include <stdexcept>
 
 #include <gtest/gtest.h>
@@ -1125,6 +1128,42 @@ void NeighboursSearchTestSuite::findNearbyBoxesThreeByThree()
         EXPECT_EQ(expectedNearbyBoxes[i], ns.m_nearbyBoxes[i]);
 }
 
+void NeighboursSearchTestSuite::searchPeriodic3D()
+{
+    const Volume volume(Cuboid(Point3F(-1.0, 0.0, 0.0), 2.0, 1.0, 1.0), {true, true, false});
+    const FLOAT radius = 0.3;
+
+    std::mt19937 generator(11u);
+    std::uniform_real_distribution<FLOAT> coordinate(0.0, 1.0);
+
+    TestPoints3D points;
+    for (size_t i = 0u; i < 300u; ++i)
+        points.emplace_back(Point3F(-1.0 + 2.0 * coordinate(generator), coordinate(generator), coordinate(generator)));
+
+    NeighboursSearch3D<TestPoints3D> ns(volume, radius, 0.001);
+    ns.search(points);
+
+    // Brute force with the minimum image along x and y
+    for (size_t i = 0u; i < points.size(); ++i)
+    {
+        SizetVector expected;
+        for (size_t j = 0u; j < points.size(); ++j)
+        {
+            Point3F difference = points[j].position - points[i].position;
+            difference.x -= 2.0 * std::round(difference.x / 2.0);
+            difference.y -= std::round(difference.y);
+
+            if (j != i && difference.calcNorm() < radius)
+                expected.push_back(j);
+        }
+
+        SizetVector actual = points[i].neighbours;
+        std::sort(actual.begin(), actual.end());
+
+        EXPECT_EQ(expected, actual);
+    }
+}
+
 } // namespace TestEnvironment
 } // namespace SPHSDK
 
@@ -1185,6 +1224,33 @@ TEST(NeighboursSearchTestSuite, searchInCornerOfBoxesCorners)
     NeighboursSearchTestSuite::searchInCornerOfBoxesCorners();
 }
 
+void NeighboursSearchTestSuite::searchShortNeighbours3D()
+{
+    TestPoints3D points = { Point3F(0.75, 0.25, 0.75),
+                            Point3F(0.45, 0.25, 0.75),
+                            Point3F(0.75, 0.25, 0.45),
+                            Point3F(1.05, 0.25, 0.75),
+                            Point3F(0.75, 0.25, 1.05),
+                            Point3F(0.75, 0.75, 0.75) };
+
+    const Volume volume(Cuboid(Point3F(0., 0., 0.), 1.5, 1.5, 1.5));
+    NeighboursSearch3D<TestPoints3D> ns(volume, 0.5, 0.001);
+
+    VectorOfSizetVectors shortNeighbours(points.size(), SizetVector(1u, 100u));
+
+    ns.insertPoints(points);
+    for (size_t boxIndex = 0u; boxIndex < ns.getBoxesNumber(); ++boxIndex)
+        ns.searchInBox(points, boxIndex, 0.35, shortNeighbours);
+
+    for (auto& neighbours : shortNeighbours)
+        std::sort(neighbours.begin(), neighbours.end());
+
+    EXPECT_EQ(VectorOfSizetVectors({ {1, 2, 3, 4}, {0}, {0}, {0}, {0}, {} }), shortNeighbours);
+
+    std::sort(points[0].neighbours.begin(), points[0].neighbours.end());
+    EXPECT_EQ(SizetVector({1, 2, 3, 4, 5}), points[0].neighbours);
+}
+
 //-------------------------------------------------
 
 TEST(NeighboursSearchTestSuite, searchInOneBox3D)
@@ -1202,6 +1268,11 @@ TEST(NeighboursSearchTestSuite, searchInDifferentBoxesCenterMiddle3D)
     NeighboursSearchTestSuite::searchInDifferentBoxesCenterMiddle3D();
 }
 
+TEST(NeighboursSearchTestSuite, searchShortNeighbours3D)
+{
+    NeighboursSearchTestSuite::searchShortNeighbours3D();
+}
+
 //-------------------------------------------------
 
 TEST(NeighboursSearchTestSuite, insertPointsIntoBoxesCornerPoints)
@@ -1338,3 +1409,8 @@ TEST(NeighboursSearchTestSuite, findNearbyBoxesThreeByThree)
 {
     NeighboursSearchTestSuite::findNearbyBoxesThreeByThree();
 }
+
+TEST(NeighboursSearchTestSuite, searchPeriodic3D)
+{
+    NeighboursSearchTestSuite::searchPeriodic3D();
+}
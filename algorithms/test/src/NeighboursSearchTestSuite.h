@@ -58,6 +58,8 @@ public:
 
     static void searchInDifferentBoxesCenterMiddle3D();
 
+    static void searchShortNeighbours3D();
+
     /// NeighboursSearch::insertPointsIntoBoxes() tests
     static void insertPointsIntoBoxesCornerPoints();
 
@@ -114,6 +116,8 @@ public:
 
     static void findNearbyBoxesThreeByThree();
 
+    static void searchPeriodic3D();
+
 private:
 
     struct TestPoint
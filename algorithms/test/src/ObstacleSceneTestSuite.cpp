@@ -0,0 +1,120 @@
+/**
+ * @file ObstacleSceneTestSuite.cpp
+ * @author Anton Artyukh (artyukhanton@gmail.com)
+ * @date Created Oct 19, 2026
+ **/
+
+#include "ObstacleSceneTestSuite.h"
+
+#include "ObstacleScene.h"
+#include "ThreadPool.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cmath>
+
+namespace SPHSDK
+{
+namespace TestEnvironment
+{
+
+namespace
+{
+// Ball of radius 0.25 centred at (0.5, 0.5, 0.5)
+FLOAT ball(FLOAT x, FLOAT y, FLOAT z)
+{
+    return 0.0625 - (x - 0.5) * (x - 0.5) - (y - 0.5) * (y - 0.5) - (z - 0.5) * (z - 0.5);
+}
+} // namespace
+
+void ObstacleSceneTestSuite::samplesNearestObstacle()
+{
+    ObstacleScene scene;
+    EXPECT_EQ(0u, scene.addShape(ball, Cuboid(Point3F(0.25, 0.25, 0.25), 0.5, 0.5, 0.5), 0.02, 0.08));
+    EXPECT_EQ(1u, scene.addBox(Cuboid(Point3F(2.0, 2.0, 0.0), 0.5, 0.5, 1.0), 0.02, 0.08));
+    ASSERT_EQ(2u, scene.getObstaclesNumber());
+
+    FLOAT distance = 0.0;
+    Point3F gradient;
+
+    // Just inside of the ball
+    ASSERT_TRUE(scene.sample(Point3F(0.5, 0.5, 0.27), distance, gradient));
+    EXPECT_NEAR(0.02, distance, 2e-3);
+    EXPECT_GT(gradient.z, 0.9);
+
+    // Just outside of the top face of the box
+    ASSERT_TRUE(scene.sample(Point3F(2.25, 2.25, 1.03), distance, gradient));
+    EXPECT_LT(distance, 0.0);
+    EXPECT_LT(gradient.z, -0.9);
+
+    // Inside the box near its side
+    ASSERT_TRUE(scene.sample(Point3F(2.01, 2.25, 0.5), distance, gradient));
+    EXPECT_GT(distance, 0.0);
+    EXPECT_GT(gradient.x, 0.9);
+}
+
+void ObstacleSceneTestSuite::pointOutsideAllBoundsIsNotSampled()
+{
+    ObstacleScene scene;
+
+    FLOAT distance = 0.0;
+    Point3F gradient(1.0, 0.0, 0.0);
+
+    EXPECT_FALSE(scene.sample(Point3F(0.5, 0.5, 0.5), distance, gradient));
+    EXPECT_TRUE(std::isinf(distance));
+    EXPECT_LT(distance, 0.0);
+
+    scene.addShape(ball, Cuboid(Point3F(0.25, 0.25, 0.25), 0.5, 0.5, 0.5), 0.02, 0.08);
+
+    EXPECT_FALSE(scene.sample(Point3F(1.5, 0.5, 0.5), distance, gradient));
+    EXPECT_TRUE(std::isinf(distance));
+    EXPECT_DOUBLE_EQ(0.0, gradient.calcNormSqr());
+}
+
+void ObstacleSceneTestSuite::concurrentFirstQueriesSeeAllObstacles()
+{
+    // A row of unit boxes along x, the hierarchy is built by the first of the queries running at once
+    const size_t boxesNumber = 64u;
+
+    ObstacleScene scene;
+    for (size_t i = 0u; i < boxesNumber; ++i)
+        scene.addBox(Cuboid(Point3F(2.0 * static_cast<FLOAT>(i), 0.0, 0.0), 1.0, 1.0, 1.0), 0.25, 0.5);
+
+    ThreadPool pool(4u);
+    std::atomic<size_t> insideNumber(0u);
+
+    pool.parallelFor(0u, boxesNumber, [&scene, &insideNumber](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            FLOAT distance = 0.0;
+            Point3F gradient;
+
+            if (scene.sample(Point3F(2.0 * static_cast<FLOAT>(i) + 0.5, 0.5, 0.5), distance, gradient) &&
+                distance > 0.0)
+                ++insideNumber;
+        }
+    });
+
+    EXPECT_EQ(boxesNumber, insideNumber.load());
+}
+
+} // namespace TestEnvironment
+} // namespace SPHSDK
+
+using namespace SPHSDK::TestEnvironment;
+
+TEST(ObstacleSceneTestSuite, samplesNearestObstacle)
+{
+    ObstacleSceneTestSuite::samplesNearestObstacle();
+}
+
+TEST(ObstacleSceneTestSuite, pointOutsideAllBoundsIsNotSampled)
+{
+    ObstacleSceneTestSuite::pointOutsideAllBoundsIsNotSampled();
+}
+
+TEST(ObstacleSceneTestSuite, concurrentFirstQueriesSeeAllObstacles)
+{
+    ObstacleSceneTestSuite::concurrentFirstQueriesSeeAllObstacles();
+}
@@ -0,0 +1,29 @@
+/**
+ * @file ObstacleSceneTestSuite.h
+ * @author Anton Artyukh (artyukhanton@gmail.com)
+ * @date Created Oct 19, 2026
+ **/
+
+#ifndef OBSTACLE_SCENE_TEST_SUITE_H_1E3F1C96884B48D9B7BC43E7E6285943
+#define OBSTACLE_SCENE_TEST_SUITE_H_1E3F1C96884B48D9B7BC43E7E6285943
+
+namespace SPHSDK
+{
+
+namespace TestEnvironment
+{
+
+class ObstacleSceneTestSuite
+{
+public:
+    static void samplesNearestObstacle();
+
+    static void pointOutsideAllBoundsIsNotSampled();
+
+    static void concurrentFirstQueriesSeeAllObstacles();
+};
+
+} // namespace TestEnvironment
+} // namespace SPHSDK
+
+#endif // OBSTACLE_SCENE_TEST_SUITE_H_1E3F1C96884B48D9B7BC43E7E6285943
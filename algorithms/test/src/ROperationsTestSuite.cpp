@@ -7,6 +7,7 @@
 
 #include "ROperationsTestSuite.h"
 
+#include "FloatPack.h"
 #include "ROperations.h"
 
 #include <gtest/gtest.h>
@@ -29,6 +30,27 @@ void ROperationsTestSuite::testDisjunction()
     EXPECT_DOUBLE_EQ(3. + std::sqrt(5.), ROperations::disjunction(2., 1.));
 }
 
+void ROperationsTestSuite::testPacks()
+{
+    const FLOAT xs[4] = {1., 2., -0.5, 3.};
+    const FLOAT ys[4] = {1., 1., 0.25, -4.};
+
+    for (size_t i = 0u; i + FloatPack::Size <= 4u; i += FloatPack::Size)
+    {
+        FLOAT conjunctions[FloatPack::Size];
+        FLOAT disjunctions[FloatPack::Size];
+
+        ROperations::conjunction(FloatPack::load(xs + i), FloatPack::load(ys + i)).store(conjunctions);
+        ROperations::disjunction(FloatPack::load(xs + i), FloatPack::load(ys + i)).store(disjunctions);
+
+        for (size_t lane = 0u; lane < FloatPack::Size; ++lane)
+        {
+            EXPECT_DOUBLE_EQ(ROperations::conjunction(xs[i + lane], ys[i + lane]), conjunctions[lane]);
+            EXPECT_DOUBLE_EQ(ROperations::disjunction(xs[i + lane], ys[i + lane]), disjunctions[lane]);
+        }
+    }
+}
+
 } // namespace TestEnvironment
 } // namespace SPHSDK
 
@@ -43,3 +65,8 @@ TEST(ROperationsTestSuite, testDisjunction)
 {
     ROperationsTestSuite::testDisjunction();
 }
+
+TEST(ROperationsTestSuite, testPacks)
+{
+    ROperationsTestSuite::testPacks();
+}
@@ -21,6 +21,8 @@ public:
     static void testConjunction();
 
     static void testDisjunction();
+
+    static void testPacks();
 };
 
 } // namespace TestEnvironment
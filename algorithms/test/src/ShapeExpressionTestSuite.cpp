@@ -0,0 +1,230 @@
+/**
+ * @file ShapeExpressionTestSuite.cpp
+ * @author Anton Artyukh (artyukhanton@gmail.com)
+ * @date Created Oct 19, 2026
+ **/
+
+#include "ShapeExpressionTestSuite.h"
+
+#include "MarchingCubes.h"
+#include "ShapeExpression.h"
+#include "Shapes.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <fstream>
+#include <functional>
+#include <stdexcept>
+
+namespace SPHSDK
+{
+
+namespace TestEnvironment
+{
+
+namespace
+{
+// Shapes::Pawn written as text
+const char* const PawnDescription = "# Shapes::Pawn\n"
+                                    "r = sqr(x - 1.5) + sqr(y - 1.5);\n"
+                                    "body = and(0.25 - r, -20 * r + 1 + 10 * sqr(z - 0.75), z * (1 - z));\n"
+                                    "head = or(0.125 - r - 20 * sqr(1 - z), 0.05 - r - sqr(1.25 - z));\n"
+                                    "or(body, head)\n";
+} // namespace
+
+void ShapeExpressionTestSuite::pawnMatchesShapes()
+{
+    {
+        std::ofstream file("pawn.shape");
+        file << PawnDescription;
+    }
+
+    const ShapeExpression pawn = ShapeExpression::loadFromFile("pawn.shape");
+
+    // Shapes::Pawn has float constants, they differ from the text ones in the ninth digit
+    for (FLOAT x = 0.9; x < 2.1; x += 0.05)
+        for (FLOAT y = 0.9; y < 2.1; y += 0.05)
+            for (FLOAT z = -0.1; z < 1.5; z += 0.05)
+                EXPECT_NEAR(Shapes::Pawn(x, y, z), pawn(x, y, z), 1e-8);
+
+    EXPECT_EQ(MarchingCubes::generateMesh(Shapes::Pawn).size(), MarchingCubes::generateMesh(pawn).size());
+}
+
+void ShapeExpressionTestSuite::eliminatesCommonSubexpressions()
+{
+    // x - 1, sqr(x - 1) and the sum
+    EXPECT_EQ(3u, ShapeExpression::parse("sqr(x - 1) + sqr(x - 1)").getInstructionsNumber());
+
+    // Operands of commutative operations are ordered
+    EXPECT_EQ(2u, ShapeExpression::parse("a = x * y; b = y * x; a - b").getInstructionsNumber());
+
+    // Constants are folded, unused definitions are dropped
+    const ShapeExpression folded = ShapeExpression::parse("unused = sqrt(z); 2 * 3 + x");
+    EXPECT_EQ(1u, folded.getInstructionsNumber());
+    EXPECT_DOUBLE_EQ(6.5, folded(0.5, 0.0, 0.0));
+
+    const ShapeExpression plane = ShapeExpression::parse("-(-x)");
+    EXPECT_EQ(2u, plane.getInstructionsNumber());
+    EXPECT_DOUBLE_EQ(0.25, plane(0.25, 0.0, 0.0));
+
+    // Shapes without instructions
+    const FLOAT coordinates[2] = {0.25, 0.75};
+    FLOAT values[2];
+
+    ShapeExpression::parse("0.5")(coordinates, coordinates, coordinates, values, 2u);
+    EXPECT_DOUBLE_EQ(0.5, values[1]);
+
+    ShapeExpression::parse("y")(coordinates, coordinates, coordinates, values, 2u);
+    EXPECT_DOUBLE_EQ(0.75, values[1]);
+
+    // The pawn has 5 squares, the radius is shared by its 4 parts
+    const ShapeExpression pawn = ShapeExpression::parse(PawnDescription);
+    EXPECT_LT(pawn.getInstructionsNumber(), 40u);
+}
+
+void ShapeExpressionTestSuite::batchedMatchesScalar()
+{
+    const ShapeExpression shape = ShapeExpression::parse(
+        "or(and(box(0, 0, 0, 1, 1, 0.5), not(sphere(0.5, 0.5, 0.5, 0.3))), cylinder(0.5, 0.5, 0.2, 0, 1) / 2)");
+
+    // Not a whole number of chunks
+    const size_t n = 1001u;
+    std::vector<FLOAT> xs(n);
+    std::vector<FLOAT> ys(n);
+    std::vector<FLOAT> zs(n);
+
+    for (size_t i = 0u; i < n; ++i)
+    {
+        xs[i] = 0.001 * static_cast<FLOAT>(i);
+        ys[i] = 0.5 + 0.4 * std::sin(0.1 * static_cast<FLOAT>(i));
+        zs[i] = 1.2 * static_cast<FLOAT>(n - i) / n;
+    }
+
+    std::vector<FLOAT> values(n);
+    shape(xs.data(), ys.data(), zs.data(), values.data(), n);
+
+    for (size_t i = 0u; i < n; ++i)
+        EXPECT_DOUBLE_EQ(shape(xs[i], ys[i], zs[i]), values[i]);
+
+    const ShapeExpression pawn = ShapeExpression::parse(PawnDescription);
+    pawn(xs.data(), ys.data(), zs.data(), values.data(), 3u);
+
+    for (size_t i = 0u; i < 3u; ++i)
+        EXPECT_DOUBLE_EQ(pawn(xs[i], ys[i], zs[i]), values[i]);
+}
+
+void ShapeExpressionTestSuite::boundsContainValues()
+{
+    const ShapeExpression shape = ShapeExpression::parse(
+        "or(and(box(0, 0, 0, 1, 1, 0.5), not(sphere(0.5, 0.5, 0.5, 0.3))), cylinder(0.5, 0.5, 0.2, 0, 1) / 2)");
+
+    const FLOAT side = 0.3;
+
+    for (FLOAT x = -0.2; x < 1.2; x += 0.25)
+        for (FLOAT y = -0.2; y < 1.2; y += 0.25)
+            for (FLOAT z = -0.2; z < 1.2; z += 0.25)
+            {
+                const Point3F min(x, y, z);
+                const ShapeExpression::Interval bounds = shape.getBounds(min, min + Point3F(side, side, side));
+
+                for (size_t i = 0u; i <= 4u; ++i)
+                    for (size_t j = 0u; j <= 4u; ++j)
+                        for (size_t k = 0u; k <= 4u; ++k)
+                        {
+                            const FLOAT value = shape(x + side * i / 4.0, y + side * j / 4.0, z + side * k / 4.0);
+
+                            EXPECT_LE(bounds.lower, value);
+                            EXPECT_GE(bounds.upper, value);
+                        }
+            }
+
+    const ShapeExpression ball = ShapeExpression::parse("sphere(0, 0, 0, 1)");
+    EXPECT_FALSE(ball.mayContainSurface(Point3F(2.0, 2.0, 2.0), Point3F(3.0, 3.0, 3.0)));
+    EXPECT_FALSE(ball.mayContainSurface(Point3F(-0.1, -0.1, -0.1), Point3F(0.1, 0.1, 0.1)));
+    EXPECT_TRUE(ball.mayContainSurface(Point3F(0.5, 0.0, 0.0), Point3F(1.5, 0.1, 0.1)));
+}
+
+void ShapeExpressionTestSuite::culledMeshMatchesUniform()
+{
+    const ShapeExpression shape =
+        ShapeExpression::parse("and(box(0.2, 0.2, 0.2, 0.8, 0.8, 0.8), not(sphere(0.5, 0.5, 0.5, 0.35)))");
+    const std::function<FLOAT(FLOAT, FLOAT, FLOAT)> f = shape;
+
+    const Cuboid bounds(Point3F(), 1.0, 1.0, 1.0);
+
+    IndexedMesh uniformMesh;
+    MarchingCubes::generateMesh(f, bounds, 0.02, uniformMesh);
+
+    IndexedMesh culledMesh;
+    MarchingCubes::generateCulledMesh(
+        f, bounds, 0.02,
+        [&shape](const Point3F& min, const Point3F& max) { return shape.mayContainSurface(min, max); },
+        culledMesh);
+
+    ASSERT_FALSE(uniformMesh.indices.empty());
+    EXPECT_EQ(uniformMesh.vertices, culledMesh.vertices);
+    EXPECT_EQ(uniformMesh.indices, culledMesh.indices);
+}
+
+void ShapeExpressionTestSuite::reportsErrors()
+{
+    EXPECT_THROW(ShapeExpression::parse(""), std::invalid_argument);
+    EXPECT_THROW(ShapeExpression::parse("x +"), std::invalid_argument);
+    EXPECT_THROW(ShapeExpression::parse("(x"), std::invalid_argument);
+    EXPECT_THROW(ShapeExpression::parse("x y"), std::invalid_argument);
+    EXPECT_THROW(ShapeExpression::parse("x $ y"), std::invalid_argument);
+    EXPECT_THROW(ShapeExpression::parse("radius"), std::invalid_argument);
+    EXPECT_THROW(ShapeExpression::parse("x = 1; x"), std::invalid_argument);
+    EXPECT_THROW(ShapeExpression::parse("a = x y"), std::invalid_argument);
+    EXPECT_THROW(ShapeExpression::parse("and(x)"), std::invalid_argument);
+    EXPECT_THROW(ShapeExpression::parse("sphere(0, 0, 0)"), std::invalid_argument);
+    EXPECT_THROW(ShapeExpression::parse("torus(1, 2)"), std::invalid_argument);
+
+    try
+    {
+        ShapeExpression::parse("a = x;\n\nb = a + c;\nb");
+        FAIL();
+    }
+    catch (const std::invalid_argument& error)
+    {
+        EXPECT_NE(std::string::npos, std::string(error.what()).find("line 3"));
+    }
+
+    EXPECT_THROW(ShapeExpression::loadFromFile("missing.shape"), std::runtime_error);
+}
+
+} // namespace TestEnvironment
+} // namespace SPHSDK
+
+using namespace SPHSDK::TestEnvironment;
+
+TEST(ShapeExpressionTestSuite, pawnMatchesShapes)
+{
+    ShapeExpressionTestSuite::pawnMatchesShapes();
+}
+
+TEST(ShapeExpressionTestSuite, eliminatesCommonSubexpressions)
+{
+    ShapeExpressionTestSuite::eliminatesCommonSubexpressions();
+}
+
+TEST(ShapeExpressionTestSuite, batchedMatchesScalar)
+{
+    ShapeExpressionTestSuite::batchedMatchesScalar();
+}
+
+TEST(ShapeExpressionTestSuite, boundsContainValues)
+{
+    ShapeExpressionTestSuite::boundsContainValues();
+}
+
+TEST(ShapeExpressionTestSuite, culledMeshMatchesUniform)
+{
+    ShapeExpressionTestSuite::culledMeshMatchesUniform();
+}
+
+TEST(ShapeExpressionTestSuite, reportsErrors)
+{
+    ShapeExpressionTestSuite::reportsErrors();
+}
@@ -0,0 +1,35 @@
+/**
+ * @file ShapeExpressionTestSuite.h
+ * @author Anton Artyukh (artyukhanton@gmail.com)
+ * @date Created Oct 19, 2026
+ **/
+
+#ifndef SHAPE_EXPRESSION_TEST_SUITE_H_2C94E1F07B3A4D68A5E0C7D91B2F46A3
+#define SHAPE_EXPRESSION_TEST_SUITE_H_2C94E1F07B3A4D68A5E0C7D91B2F46A3
+
+namespace SPHSDK
+{
+
+namespace TestEnvironment
+{
+
+class ShapeExpressionTestSuite
+{
+public:
+    static void pawnMatchesShapes();
+
+    static void eliminatesCommonSubexpressions();
+
+    static void batchedMatchesScalar();
+
+    static void boundsContainValues();
+
+    static void culledMeshMatchesUniform();
+
+    static void reportsErrors();
+};
+
+} // namespace TestEnvironment
+} // namespace SPHSDK
+
+#endif // SHAPE_EXPRESSION_TEST_SUITE_H_2C94E1F07B3A4D68A5E0C7D91B2F46A3
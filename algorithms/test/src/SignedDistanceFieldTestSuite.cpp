@@ -0,0 +1,186 @@
+/**
+ * @file SignedDistanceFieldTestSuite.cpp
+ * @author Anton Artyukh (artyukhanton@gmail.com)
+ * @date Created Oct 19, 2026
+ **/
+
+#include "SignedDistanceFieldTestSuite.h"
+
+#include "SignedDistanceField.h"
+#include "ThreadPool.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+
+namespace SPHSDK
+{
+namespace TestEnvironment
+{
+
+namespace
+{
+// Ball of radius 0.5 centred in the 2 m cube
+FLOAT ball(FLOAT x, FLOAT y, FLOAT z)
+{
+    return 0.25 - (x - 1.0) * (x - 1.0) - (y - 1.0) * (y - 1.0) - (z - 1.0) * (z - 1.0);
+}
+
+const Cuboid Bounds(Point3F(0.0, 0.0, 0.0), 2.0, 2.0, 2.0);
+} // namespace
+
+void SignedDistanceFieldTestSuite::sphereDistanceAndGradient()
+{
+    const SignedDistanceField field(ball, Bounds, 0.05, 0.2);
+
+    FLOAT distance = 0.0;
+    Point3F gradient;
+
+    ASSERT_TRUE(field.sample(Point3F(1.45, 1.0, 1.0), distance, gradient));
+    EXPECT_NEAR(0.05, distance, 0.01);
+    EXPECT_NEAR(-1.0, gradient.x, 0.01);
+    EXPECT_NEAR(0.0, gradient.y, 0.01);
+    EXPECT_NEAR(0.0, gradient.z, 0.01);
+
+    ASSERT_TRUE(field.sample(Point3F(1.0, 1.0, 0.42), distance, gradient));
+    EXPECT_NEAR(-0.08, distance, 0.01);
+    EXPECT_NEAR(1.0, gradient.z, 0.01);
+
+    EXPECT_DOUBLE_EQ(distance, field.getDistance(Point3F(1.0, 1.0, 0.42)));
+}
+
+void SignedDistanceFieldTestSuite::farPointsAreNotSampled()
+{
+    const SignedDistanceField field(ball, Bounds, 0.05, 0.1);
+
+    FLOAT distance = 0.0;
+    Point3F gradient(1.0, 1.0, 1.0);
+
+    EXPECT_FALSE(field.sample(Point3F(1.0, 1.0, 1.0), distance, gradient));
+    EXPECT_DOUBLE_EQ(0.1, distance);
+    EXPECT_DOUBLE_EQ(0.0, gradient.calcNormSqr());
+
+    EXPECT_FALSE(field.sample(Point3F(0.1, 0.1, 0.1), distance, gradient));
+    EXPECT_DOUBLE_EQ(-0.1, distance);
+
+    EXPECT_DOUBLE_EQ(-0.1, field.getDistance(Point3F(-1.0, 1.0, 1.0)));
+    EXPECT_DOUBLE_EQ(-0.1, field.getDistance(Point3F(1.0, 3.0, 1.0)));
+}
+
+void SignedDistanceFieldTestSuite::onlyBandBricksKeepSamples()
+{
+    const SignedDistanceField field(ball, Bounds, 0.05, 0.1);
+
+    const size_t brickSamples = (SignedDistanceField::BrickSize + 1u) * (SignedDistanceField::BrickSize + 1u) *
+                                (SignedDistanceField::BrickSize + 1u);
+
+    size_t bandBricks = 0u;
+    for (const int32_t slot : field.m_brickSlots)
+        if (slot >= 0)
+            ++bandBricks;
+
+    EXPECT_EQ(bandBricks * brickSamples, field.m_samples.size());
+    EXPECT_LT(bandBricks, field.m_brickSlots.size() / 2u);
+
+    ThreadPool pool(3);
+    const SignedDistanceField parallelField(ball, Bounds, 0.05, 0.1, &pool);
+
+    ASSERT_EQ(field.m_brickSlots, parallelField.m_brickSlots);
+    ASSERT_EQ(field.m_samples.size(), parallelField.m_samples.size());
+    for (size_t i = 0u; i < field.m_samples.size(); ++i)
+        EXPECT_DOUBLE_EQ(field.m_samples[i].distance, parallelField.m_samples[i].distance);
+}
+
+void SignedDistanceFieldTestSuite::evaluatesEveryNodeOnce()
+{
+    // Sampled by several workers at once
+    std::atomic<size_t> calls{0u};
+    const auto countingBall = [&calls](FLOAT x, FLOAT y, FLOAT z) {
+        ++calls;
+        return ball(x, y, z);
+    };
+
+    ThreadPool pool(3);
+    const SignedDistanceField field(countingBall, Bounds, 0.05, 0.1, &pool);
+
+    // 40 cells are 5 bricks along every axis, their nodes with one more node on every side
+    const size_t nodes = 5u * SignedDistanceField::BrickSize + 3u;
+    EXPECT_EQ(nodes * nodes * nodes, calls.load());
+
+    const SignedDistanceField reference(ball, Bounds, 0.05, 0.1);
+    EXPECT_EQ(reference.m_brickSlots, field.m_brickSlots);
+}
+
+void SignedDistanceFieldTestSuite::loadRejectsCorruptedField()
+{
+    const SignedDistanceField field(ball, Bounds, 0.05, 0.1);
+
+    std::ostringstream stream(std::ios::binary);
+    field.save(stream);
+    const std::string saved = stream.str();
+
+    std::istringstream savedStream(saved, std::ios::binary);
+    const SignedDistanceField loaded = SignedDistanceField::load(savedStream);
+    EXPECT_EQ(field.m_brickSlots, loaded.m_brickSlots);
+    EXPECT_DOUBLE_EQ(field.getDistance(Point3F(1.45, 1.0, 1.0)), loaded.getDistance(Point3F(1.45, 1.0, 1.0)));
+
+    // Signature, origin, cell size, band width and cells along every axis precede the number of samples
+    const size_t samplesNumberOffset = 8u + 5u * sizeof(FLOAT) + 3u * sizeof(uint64_t);
+    const size_t slotsOffset = samplesNumberOffset + sizeof(uint64_t);
+
+    const auto loadPatched = [&saved](size_t offset, const void* value, size_t size) {
+        std::string patched = saved;
+        std::memcpy(&patched[offset], value, size);
+
+        std::istringstream patchedStream(patched, std::ios::binary);
+        SignedDistanceField::load(patchedStream);
+    };
+
+    const uint64_t partialSamples = field.m_samples.size() - 1u;
+    EXPECT_THROW(loadPatched(samplesNumberOffset, &partialSamples, sizeof(partialSamples)), std::runtime_error);
+
+    const int32_t unknownSlot = -3;
+    EXPECT_THROW(loadPatched(slotsOffset, &unknownSlot, sizeof(unknownSlot)), std::runtime_error);
+
+    const int32_t missingBrick = static_cast<int32_t>(field.m_brickSlots.size());
+    EXPECT_THROW(loadPatched(slotsOffset, &missingBrick, sizeof(missingBrick)), std::runtime_error);
+
+    const uint64_t hugeCells = static_cast<uint64_t>(1u) << 40u;
+    EXPECT_THROW(loadPatched(slotsOffset - 2u * sizeof(uint64_t), &hugeCells, sizeof(hugeCells)), std::runtime_error);
+
+    std::istringstream truncatedStream(saved.substr(0u, saved.size() - 1u), std::ios::binary);
+    EXPECT_THROW(SignedDistanceField::load(truncatedStream), std::runtime_error);
+}
+
+} // namespace TestEnvironment
+} // namespace SPHSDK
+
+using namespace SPHSDK::TestEnvironment;
+
+TEST(SignedDistanceFieldTestSuite, sphereDistanceAndGradient)
+{
+    SignedDistanceFieldTestSuite::sphereDistanceAndGradient();
+}
+
+TEST(SignedDistanceFieldTestSuite, farPointsAreNotSampled)
+{
+    SignedDistanceFieldTestSuite::farPointsAreNotSampled();
+}
+
+TEST(SignedDistanceFieldTestSuite, onlyBandBricksKeepSamples)
+{
+    SignedDistanceFieldTestSuite::onlyBandBricksKeepSamples();
+}
+
+TEST(SignedDistanceFieldTestSuite, evaluatesEveryNodeOnce)
+{
+    SignedDistanceFieldTestSuite::evaluatesEveryNodeOnce();
+}
+
+TEST(SignedDistanceFieldTestSuite, loadRejectsCorruptedField)
+{
+    SignedDistanceFieldTestSuite::loadRejectsCorruptedField();
+}
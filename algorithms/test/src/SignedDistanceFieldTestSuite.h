@@ -0,0 +1,33 @@
+/**
+ * @file SignedDistanceFieldTestSuite.h
+ * @author Anton Artyukh (artyukhanton@gmail.com)
+ * @date Created Oct 19, 2026
+ **/
+
+#ifndef SIGNED_DISTANCE_FIELD_TEST_SUITE_H_BACB003A24C340A29D6B50274EC9E686
+#define SIGNED_DISTANCE_FIELD_TEST_SUITE_H_BACB003A24C340A29D6B50274EC9E686
+
+namespace SPHSDK
+{
+
+namespace TestEnvironment
+{
+
+class SignedDistanceFieldTestSuite
+{
+public:
+    static void sphereDistanceAndGradient();
+
+    static void farPointsAreNotSampled();
+
+    static void onlyBandBricksKeepSamples();
+
+    static void evaluatesEveryNodeOnce();
+
+    static void loadRejectsCorruptedField();
+};
+
+} // namespace TestEnvironment
+} // namespace SPHSDK
+
+#endif // SIGNED_DISTANCE_FIELD_TEST_SUITE_H_BACB003A24C340A29D6B50274EC9E686
@@ -0,0 +1,143 @@
+/**
+ * @file TaskGraphTestSuite.cpp
+ * @author Anton Artyukh (artyukhanton@gmail.com)
+ * @date Created Oct 19, 2026
+ **/
+
+#include "TaskGraphTestSuite.h"
+
+#include "TaskGraph.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <mutex>
+#include <stdexcept>
+
+namespace SPHSDK
+{
+namespace TestEnvironment
+{
+
+void TaskGraphTestSuite::runsEveryTaskOnce()
+{
+    ThreadPool pool(4);
+    TaskGraph graph;
+
+    std::vector<std::atomic<int>> visits(100);
+    for (auto& visit : visits)
+        visit = 0;
+
+    for (size_t i = 0u; i < visits.size(); ++i)
+        graph.addTask([&visits, i] { ++visits[i]; });
+
+    ASSERT_EQ(100u, graph.getTasksNumber());
+
+    graph.run(pool);
+    graph.run(pool);
+
+    for (const auto& visit : visits)
+        EXPECT_EQ(2, visit.load());
+}
+
+void TaskGraphTestSuite::respectsDependencies()
+{
+    ThreadPool pool(4);
+    TaskGraph graph;
+
+    // Three stages of 16 blocks, block b of a stage waits for blocks b - 1, b, b + 1 of the previous one
+    const size_t blocksNumber = 16u;
+    const size_t stagesNumber = 3u;
+
+    std::mutex mutex;
+    SizetVector finishOrder;
+
+    for (size_t stage = 0u; stage < stagesNumber; ++stage)
+        for (size_t block = 0u; block < blocksNumber; ++block)
+        {
+            const size_t task = graph.addTask([&mutex, &finishOrder, stage, block] {
+                std::lock_guard<std::mutex> lock(mutex);
+                finishOrder.push_back(stage * blocksNumber + block);
+            });
+
+            if (stage == 0u)
+                continue;
+
+            for (size_t halo = (block == 0u ? 0u : block - 1u); halo <= block + 1u && halo < blocksNumber; ++halo)
+                graph.addDependency((stage - 1u) * blocksNumber + halo, task);
+        }
+
+    graph.run(pool);
+
+    ASSERT_EQ(blocksNumber * stagesNumber, finishOrder.size());
+
+    SizetVector position(finishOrder.size());
+    for (size_t i = 0u; i < finishOrder.size(); ++i)
+        position[finishOrder[i]] = i;
+
+    for (size_t stage = 1u; stage < stagesNumber; ++stage)
+        for (size_t block = 0u; block < blocksNumber; ++block)
+            for (size_t halo = (block == 0u ? 0u : block - 1u); halo <= block + 1u && halo < blocksNumber; ++halo)
+                EXPECT_LT(position[(stage - 1u) * blocksNumber + halo], position[stage * blocksNumber + block]);
+}
+
+void TaskGraphTestSuite::singleThreadRunsInIndexOrder()
+{
+    ThreadPool pool(1);
+    TaskGraph graph;
+
+    SizetVector order;
+
+    const size_t first = graph.addTask([&order] { order.push_back(0u); });
+    const size_t second = graph.addTask([&order] { order.push_back(1u); });
+    const size_t third = graph.addTask([&order] { order.push_back(2u); });
+
+    graph.addDependency(second, first);
+    graph.addDependency(third, second);
+
+    graph.run(pool);
+
+    EXPECT_EQ(SizetVector({2u, 1u, 0u}), order);
+}
+
+void TaskGraphTestSuite::rejectsCycle()
+{
+    ThreadPool pool(2);
+    TaskGraph graph;
+
+    size_t calls = 0u;
+
+    const size_t first = graph.addTask([&calls] { ++calls; });
+    const size_t second = graph.addTask([&calls] { ++calls; });
+
+    graph.addDependency(first, second);
+    graph.addDependency(second, first);
+
+    EXPECT_THROW(graph.run(pool), std::logic_error);
+    EXPECT_EQ(0u, calls);
+}
+
+} // namespace TestEnvironment
+} // namespace SPHSDK
+
+using namespace SPHSDK::TestEnvironment;
+
+TEST(TaskGraphTestSuite, runsEveryTaskOnce)
+{
+    TaskGraphTestSuite::runsEveryTaskOnce();
+}
+
+TEST(TaskGraphTestSuite, respectsDependencies)
+{
+    TaskGraphTestSuite::respectsDependencies();
+}
+
+TEST(TaskGraphTestSuite, singleThreadRunsInIndexOrder)
+{
+    TaskGraphTestSuite::singleThreadRunsInIndexOrder();
+}
+
+TEST(TaskGraphTestSuite, rejectsCycle)
+{
+    TaskGraphTestSuite::rejectsCycle();
+}
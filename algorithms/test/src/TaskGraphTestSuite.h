@@ -0,0 +1,31 @@
+/**
+ * @file TaskGraphTestSuite.h
+ * @author Anton Artyukh (artyukhanton@gmail.com)
+ * @date Created Oct 19, 2026
+ **/
+
+#ifndef TASK_GRAPH_TEST_SUITE_H_CC14B63B615D4FB9868EE0C4FDC5EED9
+#define TASK_GRAPH_TEST_SUITE_H_CC14B63B615D4FB9868EE0C4FDC5EED9
+
+namespace SPHSDK
+{
+
+namespace TestEnvironment
+{
+
+class TaskGraphTestSuite
+{
+public:
+    static void runsEveryTaskOnce();
+
+    static void respectsDependencies();
+
+    static void singleThreadRunsInIndexOrder();
+
+    static void rejectsCycle();
+};
+
+} // namespace TestEnvironment
+} // namespace SPHSDK
+
+#endif // TASK_GRAPH_TEST_SUITE_H_CC14B63B615D4FB9868EE0C4FDC5EED9
@@ -0,0 +1,337 @@
+/**
+ * @file ThreadPoolTestSuite.cpp
+ * @author Anton Artyukh (artyukhanton@gmail.com)
+ * @date Created Oct 19, 2026
+ **/
+
+#include "ThreadPoolTestSuite.h"
+
+#include "ThreadPool.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+namespace SPHSDK
+{
+namespace TestEnvironment
+{
+
+void ThreadPoolTestSuite::parallelForCoversRange()
+{
+    ThreadPool pool(4);
+    ASSERT_EQ(4u, pool.getThreadsNumber());
+
+    std::vector<int> visits(1000, 0);
+
+    for (int iteration = 0; iteration < 10; ++iteration)
+    {
+        pool.parallelFor(0u, visits.size(), [&visits](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i)
+                ++visits[i];
+        });
+    }
+
+    for (const int visit : visits)
+        EXPECT_EQ(10, visit);
+}
+
+void ThreadPoolTestSuite::parallelForKeepsChunksOnWorkers()
+{
+    ThreadPool pool(3);
+
+    std::vector<std::thread::id> firstOwners(12);
+    std::vector<std::thread::id> secondOwners(12);
+
+    pool.parallelFor(0u, firstOwners.size(), [&firstOwners](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+            firstOwners[i] = std::this_thread::get_id();
+    });
+
+    pool.parallelFor(0u, secondOwners.size(), [&secondOwners](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+            secondOwners[i] = std::this_thread::get_id();
+    });
+
+    EXPECT_EQ(firstOwners, secondOwners);
+    EXPECT_EQ(std::this_thread::get_id(), firstOwners[0]);
+}
+
+void ThreadPoolTestSuite::nestedParallelForRunsSerially()
+{
+    ThreadPool pool(4);
+
+    std::atomic<size_t> sum(0u);
+
+    pool.parallelFor(0u, 8u, [&pool, &sum](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            pool.parallelFor(0u, 10u, [&sum](size_t innerBegin, size_t innerEnd) {
+                sum += innerEnd - innerBegin;
+            });
+        }
+    });
+
+    EXPECT_EQ(80u, sum.load());
+}
+
+void ThreadPoolTestSuite::singleThreadPool()
+{
+    ThreadPool pool(1);
+    ASSERT_EQ(1u, pool.getThreadsNumber());
+
+    size_t calls = 0u;
+
+    pool.parallelFor(5u, 25u, [&calls](size_t begin, size_t end) {
+        EXPECT_EQ(5u, begin);
+        EXPECT_EQ(25u, end);
+        ++calls;
+    });
+
+    pool.parallelFor(3u, 3u, [&calls](size_t, size_t) { ++calls; });
+
+    EXPECT_EQ(1u, calls);
+}
+
+void ThreadPoolTestSuite::parallelForDynamicCoversRange()
+{
+    ThreadPoolOptions options;
+    options.threadsNumber = 4u;
+    options.grainSize = 7u;
+
+    ThreadPool pool(options);
+    ASSERT_EQ(7u, pool.getGrainSize());
+
+    std::vector<std::atomic<int>> visits(1000);
+    for (auto& visit : visits)
+        visit = 0;
+
+    std::atomic<size_t> calls(0u);
+
+    pool.parallelForDynamic(0u, visits.size(), [&visits, &calls](size_t begin, size_t end) {
+        EXPECT_LE(end - begin, 7u);
+        ++calls;
+
+        for (size_t i = begin; i < end; ++i)
+            ++visits[i];
+    });
+
+    for (const auto& visit : visits)
+        EXPECT_EQ(1, visit.load());
+
+    EXPECT_EQ(143u, calls.load());
+}
+
+void ThreadPoolTestSuite::runTasksRunsSpawnedTasks()
+{
+    ThreadPool pool(4);
+
+    // Every task n < 512 spawns tasks 2n and 2n + 1, so tasks 1..1023 run once each
+    std::vector<std::atomic<int>> visits(1024);
+    for (auto& visit : visits)
+        visit = 0;
+
+    pool.runTasks(SizetVector(1u, 1u), [&pool, &visits](size_t task) {
+        ++visits[task];
+
+        if (task < 512u)
+        {
+            pool.spawn(2u * task);
+            pool.spawn(2u * task + 1u);
+        }
+    });
+
+    EXPECT_EQ(0, visits[0].load());
+    for (size_t task = 1u; task < visits.size(); ++task)
+        EXPECT_EQ(1, visits[task].load());
+}
+
+void ThreadPoolTestSuite::runTasksRethrowsExceptions()
+{
+    ThreadPool pool(4);
+
+    SizetVector tasks(100u);
+    for (size_t i = 0u; i < tasks.size(); ++i)
+        tasks[i] = i;
+
+    EXPECT_THROW(pool.runTasks(tasks,
+                               [](size_t task) {
+                                   if (task == 37u)
+                                       throw std::runtime_error("task failed");
+                               }),
+                 std::runtime_error);
+
+    // The pool stays usable
+    std::atomic<size_t> runs(0u);
+    pool.runTasks(tasks, [&runs](size_t) { ++runs; });
+    EXPECT_EQ(tasks.size(), runs.load());
+
+    EXPECT_THROW(pool.parallelForDynamic(0u, 1000u,
+                                         [](size_t begin, size_t) {
+                                             if (begin == 0u)
+                                                 throw std::logic_error("range failed");
+                                         }),
+                 std::logic_error);
+}
+
+void ThreadPoolTestSuite::workerStatsCountTasks()
+{
+    ThreadPool pool(3);
+
+    SizetVector tasks(30u);
+    for (size_t i = 0u; i < tasks.size(); ++i)
+        tasks[i] = i;
+
+    pool.runTasks(tasks, [](size_t) {});
+    pool.parallelFor(0u, 3u, [](size_t, size_t) {});
+
+    std::vector<WorkerStats> stats = pool.getWorkerStats();
+    ASSERT_EQ(3u, stats.size());
+
+    size_t tasksRun = 0u;
+    for (const WorkerStats& workerStats : stats)
+    {
+        tasksRun += workerStats.tasksRun;
+        EXPECT_GE(workerStats.idleSeconds, 0.0);
+    }
+
+    EXPECT_EQ(33u, tasksRun);
+
+    pool.resetWorkerStats();
+
+    for (const WorkerStats& workerStats : pool.getWorkerStats())
+    {
+        EXPECT_EQ(0u, workerStats.tasksRun);
+        EXPECT_EQ(0u, workerStats.steals);
+    }
+}
+
+void ThreadPoolTestSuite::callersOfSeveralThreadsTakeTurns()
+{
+    ThreadPool pool(3);
+
+    const size_t callsNumber = 200u;
+    std::atomic<size_t> sums[2] = {{0u}, {0u}};
+
+    SizetVector tasks(10u);
+    for (size_t i = 0u; i < tasks.size(); ++i)
+        tasks[i] = i;
+
+    const auto call = [&pool, &sums, &tasks, callsNumber](size_t caller) {
+        for (size_t i = 0u; i < callsNumber; ++i)
+        {
+            pool.parallelFor(0u, 100u, [&sums, caller](size_t begin, size_t end) {
+                for (size_t j = begin; j < end; ++j)
+                    sums[caller] += j;
+            });
+
+            pool.runTasks(tasks, [&sums, caller](size_t task) { sums[caller] += task; });
+        }
+    };
+
+    std::thread other(call, 1u);
+    call(0u);
+    other.join();
+
+    // Every call sees its own loop body, 4950 for the range and 45 for the tasks
+    EXPECT_EQ(callsNumber * 4995u, sums[0].load());
+    EXPECT_EQ(callsNumber * 4995u, sums[1].load());
+
+    size_t tasksRun = 0u;
+    for (const WorkerStats& workerStats : pool.getWorkerStats())
+        tasksRun += workerStats.tasksRun;
+
+    // 3 chunks of every parallelFor() and 10 tasks of every runTasks()
+    EXPECT_EQ(2u * callsNumber * 13u, tasksRun);
+}
+
+void ThreadPoolTestSuite::coresAffinityPinsWorkers()
+{
+    ThreadPoolOptions options;
+    options.threadsNumber = 3u;
+    options.affinity = ThreadAffinity::Cores;
+
+    ThreadPool pool(options);
+
+    EXPECT_TRUE(pool.getWorkerCpus(0u).empty());
+
+#ifdef __linux__
+    std::vector<size_t> pinnedCpusNumber(3u);
+
+    pool.parallelFor(0u, 3u, [&pinnedCpusNumber](size_t begin, size_t end) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        sched_getaffinity(0, sizeof(set), &set);
+
+        for (size_t i = begin; i < end; ++i)
+            pinnedCpusNumber[i] = static_cast<size_t>(CPU_COUNT(&set));
+    });
+
+    for (size_t workerIndex = 1u; workerIndex < 3u; ++workerIndex)
+    {
+        ASSERT_EQ(1u, pool.getWorkerCpus(workerIndex).size());
+        EXPECT_EQ(1u, pinnedCpusNumber[workerIndex]);
+    }
+#endif
+}
+
+} // namespace TestEnvironment
+} // namespace SPHSDK
+
+using namespace SPHSDK::TestEnvironment;
+
+TEST(ThreadPoolTestSuite, parallelForCoversRange)
+{
+    ThreadPoolTestSuite::parallelForCoversRange();
+}
+
+TEST(ThreadPoolTestSuite, parallelForKeepsChunksOnWorkers)
+{
+    ThreadPoolTestSuite::parallelForKeepsChunksOnWorkers();
+}
+
+TEST(ThreadPoolTestSuite, nestedParallelForRunsSerially)
+{
+    ThreadPoolTestSuite::nestedParallelForRunsSerially();
+}
+
+TEST(ThreadPoolTestSuite, singleThreadPool)
+{
+    ThreadPoolTestSuite::singleThreadPool();
+}
+
+TEST(ThreadPoolTestSuite, parallelForDynamicCoversRange)
+{
+    ThreadPoolTestSuite::parallelForDynamicCoversRange();
+}
+
+TEST(ThreadPoolTestSuite, runTasksRunsSpawnedTasks)
+{
+    ThreadPoolTestSuite::runTasksRunsSpawnedTasks();
+}
+
+TEST(ThreadPoolTestSuite, runTasksRethrowsExceptions)
+{
+    ThreadPoolTestSuite::runTasksRethrowsExceptions();
+}
+
+TEST(ThreadPoolTestSuite, workerStatsCountTasks)
+{
+    ThreadPoolTestSuite::workerStatsCountTasks();
+}
+
+TEST(ThreadPoolTestSuite, callersOfSeveralThreadsTakeTurns)
+{
+    ThreadPoolTestSuite::callersOfSeveralThreadsTakeTurns();
+}
+
+TEST(ThreadPoolTestSuite, coresAffinityPinsWorkers)
+{
+    ThreadPoolTestSuite::coresAffinityPinsWorkers();
+}
@@ -0,0 +1,43 @@
+/**
+ * @file ThreadPoolTestSuite.h
+ * @author Anton Artyukh (artyukhanton@gmail.com)
+ * @date Created Oct 19, 2026
+ **/
+
+#ifndef THREAD_POOL_TEST_SUITE_H_009727DC2E974AEB9988DE69A6C8C000
+#define THREAD_POOL_TEST_SUITE_H_009727DC2E974AEB9988DE69A6C8C000
+
+namespace SPHSDK
+{
+
+namespace TestEnvironment
+{
+
+class ThreadPoolTestSuite
+{
+public:
+    static void parallelForCoversRange();
+
+    static void parallelForKeepsChunksOnWorkers();
+
+    static void nestedParallelForRunsSerially();
+
+    static void singleThreadPool();
+
+    static void parallelForDynamicCoversRange();
+
+    static void runTasksRunsSpawnedTasks();
+
+    static void runTasksRethrowsExceptions();
+
+    static void workerStatsCountTasks();
+
+    static void callersOfSeveralThreadsTakeTurns();
+
+    static void coresAffinityPinsWorkers();
+};
+
+} // namespace TestEnvironment
+} // namespace SPHSDK
+
+#endif // THREAD_POOL_TEST_SUITE_H_009727DC2E974AEB9988DE69A6C8C000
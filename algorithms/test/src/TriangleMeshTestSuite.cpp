@@ -0,0 +1,189 @@
+/**
+ * @file TriangleMeshTestSuite.cpp
+ * @author Anton Artyukh (artyukhanton@gmail.com)
+ * @date Created Oct 19, 2026
+ **/
+
+#include "TriangleMeshTestSuite.h"
+
+#include "TriangleMesh.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+
+namespace SPHSDK
+{
+namespace TestEnvironment
+{
+
+void TriangleMeshTestSuite::soupWeldsCorners()
+{
+    // Two triangles of a square sharing the diagonal
+    const Point3FVector soup = {Point3F(0.0, 0.0, 0.0), Point3F(1.0, 0.0, 0.0), Point3F(1.0, 1.0, 0.0),
+                                Point3F(0.0, 0.0, 0.0), Point3F(1.0, 1.0, 0.0), Point3F(0.0, 1.0, 1e-12)};
+
+    const TriangleMesh mesh = TriangleMesh::fromTriangleSoup(soup);
+
+    ASSERT_EQ(4u, mesh.vertices.size());
+    ASSERT_EQ(2u, mesh.triangles.size());
+    EXPECT_EQ(mesh.triangles[0][0], mesh.triangles[1][0]);
+    EXPECT_EQ(mesh.triangles[0][2], mesh.triangles[1][1]);
+
+    const Cuboid bounds = mesh.getBoundingCuboid();
+    EXPECT_DOUBLE_EQ(1.0, bounds.width);
+    EXPECT_DOUBLE_EQ(1.0, bounds.length);
+}
+
+void TriangleMeshTestSuite::soupWeldsCornersAcrossCells()
+{
+    // The shared corner is written on both sides of 0.505 and 1.0, where rounding and flooring
+    // to the weld distance 0.01 put them in different cells
+    const Point3FVector soup = {Point3F(0.0, 0.0, 0.0),       Point3F(1.0, 0.0, 0.0), Point3F(0.5049, 0.9999, 0.0),
+                                Point3F(0.5051, 1.0001, 0.0), Point3F(1.0, 2.0, 0.0), Point3F(0.0, 2.0, 0.0),
+                                Point3F(0.0, 0.0, 0.0),       Point3F(1.0, 0.0, 0.0), Point3F(0.5249, 1.0, 0.0)};
+
+    const TriangleMesh mesh = TriangleMesh::fromTriangleSoup(soup, 0.01);
+
+    ASSERT_EQ(3u, mesh.triangles.size());
+    EXPECT_EQ(mesh.triangles[0][2], mesh.triangles[1][0]);
+
+    // Two weld distances away along x
+    EXPECT_NE(mesh.triangles[0][2], mesh.triangles[2][2]);
+    EXPECT_EQ(6u, mesh.vertices.size());
+}
+
+void TriangleMeshTestSuite::loadObj()
+{
+    std::istringstream stream("# square and triangle\n"
+                              "v 0 0 0\n"
+                              "v 1 0 0\n"
+                              "v 1 1 0\n"
+                              "v 0 1 0\n"
+                              "vn 0 0 1\n"
+                              "f 1//1 2//1 3//1 4//1\n"
+                              "v 0 0 1\n"
+                              "f -1 1/1 2\n");
+
+    const TriangleMesh mesh = TriangleMesh::loadObj(stream);
+
+    ASSERT_EQ(5u, mesh.vertices.size());
+    ASSERT_EQ(3u, mesh.triangles.size());
+
+    EXPECT_EQ(TriangleMesh::Triangle({0u, 1u, 2u}), mesh.triangles[0]);
+    EXPECT_EQ(TriangleMesh::Triangle({0u, 2u, 3u}), mesh.triangles[1]);
+    EXPECT_EQ(TriangleMesh::Triangle({4u, 0u, 1u}), mesh.triangles[2]);
+}
+
+void TriangleMeshTestSuite::loadObjRejectsMissingVertex()
+{
+    std::istringstream stream("v 0 0 0\n"
+                              "v 1 0 0\n"
+                              "f 1 2 3\n");
+
+    EXPECT_THROW(TriangleMesh::loadObj(stream), std::runtime_error);
+}
+
+void TriangleMeshTestSuite::loadObjRejectsMalformedIndex()
+{
+    const std::string vertices = "v 0 0 0\n"
+                                 "v 1 0 0\n"
+                                 "v 0 1 0\n";
+
+    for (const std::string face : {"f a b c\n", "f 1 2 3x\n", "f 1 2 /3\n", "f 1 2 99999999999999999999\n"})
+    {
+        std::istringstream stream(vertices + face);
+        EXPECT_THROW(TriangleMesh::loadObj(stream), std::runtime_error) << face;
+    }
+}
+
+void TriangleMeshTestSuite::loadAsciiStl()
+{
+    std::istringstream stream("solid square\n"
+                              "facet normal 0 0 1\n"
+                              " outer loop\n"
+                              "  vertex 0 0 0\n"
+                              "  vertex 1 0 0\n"
+                              "  vertex 1 1 0\n"
+                              " endloop\n"
+                              "endfacet\n"
+                              "facet normal 0 0 1\n"
+                              " outer loop\n"
+                              "  vertex 0 0 0\n"
+                              "  vertex 1 1 0\n"
+                              "  vertex 0 1 0\n"
+                              " endloop\n"
+                              "endfacet\n"
+                              "endsolid square\n");
+
+    const TriangleMesh mesh = TriangleMesh::loadStl(stream);
+
+    EXPECT_EQ(4u, mesh.vertices.size());
+    ASSERT_EQ(2u, mesh.triangles.size());
+    EXPECT_EQ(mesh.triangles[0][2], mesh.triangles[1][1]);
+}
+
+void TriangleMeshTestSuite::loadBinaryStl()
+{
+    const float facets[2][12] = {{0, 0, 1, 0, 0, 0, 1, 0, 0, 1, 1, 0}, {0, 0, 1, 0, 0, 0, 1, 1, 0, 0, 1, 0}};
+
+    std::string data(80u, ' ');
+    const uint32_t facetsNumber = 2u;
+    data.append(reinterpret_cast<const char*>(&facetsNumber), sizeof(facetsNumber));
+
+    for (const auto& facet : facets)
+    {
+        data.append(reinterpret_cast<const char*>(facet), sizeof(facet));
+        data.append(2u, '\0');
+    }
+
+    std::istringstream stream(data);
+    const TriangleMesh mesh = TriangleMesh::loadStl(stream);
+
+    EXPECT_EQ(4u, mesh.vertices.size());
+    ASSERT_EQ(2u, mesh.triangles.size());
+    EXPECT_DOUBLE_EQ(1.0, mesh.vertices[mesh.triangles[1][1]].y);
+}
+
+} // namespace TestEnvironment
+} // namespace SPHSDK
+
+using namespace SPHSDK::TestEnvironment;
+
+TEST(TriangleMeshTestSuite, soupWeldsCorners)
+{
+    TriangleMeshTestSuite::soupWeldsCorners();
+}
+
+TEST(TriangleMeshTestSuite, soupWeldsCornersAcrossCells)
+{
+    TriangleMeshTestSuite::soupWeldsCornersAcrossCells();
+}
+
+TEST(TriangleMeshTestSuite, loadObj)
+{
+    TriangleMeshTestSuite::loadObj();
+}
+
+TEST(TriangleMeshTestSuite, loadObjRejectsMissingVertex)
+{
+    TriangleMeshTestSuite::loadObjRejectsMissingVertex();
+}
+
+TEST(TriangleMeshTestSuite, loadObjRejectsMalformedIndex)
+{
+    TriangleMeshTestSuite::loadObjRejectsMalformedIndex();
+}
+
+TEST(TriangleMeshTestSuite, loadAsciiStl)
+{
+    TriangleMeshTestSuite::loadAsciiStl();
+}
+
+TEST(TriangleMeshTestSuite, loadBinaryStl)
+{
+    TriangleMeshTestSuite::loadBinaryStl();
+}
@@ -0,0 +1,37 @@
+/**
+ * @file TriangleMeshTestSuite.h
+ * @author Anton Artyukh (artyukhanton@gmail.com)
+ * @date Created Oct 19, 2026
+ **/
+
+#ifndef TRIANGLE_MESH_TEST_SUITE_H_19C5E3022C7145FC8C9424BBD0F072F1
+#define TRIANGLE_MESH_TEST_SUITE_H_19C5E3022C7145FC8C9424BBD0F072F1
+
+namespace SPHSDK
+{
+
+namespace TestEnvironment
+{
+
+class TriangleMeshTestSuite
+{
+public:
+    static void soupWeldsCorners();
+
+    static void soupWeldsCornersAcrossCells();
+
+    static void loadObj();
+
+    static void loadObjRejectsMissingVertex();
+
+    static void loadObjRejectsMalformedIndex();
+
+    static void loadAsciiStl();
+
+    static void loadBinaryStl();
+};
+
+} // namespace TestEnvironment
+} // namespace SPHSDK
+
+#endif // TRIANGLE_MESH_TEST_SUITE_H_19C5E3022C7145FC8C9424BBD0F072F1
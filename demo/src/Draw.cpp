@@ -23,8 +23,9 @@
 #include <math.h>
 
 #include "algorithms/src/MarchingCubes.h"
+#include "algorithms/src/ShapeExpression.h"
 #include "algorithms/src/Shapes.h"
-#include "sph/src/Config.h"
+#include "sph/src/SimulationParams.h"
 #include "sph/src/SPH.h"
 
 // Window dimensions
@@ -37,6 +38,8 @@ static const GLfloat pointSize = 5.f;
 
 static SPHSDK::SPH sph;
 
+static SPHSDK::Point3F initialGravity;
+
 static SPHSDK::Point3FVector mesh;
 
 void MyDisplay(void)
@@ -69,7 +72,7 @@ void MyDisplay(void)
 
     sph.run();
 
-    const auto cubeSize = SPHSDK::Config::CubeSize;
+    const auto cubeSize = sph.getParams().cubeSize;
 
     // Draw the obstacle
     glBegin(GL_TRIANGLES);
@@ -86,7 +89,7 @@ void MyDisplay(void)
 
     glVertexPointer(3, GL_DOUBLE, sizeof(SPHSDK::Particle), &sph.particles[0].position);
     glColorPointer(3, GL_DOUBLE, sizeof(SPHSDK::Particle), &sph.particles[0].colour);
-    glDrawArrays(GL_POINTS, 0, SPHSDK::Config::ParticlesNumber);
+    glDrawArrays(GL_POINTS, 0, static_cast<GLsizei>(sph.particles.size()));
 
     glDisableClientState(GL_COLOR_ARRAY);
     glDisableClientState(GL_VERTEX_ARRAY);
@@ -141,12 +144,10 @@ void updateGravity()
     //   |1     0           0| |x|   |        x        |   |x'|
     //   |0   cos θ    −sin θ| |y| = |y cos θ − z sin θ| = |y'|
     //   |0   sin θ     cos θ| |z|   |y sin θ + z cos θ|   |z'|
-    SPHSDK::Config::GravitationalAcceleration =
-        SPHSDK::Point3F(SPHSDK::Config::InitialGravitationalAcceleration.x,
-                               SPHSDK::Config::InitialGravitationalAcceleration.y * cos(angle / 180 * M_PI) -
-                                   SPHSDK::Config::InitialGravitationalAcceleration.z * sin(angle / 180 * M_PI),
-                               SPHSDK::Config::InitialGravitationalAcceleration.y * sin(angle / 180 * M_PI) +
-                                   SPHSDK::Config::InitialGravitationalAcceleration.z * cos(angle / 180 * M_PI));
+    sph.setGravitationalAcceleration(
+        SPHSDK::Point3F(initialGravity.x,
+                        initialGravity.y * cos(angle / 180 * M_PI) - initialGravity.z * sin(angle / 180 * M_PI),
+                        initialGravity.y * sin(angle / 180 * M_PI) + initialGravity.z * cos(angle / 180 * M_PI)));
 }
 
 void resize_callback(GLFWwindow* window, int width, int height)
@@ -170,7 +171,7 @@ void key_callback(GLFWwindow* window, int key, int scancode, int action, int mod
             break;
         case GLFW_KEY_HOME:
             angle = 360.0;
-            SPHSDK::Config::GravitationalAcceleration = SPHSDK::Point3F(0.0, 0.0, -9.82);
+            sph.setGravitationalAcceleration(initialGravity);
             break;
         case GLFW_KEY_ESCAPE:
             glfwSetWindowShouldClose(window, GLFW_TRUE);
@@ -182,8 +183,14 @@ void Draw::MainDraw(int argc, char** argv)
 {
     using namespace SPHSDK;
 
-    static const std::function<FLOAT(FLOAT, FLOAT, FLOAT)> obstacle = Shapes::Pawn;
-    sph = SPH(&obstacle);
+    // optional parameters file overrides the Config values
+    const SimulationParams params = argc > 1 ? SimulationParams::loadFromFile(argv[1]) : SimulationParams();
+
+    // optional shape file replaces the pawn, see ShapeExpression
+    static const std::function<FLOAT(FLOAT, FLOAT, FLOAT)> obstacle =
+        argc > 2 ? std::function<FLOAT(FLOAT, FLOAT, FLOAT)>(ShapeExpression::loadFromFile(argv[2])) : Shapes::Pawn;
+    sph = SPH(params, &obstacle);
+    initialGravity = params.gravitationalAcceleration;
 
     mesh = MarchingCubes::generateMesh(obstacle);
 
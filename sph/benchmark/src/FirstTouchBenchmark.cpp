@@ -0,0 +1,180 @@
+/**
+ * @file FirstTouchBenchmark.cpp
+ * @author Anton Artyukh (artyukhanton@gmail.com)
+ * @date Created Oct 19, 2026
+ *
+ * Compares particles initialised by the constructing thread with first-touch allocation
+ * on a pool pinned to NUMA nodes. For both modes it prints the NUMA nodes of the pages of the particles
+ * of every worker, the bandwidth of every worker sweeping its own particles and the average time of SPH::run()
+ * after a warm-up step.
+ *
+ * Usage: sph_first_touch_benchmark [particlesNumber [threadsNumber [stepsNumber [sweepsNumber]]]]
+ * The initial sphere of particles fits into the default cube up to about 60000 particles.
+ **/
+
+#include "sph/src/SPH.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <string>
+
+#ifdef __linux__
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+using namespace SPHSDK;
+
+namespace
+{
+
+// Returns NUMA node of the page containing address or -1 if it is unknown
+int getPageNode(const void* address)
+{
+#if defined(__linux__) && defined(SYS_get_mempolicy)
+    const unsigned long MpolFNode = 1ul;
+    const unsigned long MpolFAddr = 2ul;
+
+    int node = -1;
+    if (syscall(SYS_get_mempolicy, &node, nullptr, 0ul, address, MpolFNode | MpolFAddr) == 0)
+        return node;
+#else
+    (void)address;
+#endif
+    return -1;
+}
+
+// The calling thread is worker 0 and is not pinned by the pool, so it joins the node of worker 1
+void pinCallingThreadNearWorkers(const ThreadPool& pool)
+{
+#ifdef __linux__
+    if (pool.getThreadsNumber() < 2u || pool.getWorkerCpus(1u).empty())
+        return;
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+
+    for (const size_t cpu : pool.getWorkerCpus(1u))
+        CPU_SET(cpu, &set);
+
+    sched_setaffinity(0, sizeof(set), &set);
+#else
+    (void)pool;
+#endif
+}
+
+// Ranges of the particles owned by every worker, the particles start sorted by their owners
+SizetVector getWorkerStarts(const SPH& sph)
+{
+    const size_t threadsNumber = sph.getThreadPool().getThreadsNumber();
+    SizetVector workerStarts(threadsNumber + 1u, sph.particles.size());
+
+    for (size_t worker = 0u, i = 0u; worker < threadsNumber; ++worker)
+    {
+        while (i < sph.particles.size() && sph.getOwningWorker(sph.particles[i].position) < worker)
+            ++i;
+
+        workerStarts[worker] = i;
+    }
+
+    return workerStarts;
+}
+
+// Prints the page nodes of the particles of every worker, first-touch keeps each range on one node
+void printPageNodes(const SPH& sph, const SizetVector& workerStarts)
+{
+    std::cout << "  page nodes of worker particles:";
+
+    for (size_t worker = 0u; worker + 1u < workerStarts.size(); ++worker)
+    {
+        std::map<int, size_t> particlesOfNode;
+        for (size_t i = workerStarts[worker]; i < workerStarts[worker + 1u]; ++i)
+            ++particlesOfNode[getPageNode(&sph.particles[i])];
+
+        std::cout << " [";
+        for (const auto& nodeParticles : particlesOfNode)
+            std::cout << " " << nodeParticles.first << ":" << nodeParticles.second;
+        std::cout << " ]";
+    }
+
+    std::cout << std::endl;
+}
+
+// Every worker sweeps its own particles like the block stages of a step do
+double measureSweepBandwidth(SPH& sph, const SizetVector& workerStarts, size_t sweepsNumber)
+{
+    ThreadPool& pool = sph.getThreadPool();
+    ParticleVect& particles = sph.particles;
+
+    const auto sweep = [&particles, &workerStarts](size_t begin, size_t end) {
+        for (size_t worker = begin; worker < end; ++worker)
+            for (size_t i = workerStarts[worker]; i < workerStarts[worker + 1u]; ++i)
+                particles[i].fTotal = particles[i].fExternal + particles[i].fInternal + particles[i].velocity;
+    };
+
+    // Warm up caches and TLB
+    pool.parallelFor(0u, pool.getThreadsNumber(), sweep);
+
+    const auto start = std::chrono::steady_clock::now();
+
+    for (size_t i = 0u; i < sweepsNumber; ++i)
+        pool.parallelFor(0u, pool.getThreadsNumber(), sweep);
+
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    return static_cast<double>(sizeof(Particle) * particles.size() * sweepsNumber) / seconds / 1e9;
+}
+
+double measureStepTime(SPH& sph, size_t stepsNumber)
+{
+    // Warm up caches, TLB and the capacities of neighbours
+    sph.run();
+
+    const auto start = std::chrono::steady_clock::now();
+
+    for (size_t i = 0u; i < stepsNumber; ++i)
+        sph.run();
+
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() / stepsNumber;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    SimulationParams params;
+    params.particlesNumber = argc > 1 ? std::stoul(argv[1]) : 50000u;
+
+    ThreadPoolOptions poolOptions;
+    poolOptions.threadsNumber = argc > 2 ? std::stoul(argv[2]) : 0u;
+    poolOptions.affinity = ThreadAffinity::NumaNodes;
+
+    const size_t stepsNumber = argc > 3 ? std::stoul(argv[3]) : 20u;
+    const size_t sweepsNumber = argc > 4 ? std::stoul(argv[4]) : 200u;
+
+    for (const bool firstTouch : {false, true})
+    {
+        params.firstTouchAllocation = firstTouch;
+
+        const auto pool = std::make_shared<ThreadPool>(poolOptions);
+        pinCallingThreadNearWorkers(*pool);
+
+        SPH sph(params, nullptr, pool);
+
+        std::cout << (firstTouch ? "first-touch allocation" : "allocation by the constructing thread") << ", "
+                  << params.particlesNumber << " particles, " << pool->getThreadsNumber() << " threads" << std::endl;
+
+        const SizetVector workerStarts = getWorkerStarts(sph);
+        printPageNodes(sph, workerStarts);
+
+        std::cout << "  sweep bandwidth: " << measureSweepBandwidth(sph, workerStarts, sweepsNumber) << " GB/s"
+                  << std::endl;
+
+        std::cout << "  step time: " << measureStepTime(sph, stepsNumber) << " s" << std::endl;
+    }
+
+    return EXIT_SUCCESS;
+}
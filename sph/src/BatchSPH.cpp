@@ -0,0 +1,62 @@
+/**
+ * @file BatchSPH.cpp
+ * @author Anton Artyukh (artyukhanton@gmail.com)
+ * @date Created Oct 19, 2026
+ **/
+
+#include "BatchSPH.h"
+
+#include "algorithms/src/TaskGraph.h"
+
+namespace SPHSDK
+{
+
+BatchSPH::BatchSPH(size_t threadsNumber)
+    : m_pool(std::make_shared<ThreadPool>(threadsNumber))
+{
+}
+
+size_t BatchSPH::addScene(const SimulationParams& params, const std::function<FLOAT(FLOAT, FLOAT, FLOAT)>* obstacle)
+{
+    m_scenes.emplace_back(params, obstacle, m_pool);
+    return m_scenes.size() - 1u;
+}
+
+size_t BatchSPH::addScene(const SimulationParams& params, std::shared_ptr<const ObstacleScene> obstacles)
+{
+    m_scenes.emplace_back(params, std::move(obstacles), m_pool);
+    return m_scenes.size() - 1u;
+}
+
+size_t BatchSPH::getScenesNumber() const
+{
+    return m_scenes.size();
+}
+
+SPH& BatchSPH::getScene(size_t sceneIndex)
+{
+    return m_scenes[sceneIndex];
+}
+
+const SPH& BatchSPH::getScene(size_t sceneIndex) const
+{
+    return m_scenes[sceneIndex];
+}
+
+void BatchSPH::step()
+{
+    TaskGraph graph;
+
+    for (SPH& scene : m_scenes)
+        scene.addStepTasks(graph);
+
+    graph.run(*m_pool);
+}
+
+void BatchSPH::run(size_t stepsNumber)
+{
+    for (size_t i = 0u; i < stepsNumber; ++i)
+        step();
+}
+
+} // namespace SPHSDK
@@ -0,0 +1,78 @@
+/**
+ * @file BatchSPH.h
+ * @author Anton Artyukh (artyukhanton@gmail.com)
+ * @date Created Oct 19, 2026
+ **/
+
+#ifndef BATCH_SPH_H_E66600504B8540B39C83A8D89D729C43
+#define BATCH_SPH_H_E66600504B8540B39C83A8D89D729C43
+
+#include "SPH.h"
+#include "SimulationParams.h"
+
+#include "algorithms/src/Defines.h"
+#include "algorithms/src/ThreadPool.h"
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace SPHSDK
+{
+
+/**
+ * @brief BatchSPH class steps many independent scenes in lockstep on one shared thread pool.
+ * Every scene keeps its own SimulationParams, so parameter sweeps do not touch Config.
+ * A step puts the block tasks of all scenes into one task graph on the pool of the batch (see SPH::run()),
+ * so threads are not left idle with fewer scenes than threads, and threads done with a small scene
+ * steal blocks of the large ones.
+ */
+class BatchSPH
+{
+public:
+    /**
+     * @brief Creates empty batch.
+     * @param threadsNumber    The number of threads shared by all scenes, 0 means hardware concurrency
+     */
+    explicit BatchSPH(size_t threadsNumber = 0);
+
+    /**
+     * @brief Adds scene to the batch.
+     * References returned by getScene() are invalidated by this call.
+     * @param params      The parameters of the scene
+     * @param obstacle    The obstacle function, it is sampled into a distance field of the scene
+     * @return index of the added scene
+     */
+    size_t addScene(const SimulationParams& params,
+                    const std::function<FLOAT(FLOAT, FLOAT, FLOAT)>* obstacle = nullptr);
+
+    /**
+     * @brief Adds scene with several obstacles, the rest like above.
+     */
+    size_t addScene(const SimulationParams& params, std::shared_ptr<const ObstacleScene> obstacles);
+
+    size_t getScenesNumber() const;
+
+    SPH& getScene(size_t sceneIndex);
+
+    const SPH& getScene(size_t sceneIndex) const;
+
+    /**
+     * @brief Advances every scene by one time step.
+     */
+    void step();
+
+    /**
+     * @brief Advances every scene by the given number of time steps.
+     */
+    void run(size_t stepsNumber);
+
+private:
+    std::shared_ptr<ThreadPool> m_pool;
+
+    std::vector<SPH> m_scenes;
+};
+
+} // namespace SPHSDK
+
+#endif // BATCH_SPH_H_E66600504B8540B39C83A8D89D729C43
@@ -0,0 +1,330 @@
+/**
+ * @file BoundaryParticles.cpp
+ * @author Anton Artyukh (artyukhanton@gmail.com)
+ * @date Created Oct 19, 2026
+ **/
+
+#include "BoundaryParticles.h"
+
+#include "algorithms/src/ThreadPool.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace SPHSDK
+{
+
+namespace
+{
+// Poly6 kernel of density (Formula 4.3)
+FLOAT densityKernel(const SimulationParams& params, FLOAT distanceSqr)
+{
+    const FLOAT difference = params.supportRadiusSqr - distanceSqr;
+    return params.kernelDefaultMultiplier * difference * difference * difference;
+}
+
+// Samples of [0, side] with at most the given spacing, both ends included
+size_t getSamplesNumber(FLOAT side, FLOAT spacing)
+{
+    return std::max<size_t>(1u, static_cast<size_t>(std::ceil(side / spacing)));
+}
+
+void sampleWalls(const Volume& volume, FLOAT spacing, Point3FVector& positions)
+{
+    const Cuboid cuboid = volume.getBoundingCuboid();
+    const FLOAT sides[3] = {cuboid.width, cuboid.length, cuboid.height};
+
+    size_t samplesNumbers[3];
+    FLOAT steps[3];
+    // Along periodic axes the last sample is the first one of the next period
+    size_t lastSamples[3];
+
+    for (size_t axis = 0u; axis < 3u; ++axis)
+    {
+        samplesNumbers[axis] = getSamplesNumber(sides[axis], spacing);
+        steps[axis] = sides[axis] / samplesNumbers[axis];
+        lastSamples[axis] = volume.isPeriodic(axis) ? samplesNumbers[axis] - 1u : samplesNumbers[axis];
+    }
+
+    // Every edge and corner is sampled once, by the wall of the first closed axis it lies on
+    const auto isOnPreviousWall = [&volume, &samplesNumbers](const size_t (&sample)[3], size_t axis) {
+        for (size_t previous = 0u; previous < axis; ++previous)
+            if (!volume.isPeriodic(previous) && (sample[previous] == 0u || sample[previous] == samplesNumbers[previous]))
+                return true;
+
+        return false;
+    };
+
+    for (size_t axis = 0u; axis < 3u; ++axis)
+    {
+        if (volume.isPeriodic(axis))
+            continue;
+
+        const size_t u = (axis + 1u) % 3u;
+        const size_t v = (axis + 2u) % 3u;
+
+        for (const size_t wall : {size_t(0u), samplesNumbers[axis]})
+            for (size_t i = 0u; i <= lastSamples[u]; ++i)
+                for (size_t j = 0u; j <= lastSamples[v]; ++j)
+                {
+                    size_t sample[3];
+                    sample[axis] = wall;
+                    sample[u] = i;
+                    sample[v] = j;
+
+                    if (isOnPreviousWall(sample, axis))
+                        continue;
+
+                    positions.push_back(cuboid.startingPoint + Point3F(steps[0] * sample[0], steps[1] * sample[1],
+                                                                       steps[2] * sample[2]));
+                }
+    }
+}
+
+// Copies particles closer than the margin to a side of a periodic axis to the opposite side,
+// so fluid particles near the side find boundary particles of the next period without minimum images
+void addPeriodicImages(const Volume& volume, FLOAT margin, Point3FVector& positions)
+{
+    const Cuboid cuboid = volume.getBoundingCuboid();
+    const FLOAT sides[3] = {cuboid.width, cuboid.length, cuboid.height};
+    const FLOAT starts[3] = {cuboid.startingPoint.x, cuboid.startingPoint.y, cuboid.startingPoint.z};
+
+    const auto coordinate = [](const Point3F& point, size_t axis) {
+        return axis == 0u ? point.x : (axis == 1u ? point.y : point.z);
+    };
+
+    for (size_t axis = 0u; axis < 3u; ++axis)
+    {
+        if (!volume.isPeriodic(axis))
+            continue;
+
+        Point3F shift;
+        (axis == 0u ? shift.x : (axis == 1u ? shift.y : shift.z)) = sides[axis];
+
+        // Images of the previous axes are copied as well, so corners get their diagonal images
+        const size_t particlesNumber = positions.size();
+        for (size_t i = 0u; i < particlesNumber; ++i)
+        {
+            const FLOAT offset = coordinate(positions[i], axis) - starts[axis];
+
+            if (offset < margin)
+                positions.push_back(positions[i] + shift);
+
+            if (offset > sides[axis] - margin)
+                positions.push_back(positions[i] - shift);
+        }
+    }
+}
+
+bool isInside(const Cuboid& cuboid, const Point3F& point)
+{
+    const Point3F offset = point - cuboid.startingPoint;
+    return offset.x >= 0.0 && offset.x <= cuboid.width && offset.y >= 0.0 && offset.y <= cuboid.length &&
+           offset.z >= 0.0 && offset.z <= cuboid.height;
+}
+
+// Projects the grid nodes within half of the spacing from the surface onto it
+void sampleObstacle(const SignedDistanceField& field, const Cuboid& volume, FLOAT spacing, Point3FVector& positions)
+{
+    const Cuboid bounds = field.getBounds();
+
+    const size_t nx = getSamplesNumber(bounds.width, spacing);
+    const size_t ny = getSamplesNumber(bounds.length, spacing);
+    const size_t nz = getSamplesNumber(bounds.height, spacing);
+
+    for (size_t k = 0u; k <= nz; ++k)
+        for (size_t j = 0u; j <= ny; ++j)
+            for (size_t i = 0u; i <= nx; ++i)
+            {
+                const Point3F node = bounds.startingPoint + Point3F(bounds.width * i / nx, bounds.length * j / ny,
+                                                                    bounds.height * k / nz);
+
+                FLOAT distance = 0.0;
+                Point3F gradient;
+
+                if (!field.sample(node, distance, gradient) || std::abs(distance) >= 0.5 * spacing)
+                    continue;
+
+                const FLOAT gradientNorm = gradient.calcNorm();
+                if (!(gradientNorm > 0.0))
+                    continue;
+
+                // The gradient points inside, distance is > 0 inside
+                const Point3F surfacePoint = node - gradient * (distance / gradientNorm);
+
+                if (isInside(volume, surfacePoint))
+                    positions.push_back(surfacePoint);
+            }
+}
+} // namespace
+
+void BoundaryParticles::sample(const Volume&           volume,
+                               const ObstacleScene*    obstacles,
+                               const SimulationParams& params,
+                               ThreadPool*             pool)
+{
+    const Cuboid cuboid = volume.getBoundingCuboid();
+
+    Point3FVector positions;
+    sampleWalls(volume, params.boundarySpacing, positions);
+
+    if (obstacles != nullptr)
+        for (size_t obstacle = 0u; obstacle < obstacles->getObstaclesNumber(); ++obstacle)
+            sampleObstacle(obstacles->getObstacle(obstacle), cuboid, params.boundarySpacing, positions);
+
+    // Images used by fluid particles need their own neighbours for the masses, hence two support radii
+    addPeriodicImages(volume, 2.0 * params.waterSupportRadius, positions);
+
+    setPositions(positions, params, pool);
+}
+
+void BoundaryParticles::setPositions(const Point3FVector& positions, const SimulationParams& params, ThreadPool* pool)
+{
+    m_positions = positions;
+    m_supportRadius = params.waterSupportRadius;
+
+    buildCells();
+    computeMasses(params, pool);
+}
+
+size_t BoundaryParticles::size() const
+{
+    return m_positions.size();
+}
+
+bool BoundaryParticles::empty() const
+{
+    return m_positions.empty();
+}
+
+const Point3FVector& BoundaryParticles::getPositions() const
+{
+    return m_positions;
+}
+
+const std::vector<FLOAT>& BoundaryParticles::getMasses() const
+{
+    return m_masses;
+}
+
+void BoundaryParticles::findNeighbours(const Point3F& point, SizetVector& neighbours) const
+{
+    neighbours.clear();
+
+    if (m_positions.empty())
+        return;
+
+    const FLOAT radiusSqr = m_supportRadius * m_supportRadius;
+    const FLOAT coordinates[3] = {point.x - m_origin.x, point.y - m_origin.y, point.z - m_origin.z};
+
+    // Cells touched by the sphere of the support radius, points far outside of the grid or NaN touch none
+    size_t first[3];
+    size_t last[3];
+
+    for (size_t axis = 0u; axis < 3u; ++axis)
+    {
+        const FLOAT low = std::floor((coordinates[axis] - m_supportRadius) / m_supportRadius);
+        const FLOAT high = std::floor((coordinates[axis] + m_supportRadius) / m_supportRadius);
+        const FLOAT maxCell = static_cast<FLOAT>(m_cellsNumber[axis] - 1u);
+
+        if (!(high >= 0.0 && low <= maxCell))
+            return;
+
+        first[axis] = static_cast<size_t>(std::max<FLOAT>(0.0, low));
+        last[axis] = static_cast<size_t>(std::min(maxCell, high));
+    }
+
+    for (size_t z = first[2]; z <= last[2]; ++z)
+        for (size_t y = first[1]; y <= last[1]; ++y)
+        {
+            const size_t row = (z * m_cellsNumber[1] + y) * m_cellsNumber[0];
+
+            // Cells of a row are adjacent in the sorted arrays
+            for (size_t j = m_cellStarts[row + first[0]]; j < m_cellStarts[row + last[0] + 1u]; ++j)
+                if ((m_positions[j] - point).calcNormSqr() < radiusSqr)
+                    neighbours.push_back(j);
+        }
+}
+
+void BoundaryParticles::buildCells()
+{
+    m_cellStarts.clear();
+
+    if (m_positions.empty())
+        return;
+
+    Point3F min = m_positions.front();
+    Point3F max = m_positions.front();
+
+    for (const Point3F& position : m_positions)
+    {
+        min = Point3F(std::min(min.x, position.x), std::min(min.y, position.y), std::min(min.z, position.z));
+        max = Point3F(std::max(max.x, position.x), std::max(max.y, position.y), std::max(max.z, position.z));
+    }
+
+    m_origin = min;
+    m_cellsNumber[0] = static_cast<size_t>((max.x - min.x) / m_supportRadius) + 1u;
+    m_cellsNumber[1] = static_cast<size_t>((max.y - min.y) / m_supportRadius) + 1u;
+    m_cellsNumber[2] = static_cast<size_t>((max.z - min.z) / m_supportRadius) + 1u;
+
+    // Counting sort by cells
+    const size_t cellsNumber = m_cellsNumber[0] * m_cellsNumber[1] * m_cellsNumber[2];
+    m_cellStarts.assign(cellsNumber + 1u, 0u);
+
+    SizetVector cells(m_positions.size());
+    for (size_t i = 0u; i < m_positions.size(); ++i)
+    {
+        cells[i] = getCellIndex(m_positions[i]);
+        ++m_cellStarts[cells[i] + 1u];
+    }
+
+    for (size_t cell = 0u; cell < cellsNumber; ++cell)
+        m_cellStarts[cell + 1u] += m_cellStarts[cell];
+
+    SizetVector next(m_cellStarts.begin(), m_cellStarts.end() - 1);
+    Point3FVector sorted(m_positions.size());
+
+    for (size_t i = 0u; i < m_positions.size(); ++i)
+        sorted[next[cells[i]]++] = m_positions[i];
+
+    m_positions.swap(sorted);
+}
+
+void BoundaryParticles::computeMasses(const SimulationParams& params, ThreadPool* pool)
+{
+    m_masses.assign(m_positions.size(), 0.0);
+
+    const auto computeRange = [this, &params](size_t begin, size_t end) {
+        SizetVector neighbours;
+
+        for (size_t i = begin; i < end; ++i)
+        {
+            findNeighbours(m_positions[i], neighbours);
+
+            // The particle itself is among its neighbours, so the sum is > 0
+            FLOAT kernelSum = 0.0;
+            for (const size_t j : neighbours)
+                kernelSum += densityKernel(params, (m_positions[i] - m_positions[j]).calcNormSqr());
+
+            m_masses[i] = params.waterDensity / kernelSum;
+        }
+    };
+
+    if (pool != nullptr)
+        pool->parallelFor(0u, m_positions.size(), computeRange);
+    else
+        computeRange(0u, m_positions.size());
+}
+
+size_t BoundaryParticles::getCellIndex(const Point3F& point) const
+{
+    const auto cell = [this](FLOAT coordinate, size_t axis) {
+        const size_t index = static_cast<size_t>(std::max<FLOAT>(0.0, coordinate / m_supportRadius));
+        return std::min(index, m_cellsNumber[axis] - 1u);
+    };
+
+    return cell(point.x - m_origin.x, 0u) +
+           (cell(point.y - m_origin.y, 1u) + cell(point.z - m_origin.z, 2u) * m_cellsNumber[1]) * m_cellsNumber[0];
+}
+
+} // namespace SPHSDK
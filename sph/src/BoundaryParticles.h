@@ -0,0 +1,91 @@
+/**
+ * @file BoundaryParticles.h
+ * @author Anton Artyukh (artyukhanton@gmail.com)
+ * @date Created Oct 19, 2026
+ **/
+
+#ifndef BOUNDARY_PARTICLES_H_5B0E2D7A41C64F0E9A3D86C1F27B94E3
+#define BOUNDARY_PARTICLES_H_5B0E2D7A41C64F0E9A3D86C1F27B94E3
+
+#include "SimulationParams.h"
+
+#include "algorithms/src/Area.h"
+#include "algorithms/src/Defines.h"
+#include "algorithms/src/ObstacleScene.h"
+
+#include <vector>
+
+namespace SPHSDK
+{
+
+class ThreadPool;
+
+/**
+ * @brief BoundaryParticles class samples the walls of the volume and the surfaces of obstacles
+ * with static particles (Akinci et al. 2012, "Versatile rigid-fluid coupling for incompressible SPH").
+ * Fluid particles near the boundary count them in density and pressure, so there is no density deficit
+ * at the walls, but they are never integrated.
+ *
+ * Particles are sampled once and kept in flat arrays sorted by cells of the support radius,
+ * every particle has the mass psi = rest density / (sum of kernels of its boundary neighbours),
+ * which compensates the irregular sampling of curved surfaces.
+ */
+class BoundaryParticles
+{
+public:
+    /**
+     * @brief Samples the walls of the volume and the obstacles with SimulationParams::boundarySpacing,
+     * obstacle particles are the samples of their fields projected to the surface.
+     * Periodic axes have no walls, particles near their sides are copied to the opposite sides.
+     * @param obstacles    The obstacles, may be nullptr
+     * @param pool         The pool computing masses in parallel, may be nullptr
+     */
+    void sample(const Volume&           volume,
+                const ObstacleScene*    obstacles,
+                const SimulationParams& params,
+                ThreadPool*             pool = nullptr);
+
+    /**
+     * @brief Replaces the particles with the given positions and computes their masses.
+     */
+    void setPositions(const Point3FVector& positions, const SimulationParams& params, ThreadPool* pool = nullptr);
+
+    size_t size() const;
+
+    bool empty() const;
+
+    const Point3FVector& getPositions() const;
+
+    const std::vector<FLOAT>& getMasses() const;
+
+    /**
+     * @brief Replaces neighbours with the indices of particles closer than the support radius to the point.
+     */
+    void findNeighbours(const Point3F& point, SizetVector& neighbours) const;
+
+private:
+    void buildCells();
+
+    void computeMasses(const SimulationParams& params, ThreadPool* pool);
+
+    size_t getCellIndex(const Point3F& point) const;
+
+private:
+    Point3FVector m_positions;
+
+    std::vector<FLOAT> m_masses;
+
+    FLOAT m_supportRadius = 0.0;
+
+    Point3F m_origin;
+
+    // Cells along x, y and z
+    size_t m_cellsNumber[3] = {0u, 0u, 0u};
+
+    // Particles of cell c are m_positions[m_cellStarts[c], m_cellStarts[c + 1])
+    SizetVector m_cellStarts;
+};
+
+} // namespace SPHSDK
+
+#endif // BOUNDARY_PARTICLES_H_5B0E2D7A41C64F0E9A3D86C1F27B94E3
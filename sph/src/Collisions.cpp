@@ -1,24 +1,33 @@
 #include "Collisions.h"
 
-#include "Config.h"
 #include "algorithms/src/Area.h"
 
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#define SPHSDK_COLLISIONS_SSE2
+#include <emmintrin.h>
+#endif
+
 
 namespace SPHSDK
 {
 
 // (Formula 4.35)
-static FLOAT calculateF(const Point3F& differenceParticleNeighbour)
+static FLOAT calculateF(const Point3F& differenceParticleNeighbour, FLOAT particleRadius)
 {
-    return differenceParticleNeighbour.calcNormSqr() - Config::ParticleRadius * Config::ParticleRadius;
+    return differenceParticleNeighbour.calcNormSqr() - particleRadius * particleRadius;
 }
 
 // (Formula 4.36)
 static Point3F calculateContactPoint(const Point3F& particlePosition,
-                                     const Point3F& differenceParticleNeighbour)
+                                     const Point3F& differenceParticleNeighbour,
+                                     FLOAT          particleRadius)
 {
     const FLOAT particleDistance = differenceParticleNeighbour.calcNorm();
-    return particlePosition + (differenceParticleNeighbour / particleDistance) * Config::ParticleRadius;
+    return particlePosition + (differenceParticleNeighbour / particleDistance) * particleRadius;
 }
 
 // (Formula 4.38)
@@ -38,81 +47,431 @@ static Point3F calculateVelocity(const Point3F& particleVelocity,
     return particleVelocity - differenceParticleNeighbour * 2 * scalarProduct;
 }
 
-void Collision::detectCollisions(ParticleVect&                                    particleVect,
-                                 const Volume&                                    volume,
-                                 const std::function<FLOAT(FLOAT, FLOAT, FLOAT)>* obstacle)
+// Step of central differences of obstacle functions
+static const FLOAT ObstacleGradientStep = 1e-5;
+
+// Projections of a particle towards the obstacle surface before it falls back to its previous position
+static const size_t ObstacleProjectionIterations = 4u;
+
+// Distance outside of the obstacle surface a particle is projected to
+static const FLOAT ObstacleSkin = 1e-6;
+
+// Share of the distance to the surface a swept particle advances by, interpolated fields only estimate it
+static const FLOAT SweepSafetyFactor = 0.9;
+
+// The shortest step of a swept particle in voxels, so sweeping along the surface ends
+static const FLOAT SweepMinStep = 0.25;
+
+static FLOAT dot(const Point3F& a, const Point3F& b)
 {
-    for (size_t i = 0; i < particleVect.size(); i++)
+    return a.x * b.x + a.y * b.y + a.z * b.z;
+}
+
+/**
+ * Returns false if the position is outside of the obstacle, otherwise its depth estimated as f / |grad f|
+ * and the unit gradient pointing into the obstacle, zero if the gradient is unknown.
+ */
+static bool findPenetration(const std::function<FLOAT(FLOAT, FLOAT, FLOAT)>* obstacle,
+                            const Point3F&                                   position,
+                            FLOAT&                                           depth,
+                            Point3F&                                         gradient)
+{
+    if (obstacle == nullptr)
+        return false;
+
+    const auto& f = *obstacle;
+    const FLOAT value = f(position.x, position.y, position.z);
+    if (!(value > 0.0))
+        return false;
+
+    const FLOAT h = ObstacleGradientStep;
+    gradient = Point3F(f(position.x + h, position.y, position.z) - f(position.x - h, position.y, position.z),
+                       f(position.x, position.y + h, position.z) - f(position.x, position.y - h, position.z),
+                       f(position.x, position.y, position.z + h) - f(position.x, position.y, position.z - h)) /
+               (2.0 * h);
+
+    const FLOAT gradientNorm = gradient.calcNorm();
+    if (gradientNorm > 0.0)
+    {
+        depth = value / gradientNorm;
+        gradient = gradient / gradientNorm;
+    }
+    else
     {
-        /* Particle Collision */
+        depth = 0.0;
+        gradient = Point3F();
+    }
 
-        for (size_t j = 0; j < particleVect[i].neighbours.size(); j++)
-        {
-            Point3F differenceParticleNeighbour =
-                particleVect[i].position - particleVect[particleVect[i].neighbours[j]].position;
+    return true;
+}
 
-            // (Formula 4.35)
-            if (calculateF(differenceParticleNeighbour) < 0)
-            {
-                const Point3 surfaceNormal = calculateSurfaceNormal(differenceParticleNeighbour);
+static bool findPenetration(const ObstacleScene* obstacles, const Point3F& position, FLOAT& depth, Point3F& gradient)
+{
+    if (obstacles == nullptr)
+        return false;
 
-                // (Formula 4.55)
-                particleVect[i].position = calculateContactPoint(particleVect[i].position, differenceParticleNeighbour);
+    // Particles in bricks far from the surface are not interpolated, their gradient stays zero
+    obstacles->sample(position, depth, gradient);
+    if (!(depth > 0.0))
+        return false;
 
-                // (Formula 4.56)
-                particleVect[i].velocity = calculateVelocity(particleVect[i].velocity, surfaceNormal);
-            }
-        }
+    const FLOAT gradientNorm = gradient.calcNorm();
+    if (gradientNorm > 0.0)
+        gradient = gradient / gradientNorm;
 
-        /* Boundary Collision */
+    return true;
+}
 
-        const Cuboid cuboid = volume.getBoundingCuboid();
+/**
+ * Moves a penetrating particle to the obstacle surface along the gradient and reflects its normal velocity
+ * with restitution, friction takes away tangential velocity proportionally to the normal impulse (Coulomb).
+ * Falls back to the previous position if the gradient is unknown or the projection does not leave the obstacle.
+ */
+template <class Obstacle>
+static void resolveObstacleCollision(const Obstacle*         obstacle,
+                                     const Point3F&          previousPosition,
+                                     const SimulationParams& params,
+                                     Point3F&                position,
+                                     Point3F&                velocity)
+{
+    FLOAT depth = 0.0;
+    Point3F gradient;
 
-        if (particleVect[i].position.x > cuboid.width - particleVect[i].radius)
-        {
-            particleVect[i].position.x = cuboid.width - particleVect[i].radius;
-            particleVect[i].velocity.x *= Config::CollisionVelocityMultiplier;
-        }
+    if (!findPenetration(obstacle, position, depth, gradient))
+        return;
 
-        if (particleVect[i].position.x < particleVect[i].radius)
-        {
-            particleVect[i].position.x = particleVect[i].radius;
-            particleVect[i].velocity.x *= Config::CollisionVelocityMultiplier;
-        }
+    Point3F normal;
+    bool isProjected = false;
 
-        if (particleVect[i].position.y > cuboid.length - particleVect[i].radius)
-        {
-            particleVect[i].position.y = cuboid.length - particleVect[i].radius;
-            particleVect[i].velocity.y *= Config::CollisionVelocityMultiplier;
-        }
+    for (size_t iteration = 0u; iteration < ObstacleProjectionIterations && gradient.calcNormSqr() > 0.0; ++iteration)
+    {
+        normal = -gradient;
+        position += normal * (depth + ObstacleSkin);
 
-        if (particleVect[i].position.y < particleVect[i].radius)
+        if (!findPenetration(obstacle, position, depth, gradient))
         {
-            particleVect[i].position.y = particleVect[i].radius;
-            particleVect[i].velocity.y *= Config::CollisionVelocityMultiplier;
+            isProjected = true;
+            break;
         }
+    }
 
-        if (particleVect[i].position.z > cuboid.height - particleVect[i].radius)
-        {
-            particleVect[i].position.z = cuboid.height - particleVect[i].radius;
-            particleVect[i].velocity.z *= Config::CollisionVelocityMultiplier;
-        }
+    if (!isProjected)
+    {
+        position = previousPosition;
+        velocity *= params.collisionVelocityMultiplier;
+        return;
+    }
+
+    const FLOAT normalSpeed = dot(velocity, normal);
+    if (normalSpeed >= 0.0)
+        return;
+
+    const Point3F normalVelocity = normal * normalSpeed;
+    const Point3F tangentVelocity = velocity - normalVelocity;
+    const FLOAT tangentSpeed = tangentVelocity.calcNorm();
 
-        if (particleVect[i].position.z < particleVect[i].radius)
+    const FLOAT normalImpulse = -(1.0 + params.obstacleRestitution) * normalSpeed;
+    const FLOAT tangentMultiplier =
+        tangentSpeed > 0.0 ? std::max(0.0, 1.0 - params.obstacleFriction * normalImpulse / tangentSpeed) : 0.0;
+
+    velocity = tangentVelocity * tangentMultiplier - normalVelocity * params.obstacleRestitution;
+}
+
+/**
+ * Sphere-traces the segment from the previous position to the position through the obstacle fields.
+ * A point outside of the fields or their bands is at least the band width away from any surface,
+ * so every step advances by the known distance to the nearest surface.
+ * The first point inside an obstacle replaces the position, then resolveObstacleCollision() pushes the particle
+ * out of the surface it crossed first instead of the one it ended behind.
+ */
+static void sweepObstacles(const ObstacleScene*    obstacles,
+                           const Volume&           volume,
+                           const Point3F&          previousPosition,
+                           const SimulationParams& params,
+                           Point3F&                position)
+{
+    if (obstacles == nullptr)
+        return;
+
+    // Along periodic axes the position may be already wrapped to the other side
+    Point3F displacement = position - previousPosition;
+    if (volume.hasPeriodicAxes())
+        displacement = volume.getMinimumImage(displacement);
+
+    const FLOAT length = displacement.calcNorm();
+    if (!(length > params.sweptCollisionDistance))
+        return;
+
+    const Point3F direction = displacement / length;
+    const FLOAT minStep = SweepMinStep * params.obstacleCellSize;
+
+    // The end point is checked by resolveObstacleCollision()
+    for (FLOAT t = 0.0; t < length;)
+    {
+        Point3F point = previousPosition + direction * t;
+        if (volume.hasPeriodicAxes())
+            point = volume.wrapPosition(point);
+
+        FLOAT distance = 0.0;
+        Point3F gradient;
+        obstacles->sample(point, distance, gradient);
+
+        if (distance > 0.0)
         {
-            particleVect[i].position.z = particleVect[i].radius;
-            particleVect[i].velocity.z *= Config::CollisionVelocityMultiplier;
+            position = point;
+            return;
         }
 
-        /* Obstacle collision */
+        t += std::max(SweepSafetyFactor * std::min(-distance, params.obstacleBandWidth), minStep);
+    }
+}
+
+/**
+ * Resolves collisions of a particle with candidates read from source, the result is written to position and velocity.
+ * They may refer to the particle in source itself, then the particle is resolved in place.
+ */
+static void resolveParticleCollisions(const ParticleVect&     source,
+                                      const SizetVector&      candidates,
+                                      const Volume&           volume,
+                                      const SimulationParams& params,
+                                      Point3F&                position,
+                                      Point3F&                velocity)
+{
+    const bool hasPeriodicAxes = volume.hasPeriodicAxes();
+
+    for (size_t j = 0; j < candidates.size(); j++)
+    {
+        Point3F differenceParticleNeighbour = position - source[candidates[j]].position;
+        if (hasPeriodicAxes)
+            differenceParticleNeighbour = volume.getMinimumImage(differenceParticleNeighbour);
 
-        if (obstacle != nullptr &&
-            (*obstacle)(static_cast<FLOAT>(particleVect[i].position.x), static_cast<FLOAT>(particleVect[i].position.y),
-                        static_cast<FLOAT>(particleVect[i].position.z)) > 0.f)
+        // (Formula 4.35)
+        if (calculateF(differenceParticleNeighbour, params.particleRadius) < 0)
         {
-            particleVect[i].position = particleVect[i].previous_position;
-            particleVect[i].velocity *= Config::CollisionVelocityMultiplier;
+            const Point3 surfaceNormal = calculateSurfaceNormal(differenceParticleNeighbour);
+
+            // (Formula 4.55)
+            position = calculateContactPoint(position, differenceParticleNeighbour, params.particleRadius);
+
+            // (Formula 4.56)
+            velocity = calculateVelocity(velocity, surfaceNormal);
         }
     }
 }
+
+#ifdef SPHSDK_COLLISIONS_SSE2
+static_assert(std::is_same<FLOAT, double>::value, "SSE2 wall clamp works with two doubles per register");
+
+// Bitwise select, the masks are results of comparisons
+static inline __m128d selectBits(__m128d mask, __m128d ifTrue, __m128d ifFalse)
+{
+    return _mm_or_pd(_mm_and_pd(mask, ifTrue), _mm_andnot_pd(mask, ifFalse));
+}
+#endif
+
+/**
+ * Clamps coordinates of one axis to side - radius and then to radius, every clamp multiplies the velocity,
+ * so particles wider than the side are clamped and slowed twice. NaN coordinates are left as they are.
+ * Compare masks select the results instead of branches. Compilers do not vectorise the scalar loop
+ * on their own, so pairs of particles go through SSE2 explicitly where it is available.
+ */
+static void clampAxis(FLOAT* coordinates, FLOAT* velocities, const FLOAT* radii, size_t size, FLOAT side,
+                      FLOAT velocityMultiplier)
+{
+    size_t i = 0u;
+
+#ifdef SPHSDK_COLLISIONS_SSE2
+    const __m128d sides = _mm_set1_pd(side);
+    const __m128d multipliers = _mm_set1_pd(velocityMultiplier);
+    const __m128d ones = _mm_set1_pd(1.0);
+
+    for (; i + 2u <= size; i += 2u)
+    {
+        const __m128d coordinate = _mm_loadu_pd(coordinates + i);
+        const __m128d radius = _mm_loadu_pd(radii + i);
+        const __m128d maxCoordinate = _mm_sub_pd(sides, radius);
+
+        const __m128d isAboveMax = _mm_cmpgt_pd(coordinate, maxCoordinate);
+        const __m128d belowMax = selectBits(isAboveMax, maxCoordinate, coordinate);
+        const __m128d isBelowMin = _mm_cmplt_pd(belowMax, radius);
+
+        const __m128d multiplier =
+            _mm_mul_pd(selectBits(isAboveMax, multipliers, ones), selectBits(isBelowMin, multipliers, ones));
+
+        _mm_storeu_pd(velocities + i, _mm_mul_pd(_mm_loadu_pd(velocities + i), multiplier));
+        _mm_storeu_pd(coordinates + i, selectBits(isBelowMin, radius, belowMax));
+    }
+#endif
+
+    for (; i < size; ++i)
+    {
+        const FLOAT coordinate = coordinates[i];
+        const FLOAT radius = radii[i];
+        const FLOAT maxCoordinate = side - radius;
+
+        const bool isAboveMax = coordinate > maxCoordinate;
+        const FLOAT belowMax = isAboveMax ? maxCoordinate : coordinate;
+        const bool isBelowMin = belowMax < radius;
+
+        velocities[i] *= (isAboveMax ? velocityMultiplier : 1.0) * (isBelowMin ? velocityMultiplier : 1.0);
+        coordinates[i] = isBelowMin ? radius : belowMax;
+    }
+}
+
+/**
+ * Moves coordinates of a periodic axis into the cuboid of the volume.
+ */
+static void wrapAxis(FLOAT* coordinates, size_t size, const Volume& volume, size_t axis)
+{
+    for (size_t i = 0u; i < size; ++i)
+        coordinates[i] = volume.wrapCoordinate(axis, coordinates[i]);
+}
+
+/**
+ * Wraps coordinates of periodic axes and clamps the others by the walls.
+ */
+static void constrainAxis(FLOAT* coordinates, FLOAT* velocities, const FLOAT* radii, size_t size, FLOAT side,
+                          const Volume& volume, size_t axis, FLOAT velocityMultiplier)
+{
+    if (volume.isPeriodic(axis))
+        wrapAxis(coordinates, size, volume, axis);
+    else
+        clampAxis(coordinates, velocities, radii, size, side, velocityMultiplier);
+}
+
+/**
+ * Copies positions and velocities of the given particles into components.
+ */
+static void loadComponents(const SizetVector&              particleIndices,
+                           const ParticleVect&             particleVect,
+                           const CollisionBuffers::Points& positions,
+                           const CollisionBuffers::Points& velocities,
+                           ParticleComponents&             components)
+{
+    components.resize(particleIndices.size());
+
+    for (size_t k = 0u; k < particleIndices.size(); ++k)
+    {
+        const size_t i = particleIndices[k];
+
+        components.x[k] = positions[i].x;
+        components.y[k] = positions[i].y;
+        components.z[k] = positions[i].z;
+        components.velocityX[k] = velocities[i].x;
+        components.velocityY[k] = velocities[i].y;
+        components.velocityZ[k] = velocities[i].z;
+        components.radius[k] = particleVect[i].radius;
+    }
+}
+
+void Collision::detectCollisions(ParticleVect&                                    particleVect,
+                                 const Volume&                                    volume,
+                                 const std::function<FLOAT(FLOAT, FLOAT, FLOAT)>* obstacle,
+                                 const SimulationParams&                          params)
+{
+    const Cuboid cuboid = volume.getBoundingCuboid();
+
+    // Later particles see the walls applied to earlier ones, so every particle is clamped on its own
+    for (size_t i = 0; i < particleVect.size(); i++)
+    {
+        Particle& particle = particleVect[i];
+
+        resolveParticleCollisions(particleVect, particle.neighbours, volume, params, particle.position,
+                                  particle.velocity);
+
+        constrainAxis(&particle.position.x, &particle.velocity.x, &particle.radius, 1u, cuboid.width,
+                      volume, 0u, params.collisionVelocityMultiplier);
+        constrainAxis(&particle.position.y, &particle.velocity.y, &particle.radius, 1u, cuboid.length,
+                      volume, 1u, params.collisionVelocityMultiplier);
+        constrainAxis(&particle.position.z, &particle.velocity.z, &particle.radius, 1u, cuboid.height,
+                      volume, 2u, params.collisionVelocityMultiplier);
+
+        resolveObstacleCollision(obstacle, particle.previous_position, params, particle.position, particle.velocity);
+    }
+}
+
+void Collision::gatherCollisions(const ParticleVect&         particleVect,
+                                 const SizetVector&          particleIndices,
+                                 const VectorOfSizetVectors& candidates,
+                                 const Volume&               volume,
+                                 const ObstacleScene*        obstacles,
+                                 const SimulationParams&     params,
+                                 CollisionBuffers&           buffers)
+{
+    for (const size_t i : particleIndices)
+    {
+        buffers.positions[i] = particleVect[i].position;
+        buffers.velocities[i] = particleVect[i].velocity;
+
+        resolveParticleCollisions(particleVect, candidates[i], volume, params, buffers.positions[i],
+                                  buffers.velocities[i]);
+    }
+
+    // The walls are a separate pass over the components of the particles,
+    // reused by the blocks of the thread, so vectors grow to the largest block once
+    thread_local ParticleComponents components;
+    loadComponents(particleIndices, particleVect, buffers.positions, buffers.velocities, components);
+
+    clampToVolume(components, volume, params.collisionVelocityMultiplier);
+
+    for (size_t k = 0u; k < particleIndices.size(); ++k)
+    {
+        const size_t i = particleIndices[k];
+
+        buffers.positions[i] = Point3F(components.x[k], components.y[k], components.z[k]);
+        buffers.velocities[i] = Point3F(components.velocityX[k], components.velocityY[k], components.velocityZ[k]);
+
+        if (params.sweptCollisions)
+            sweepObstacles(obstacles, volume, particleVect[i].previous_position, params, buffers.positions[i]);
+
+        resolveObstacleCollision(obstacles, particleVect[i].previous_position, params, buffers.positions[i],
+                                 buffers.velocities[i]);
+    }
+}
+
+void Collision::clampToVolume(ParticleComponents& components, const Volume& volume, FLOAT collisionVelocityMultiplier)
+{
+    const Cuboid cuboid = volume.getBoundingCuboid();
+    const size_t size = components.size();
+
+    constrainAxis(components.x.data(), components.velocityX.data(), components.radius.data(), size, cuboid.width,
+                  volume, 0u, collisionVelocityMultiplier);
+    constrainAxis(components.y.data(), components.velocityY.data(), components.radius.data(), size, cuboid.length,
+                  volume, 1u, collisionVelocityMultiplier);
+    constrainAxis(components.z.data(), components.velocityZ.data(), components.radius.data(), size, cuboid.height,
+                  volume, 2u, collisionVelocityMultiplier);
+}
+
+void Collision::applyCollisions(ParticleVect&           particleVect,
+                                const SizetVector&      particleIndices,
+                                const CollisionBuffers& buffers)
+{
+    for (const size_t i : particleIndices)
+    {
+        particleVect[i].position = buffers.positions[i];
+        particleVect[i].velocity = buffers.velocities[i];
+    }
+}
+
+void CollisionBuffers::resize(size_t particlesNumber)
+{
+    positions.resize(particlesNumber);
+    velocities.resize(particlesNumber);
+}
+
+void ParticleComponents::resize(size_t particlesNumber)
+{
+    x.resize(particlesNumber);
+    y.resize(particlesNumber);
+    z.resize(particlesNumber);
+    velocityX.resize(particlesNumber);
+    velocityY.resize(particlesNumber);
+    velocityZ.resize(particlesNumber);
+    radius.resize(particlesNumber);
+}
+
+size_t ParticleComponents::size() const
+{
+    return x.size();
+}
 } // namespace SPHSDK
@@ -8,9 +8,12 @@
 #define COLLISIONS_H_73C34465A6ED4DB9B9F2F4C3937BF5DC
 
 #include "Particle.h"
+#include "SimulationParams.h"
 #include "algorithms/src/Defines.h"
+#include "algorithms/src/ObstacleScene.h"
 
 #include <functional>
+#include <vector>
 
 namespace SPHSDK
 {
@@ -18,13 +21,92 @@ class Area;
 class Volume;
 
 
+/**
+ * @brief Positions and velocities resolved by Collision::gatherCollisions(), one element per particle.
+ * They use FirstTouchAllocator like the particles, so they may be placed by the workers of the particles.
+ */
+struct CollisionBuffers
+{
+    using Points = std::vector<Point3F, FirstTouchAllocator<Point3F>>;
+
+    void resize(size_t particlesNumber);
+
+    Points positions;
+    Points velocities;
+};
+
+/**
+ * @brief Positions, velocities and radii of a group of particles stored by components,
+ * so passes over them are plain loops over arrays which load several particles into one SIMD register.
+ */
+struct ParticleComponents
+{
+    void resize(size_t particlesNumber);
+
+    size_t size() const;
+
+    std::vector<FLOAT> x;
+    std::vector<FLOAT> y;
+    std::vector<FLOAT> z;
+
+    std::vector<FLOAT> velocityX;
+    std::vector<FLOAT> velocityY;
+    std::vector<FLOAT> velocityZ;
+
+    std::vector<FLOAT> radius;
+};
+
 class Collision
 {
 
 public:
+    /**
+     * @brief Resolves collisions of all particles one by one in place against their neighbours,
+     * later particles see already moved ones, so the result depends on the order of particles.
+     * Along periodic axes of the volume particles collide with the nearest images of neighbours and are wrapped.
+     * Particles which entered the obstacle are projected to its surface along the gradient of the function,
+     * their normal velocity is reflected with SimulationParams::obstacleRestitution and obstacleFriction.
+     */
     static void detectCollisions(ParticleVect& particleVect,
                                  const Volume& volume,
-                                 const std::function<FLOAT(FLOAT, FLOAT, FLOAT)>* obstacle = nullptr);
+                                 const std::function<FLOAT(FLOAT, FLOAT, FLOAT)>* obstacle = nullptr,
+                                 const SimulationParams& params = SimulationParams());
+
+    /**
+     * @brief Gather phase of the two-phase resolver.
+     * Resolves collisions of the given particles into buffers reading only their own data
+     * and positions of candidates[i], particle i is tested only against candidates[i],
+     * e.g. neighbours closer than 2 * particleRadius collected by NeighboursSearch3D::searchInBox().
+     * Particles are not changed, so any subsets can be gathered concurrently and in any order.
+     * Obstacles are looked up in their cached distance fields, only those whose grids contain the particle
+     * are sampled and particles far from their surfaces skip the interpolation.
+     * With SimulationParams::sweptCollisions particles which moved farther than sweptCollisionDistance
+     * are sphere-traced from their previous positions, so they stop at the first surface they crossed.
+     */
+    static void gatherCollisions(const ParticleVect&         particleVect,
+                                 const SizetVector&          particleIndices,
+                                 const VectorOfSizetVectors& candidates,
+                                 const Volume&               volume,
+                                 const ObstacleScene*        obstacles,
+                                 const SimulationParams&     params,
+                                 CollisionBuffers&           buffers);
+
+    /**
+     * @brief Keeps particles inside the cuboid [0, width] x [0, length] x [0, height] of the volume
+     * shrunk by their radii, the velocity component of every clamped coordinate is multiplied by collisionVelocityMultiplier.
+     * Coordinates of periodic axes are wrapped into the cuboid instead.
+     * The clamp is branchless (compare masks and selects) and runs on two particles at a time with SSE2,
+     * the scalar loop handles the rest and targets without SSE2.
+     */
+    static void clampToVolume(ParticleComponents& components, const Volume& volume, FLOAT collisionVelocityMultiplier);
+
+    /**
+     * @brief Apply phase of the two-phase resolver, copies gathered positions and velocities to the particles.
+     * Must start only when every gather reading the given particles is finished.
+     */
+    static void applyCollisions(ParticleVect&           particleVect,
+                                const SizetVector&      particleIndices,
+                                const CollisionBuffers& buffers);
 };
 
 } // namespace SPHSDK
@@ -20,11 +20,20 @@ namespace SPHSDK
     const FLOAT Config::WaterSurfaceTension = 0.0728;
 
     const Point3F Config::InitialGravitationalAcceleration(0.0, 0.0, -9.82);
-    Point3F Config::GravitationalAcceleration(0.0, 0.0, -9.82);
     const Point3F Config::InitialVelocity(0.0, 0.0, 0.0);
     const FLOAT Config::CollisionVelocityMultiplier = -0.5;
 
     const FLOAT Config::SpeedTreshold = 3.0;
 
+    const FLOAT Config::TimeStep = 0.01;
+
     const FLOAT Config::CubeSize = 3.0;
+
+    const FLOAT Config::ObstacleCellSize = 0.02;
+    const FLOAT Config::ObstacleBandWidth = 0.08;
+    const FLOAT Config::ObstacleRestitution = 0.5;
+    const FLOAT Config::ObstacleFriction = 0.1;
+    const FLOAT Config::SweptCollisionDistance = 0.01;
+
+    const FLOAT Config::BoundarySpacing = 0.015;
 } //SPHSDK
@@ -21,14 +21,23 @@ struct Config
     static const FLOAT WaterSurfaceTension;
 
     static const Point3F InitialGravitationalAcceleration;
-    static Point3F GravitationalAcceleration;
     static const Point3F InitialVelocity;
     static const FLOAT CollisionVelocityMultiplier;
 
     static const FLOAT SpeedTreshold;
 
+    static const FLOAT TimeStep;
+
     static const FLOAT CubeSize;
 
+    static const FLOAT ObstacleCellSize;
+    static const FLOAT ObstacleBandWidth;
+    static const FLOAT ObstacleRestitution;
+    static const FLOAT ObstacleFriction;
+    static const FLOAT SweptCollisionDistance;
+
+    static const FLOAT BoundarySpacing;
+
 }; //Config
 } //SPHSDK
 
@@ -4,174 +4,238 @@
 #include <cfloat>
 #include <math.h>
 #include <cassert>
+#include <algorithm>
 
 namespace SPHSDK
 {
 
-static const FLOAT PiPowH9 = M_PI * pow(Config::WaterSupportRadius, 9);
-static const FLOAT PiPowH6 = M_PI * pow(Config::WaterSupportRadius, 6);
-static const FLOAT SupportRadiusSqr = Config::WaterSupportRadius * Config::WaterSupportRadius;
-static const FLOAT KernelDefaultMultiplier = 315.0 / (64.0 * PiPowH9);
-static const FLOAT KernelDefaultGradientMultiplier = -945.0 / (32.0 * PiPowH9);
-static const FLOAT KernelPressureGradientMultiplier = -45.0 / PiPowH6;
-static const FLOAT KernelViscosityLaplacianMultiplier = 45.0 / PiPowH6;
-static const FLOAT OwnDensity = 315.0 / (64.0 * M_PI * pow(Config::WaterSupportRadius, 3));
-
-
-static FLOAT defaultKernel(const Point3F& differenceParticleNeighbour) {
+static FLOAT defaultKernel(const SimulationParams& params, const Point3F& differenceParticleNeighbour) {
     // (Formula 4.3)
     const FLOAT particleDistanceSqr = differenceParticleNeighbour.calcNormSqr();
-    return KernelDefaultMultiplier * pow(SupportRadiusSqr - particleDistanceSqr, 3);
+    return params.kernelDefaultMultiplier * pow(params.supportRadiusSqr - particleDistanceSqr, 3);
 }
 
-static Point3F defaultKernelGradient(const Point3F& differenceParticleNeighbour) {
+static Point3F defaultKernelGradient(const SimulationParams& params, const Point3F& differenceParticleNeighbour) {
     // (Formula 4.4)
     const FLOAT particleDistanceSqr = differenceParticleNeighbour.calcNormSqr();
-    return differenceParticleNeighbour * KernelDefaultGradientMultiplier
-                                       * (SupportRadiusSqr - particleDistanceSqr)
-                                       * (SupportRadiusSqr - particleDistanceSqr);
+    return differenceParticleNeighbour * params.kernelDefaultGradientMultiplier
+                                       * (params.supportRadiusSqr - particleDistanceSqr)
+                                       * (params.supportRadiusSqr - particleDistanceSqr);
 }
 
-static FLOAT defaultKernelLaplacian(const Point3F& differenceParticleNeighbour) {
+static FLOAT defaultKernelLaplacian(const SimulationParams& params, const Point3F& differenceParticleNeighbour) {
     // (Formula 4.5)
     const FLOAT particleDistanceSqr = differenceParticleNeighbour.calcNormSqr();
-    return KernelDefaultGradientMultiplier * (SupportRadiusSqr - particleDistanceSqr)
-                                           * (3.0 * SupportRadiusSqr - 7.0 * particleDistanceSqr);
+    return params.kernelDefaultGradientMultiplier * (params.supportRadiusSqr - particleDistanceSqr)
+                                                  * (3.0 * params.supportRadiusSqr - 7.0 * particleDistanceSqr);
 }
 
-static Point3F pressureKernelGradient(const Point3F& differenceParticleNeighbour) {
+static Point3F pressureKernelGradient(const SimulationParams& params, const Point3F& differenceParticleNeighbour) {
     // (Formula 4.14)
     const FLOAT particleDistance = differenceParticleNeighbour.calcNorm();
-    return differenceParticleNeighbour * KernelPressureGradientMultiplier / particleDistance
-                                       * (Config::WaterSupportRadius - particleDistance)
-                                       * (Config::WaterSupportRadius - particleDistance);
+    return differenceParticleNeighbour * params.kernelPressureGradientMultiplier / particleDistance
+                                       * (params.waterSupportRadius - particleDistance)
+                                       * (params.waterSupportRadius - particleDistance);
 }
 
-static FLOAT viscosityKernelLaplacian(const Point3F& differenceParticleNeighbour) {
+static FLOAT viscosityKernelLaplacian(const SimulationParams& params, const Point3F& differenceParticleNeighbour) {
     // (Formula 4.22)
     const FLOAT particleDistance = differenceParticleNeighbour.calcNorm();
-    return KernelViscosityLaplacianMultiplier * (Config::WaterSupportRadius - particleDistance);
+    return params.kernelViscosityLaplacianMultiplier * (params.waterSupportRadius - particleDistance);
+}
+
+// Along periodic axes the nearest image of the neighbour is taken
+static Point3F getDifference(const Volume& volume, const Point3F& position, const Point3F& neighbourPosition)
+{
+    const Point3F difference = position - neighbourPosition;
+
+    return volume.hasPeriodicAxes() ? volume.getMinimumImage(difference) : difference;
 }
 
-void Forces::ComputeDensity(ParticleVect& particleVect)
+static void computeDensity(ParticleVect& particleVect, size_t i, const SimulationParams& params,
+                           const Volume& volume)
 {
     // (Formula 4.6)
-    for (size_t i = 0; i < particleVect.size(); i++)
-    {
-        particleVect[i].density = OwnDensity;
+    particleVect[i].density = params.ownDensity;
 
-        for (size_t j = 0; j < particleVect[i].neighbours.size(); j++)
-        {
-            const Point3F differenceParticleNeighbour =
-                particleVect[i].position - particleVect[particleVect[i].neighbours[j]].position;
+    for (size_t j = 0; j < particleVect[i].neighbours.size(); j++)
+    {
+        const Point3F differenceParticleNeighbour =
+            getDifference(volume, particleVect[i].position, particleVect[particleVect[i].neighbours[j]].position);
 
-            if (Config::WaterSupportRadius - differenceParticleNeighbour.calcNorm() > DBL_EPSILON)
-                particleVect[i].density += Config::WaterParticleMass * defaultKernel(differenceParticleNeighbour);
-        }
+        if (params.waterSupportRadius - differenceParticleNeighbour.calcNorm() > DBL_EPSILON)
+            particleVect[i].density += params.waterParticleMass * defaultKernel(params, differenceParticleNeighbour);
     }
 }
 
-void Forces::ComputePressure(ParticleVect& particleVect)
+// (Akinci et al. 2012, Formula 6) Boundary particle b adds psi_b * W(x_i - x_b)
+static void computeBoundaryDensity(ParticleVect&            particleVect,
+                                   size_t                   i,
+                                   const SimulationParams&  params,
+                                   const BoundaryParticles& boundaryParticles)
+{
+    const Point3FVector& positions = boundaryParticles.getPositions();
+    const std::vector<FLOAT>& masses = boundaryParticles.getMasses();
+
+    for (const size_t b : particleVect[i].boundaryNeighbours)
+        particleVect[i].density += masses[b] * defaultKernel(params, particleVect[i].position - positions[b]);
+}
+
+static void computePressure(Particle& particle, const SimulationParams& params)
 {
     // (Formula 4.12)
-    for (auto& particle : particleVect)
-    {
-        particle.pressure = Config::WaterStiffness * (particle.density - Config::WaterDensity);
-    }
+    particle.pressure = params.waterStiffness * (particle.density - params.waterDensity);
 }
 
-void Forces::ComputeInternalForces(ParticleVect& particleVect)
+static void computeInternalForces(ParticleVect& particleVect, size_t i, const SimulationParams& params,
+                                  const Volume& volume)
 {
-    for (size_t i = 0; i < particleVect.size(); i++)
+    particleVect[i].fPressure = Point3F();
+    particleVect[i].fViscosity = Point3F();
+
+    for (size_t j = 0; j < particleVect[i].neighbours.size(); j++)
     {
-        particleVect[i].fPressure = Point3F();
-        particleVect[i].fViscosity = Point3F();
+        assert(std::abs(particleVect[i].density) > 0.);
+        assert(std::abs(particleVect[particleVect[i].neighbours[j]].density) > 0.);
+
+        const Point3F differenceParticleNeighbour =
+            getDifference(volume, particleVect[i].position, particleVect[particleVect[i].neighbours[j]].position);
+
+        const FLOAT particleDistance = differenceParticleNeighbour.calcNorm();
 
-        for (size_t j = 0; j < particleVect[i].neighbours.size(); j++)
+        if (std::abs(particleDistance) > 0.)
         {
-            assert(std::abs(particleVect[i].density) > 0.);
-            assert(std::abs(particleVect[particleVect[i].neighbours[j]].density) > 0.);
-
-            const Point3F differenceParticleNeighbour =
-                particleVect[i].position - particleVect[particleVect[i].neighbours[j]].position;
-
-            const FLOAT particleDistance = differenceParticleNeighbour.calcNorm();
-
-            if (std::abs(particleDistance) > 0.)
-            {
-                const FLOAT dividedMassDensity =
-                    Config::WaterParticleMass / particleVect[particleVect[i].neighbours[j]].density;
-
-                // (Formulae 4.11 & 4.14)
-                particleVect[i].fPressure +=
-                    pressureKernelGradient(differenceParticleNeighbour) *
-                    (particleVect[i].pressure + particleVect[particleVect[i].neighbours[j]].pressure) *
-                    dividedMassDensity;
-
-                // (Formulae 4.17 & 4.22)
-                particleVect[i].fViscosity +=
-                    (particleVect[particleVect[i].neighbours[j]].velocity - particleVect[i].velocity) *
-                    viscosityKernelLaplacian(differenceParticleNeighbour) * dividedMassDensity;
-            }
+            const FLOAT dividedMassDensity =
+                params.waterParticleMass / particleVect[particleVect[i].neighbours[j]].density;
+
+            // (Formulae 4.11 & 4.14)
+            particleVect[i].fPressure +=
+                pressureKernelGradient(params, differenceParticleNeighbour) *
+                (particleVect[i].pressure + particleVect[particleVect[i].neighbours[j]].pressure) *
+                dividedMassDensity;
+
+            // (Formulae 4.17 & 4.22)
+            particleVect[i].fViscosity +=
+                (particleVect[particleVect[i].neighbours[j]].velocity - particleVect[i].velocity) *
+                viscosityKernelLaplacian(params, differenceParticleNeighbour) * dividedMassDensity;
         }
+    }
 
-        particleVect[i].fPressure *= -0.5;
-        particleVect[i].fViscosity *= Config::WaterViscosity;
+    particleVect[i].fPressure *= -0.5;
+    particleVect[i].fViscosity *= params.waterViscosity;
 
-        particleVect[i].fInternal = particleVect[i].fPressure + particleVect[i].fViscosity;
-    }
+    particleVect[i].fInternal = particleVect[i].fPressure + particleVect[i].fViscosity;
 }
 
-void Forces::ComputeGravityForce(ParticleVect& particleVect)
+// (Akinci et al. 2012, Formula 10) Pressure of boundary particle b mirrors the particle, density of b is the rest one
+static void computeBoundaryPressureForce(ParticleVect&            particleVect,
+                                         size_t                   i,
+                                         const SimulationParams&  params,
+                                         const BoundaryParticles& boundaryParticles)
 {
-    for (auto& particle : particleVect)
+    const Point3FVector& positions = boundaryParticles.getPositions();
+    const std::vector<FLOAT>& masses = boundaryParticles.getMasses();
+
+    // Negative pressure would glue particles to the walls
+    const FLOAT pressure = std::max<FLOAT>(0.0, particleVect[i].pressure);
+
+    Point3F fPressure;
+
+    for (const size_t b : particleVect[i].boundaryNeighbours)
     {
-        particle.fGravity = Config::GravitationalAcceleration * particle.density;
+        const Point3F differenceParticleBoundary = particleVect[i].position - positions[b];
+
+        if (differenceParticleBoundary.calcNormSqr() > 0.0)
+            fPressure += pressureKernelGradient(params, differenceParticleBoundary) * masses[b];
     }
+
+    fPressure *= -pressure / params.waterDensity;
+
+    particleVect[i].fPressure += fPressure;
+    particleVect[i].fInternal += fPressure;
 }
 
-void Forces::ComputeSurfaceTension(ParticleVect& particleVect)
+static void computeGravityForce(Particle& particle, const SimulationParams& params)
 {
-    for (size_t i = 0; i < particleVect.size(); i++)
+    particle.fGravity = params.gravitationalAcceleration * particle.density;
+}
+
+static void computeSurfaceTension(ParticleVect& particleVect, size_t i, const SimulationParams& params,
+                                  const Volume& volume)
+{
+    particleVect[i].fSurfaceTension = Point3F();
+
+    Point3F surfaceTensionGradient = Point3F();
+    FLOAT surfaceTensionLaplacian = 0.0;
+
+    for (size_t j = 0; j < particleVect[i].neighbours.size(); j++)
     {
-        particleVect[i].fSurfaceTension = Point3F();
+        assert(std::abs(particleVect[i].density) > 0.);
+        assert(std::abs(particleVect[particleVect[i].neighbours[j]].density) > 0.);
 
-        Point3F surfaceTensionGradient = Point3F();
-        FLOAT surfaceTensionLaplacian = 0.0;
+        const Point3F differenceParticleNeighbour =
+            getDifference(volume, particleVect[i].position, particleVect[particleVect[i].neighbours[j]].position);
 
-        for (size_t j = 0; j < particleVect[i].neighbours.size(); j++)
+        if (differenceParticleNeighbour.calcNormSqr() <= params.supportRadiusSqr)
         {
-            assert(std::abs(particleVect[i].density) > 0.);
-            assert(std::abs(particleVect[particleVect[i].neighbours[j]].density) > 0.);
+            const FLOAT dividedMassDensity =
+                params.waterParticleMass / particleVect[particleVect[i].neighbours[j]].density;
 
-            const Point3F differenceParticleNeighbour =
-                particleVect[i].position - particleVect[particleVect[i].neighbours[j]].position;
+            // (Formulae 4.28 & 4.4)
+            surfaceTensionGradient += defaultKernelGradient(params, differenceParticleNeighbour) * dividedMassDensity;
 
-            if (differenceParticleNeighbour.calcNormSqr() <= SupportRadiusSqr)
-            {
-                const FLOAT dividedMassDensity =
-                    Config::WaterParticleMass / particleVect[particleVect[i].neighbours[j]].density;
+            // (Formulae 4.27 & 4.5)
+            surfaceTensionLaplacian += defaultKernelLaplacian(params, differenceParticleNeighbour) * dividedMassDensity;
+        }
+    }
 
-                // (Formulae 4.28 & 4.4)
-                surfaceTensionGradient += defaultKernelGradient(differenceParticleNeighbour) * dividedMassDensity;
+    // (Formulae 4.32 & 5.17)
+    if (surfaceTensionGradient.calcNorm() >= std::sqrt(params.waterDensity / particleVect[i].neighbours.size()))
+        // (Formula 4.26 is presented by combination of 4.27 & 4.5 - laplacian - and 4.28 & 4.4 - gradient)
+        particleVect[i].fSurfaceTension = -surfaceTensionGradient / surfaceTensionGradient.calcNorm() *
+                                           surfaceTensionLaplacian * params.waterSurfaceTension;
+}
 
-                // (Formulae 4.27 & 4.5)
-                surfaceTensionLaplacian += defaultKernelLaplacian(differenceParticleNeighbour) * dividedMassDensity;
-            }
-        }
+void Forces::ComputeDensity(ParticleVect& particleVect, const SimulationParams& params)
+{
+    const Volume volume = params.getVolume();
 
-        // (Formulae 4.32 & 5.17)
-        if (surfaceTensionGradient.calcNorm() >= std::sqrt(Config::WaterDensity / particleVect[i].neighbours.size()))
-            // (Formula 4.26 is presented by combination of 4.27 & 4.5 - laplacian - and 4.28 & 4.4 - gradient)
-            particleVect[i].fSurfaceTension = -surfaceTensionGradient / surfaceTensionGradient.calcNorm() *
-                                               surfaceTensionLaplacian * Config::WaterSurfaceTension;
-    }
+    for (size_t i = 0; i < particleVect.size(); i++)
+        computeDensity(particleVect, i, params, volume);
 }
 
-void Forces::ComputeExternalForces(ParticleVect& particleVect)
+void Forces::ComputePressure(ParticleVect& particleVect, const SimulationParams& params)
 {
-    Forces::ComputeGravityForce(particleVect);
-    Forces::ComputeSurfaceTension(particleVect);
+    for (auto& particle : particleVect)
+        computePressure(particle, params);
+}
+
+void Forces::ComputeInternalForces(ParticleVect& particleVect, const SimulationParams& params)
+{
+    const Volume volume = params.getVolume();
+
+    for (size_t i = 0; i < particleVect.size(); i++)
+        computeInternalForces(particleVect, i, params, volume);
+}
+
+void Forces::ComputeGravityForce(ParticleVect& particleVect, const SimulationParams& params)
+{
+    for (auto& particle : particleVect)
+        computeGravityForce(particle, params);
+}
+
+void Forces::ComputeSurfaceTension(ParticleVect& particleVect, const SimulationParams& params)
+{
+    const Volume volume = params.getVolume();
+
+    for (size_t i = 0; i < particleVect.size(); i++)
+        computeSurfaceTension(particleVect, i, params, volume);
+}
+
+void Forces::ComputeExternalForces(ParticleVect& particleVect, const SimulationParams& params)
+{
+    Forces::ComputeGravityForce(particleVect, params);
+    Forces::ComputeSurfaceTension(particleVect, params);
 
     for (auto& particle : particleVect)
     {
@@ -179,12 +243,12 @@ void Forces::ComputeExternalForces(ParticleVect& particleVect)
     }
 }
 
-void Forces::ComputeAllForces(ParticleVect& particleVect)
+void Forces::ComputeAllForces(ParticleVect& particleVect, const SimulationParams& params)
 {
-    Forces::ComputeDensity(particleVect);
-    Forces::ComputePressure(particleVect);
-    Forces::ComputeInternalForces(particleVect);
-    Forces::ComputeExternalForces(particleVect);
+    Forces::ComputeDensity(particleVect, params);
+    Forces::ComputePressure(particleVect, params);
+    Forces::ComputeInternalForces(particleVect, params);
+    Forces::ComputeExternalForces(particleVect, params);
 
     for (auto& particle : particleVect)
     {
@@ -192,4 +256,40 @@ void Forces::ComputeAllForces(ParticleVect& particleVect)
     }
 }
 
+void Forces::ComputeDensityAndPressure(ParticleVect&            particleVect,
+                                       const SizetVector&       particleIndices,
+                                       const SimulationParams&  params,
+                                       const BoundaryParticles* boundaryParticles)
+{
+    const Volume volume = params.getVolume();
+
+    for (const size_t i : particleIndices)
+    {
+        computeDensity(particleVect, i, params, volume);
+        if (boundaryParticles != nullptr)
+            computeBoundaryDensity(particleVect, i, params, *boundaryParticles);
+        computePressure(particleVect[i], params);
+    }
+}
+
+void Forces::ComputeForces(ParticleVect&            particleVect,
+                           const SizetVector&       particleIndices,
+                           const SimulationParams&  params,
+                           const BoundaryParticles* boundaryParticles)
+{
+    const Volume volume = params.getVolume();
+
+    for (const size_t i : particleIndices)
+    {
+        computeInternalForces(particleVect, i, params, volume);
+        if (boundaryParticles != nullptr)
+            computeBoundaryPressureForce(particleVect, i, params, *boundaryParticles);
+        computeGravityForce(particleVect[i], params);
+        computeSurfaceTension(particleVect, i, params, volume);
+
+        particleVect[i].fExternal = particleVect[i].fSurfaceTension + particleVect[i].fGravity;
+        particleVect[i].fTotal = particleVect[i].fExternal + particleVect[i].fInternal;
+    }
+}
+
 } // namespace SPHSDK
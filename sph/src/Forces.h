@@ -7,9 +7,11 @@
 #ifndef FORCES_H_73C34465A6ED4DB9B9F2F4C3937BF5DC
 #define FORCES_H_73C34465A6ED4DB9B9F2F4C3937BF5DC
 
+#include "BoundaryParticles.h"
 #include "Collisions.h"
 #include "Config.h"
 #include "Particle.h"
+#include "SimulationParams.h"
 
 namespace SPHSDK
 {
@@ -25,21 +27,42 @@ class Forces
 
 public:
 
-    static void ComputeAllForces(ParticleVect& particleVect);
+    static void ComputeAllForces(ParticleVect& particleVect, const SimulationParams& params = SimulationParams());
+
+    /**
+     * @brief Computes density and pressure of the given particles only.
+     * Neighbour lists of the particles must be up to date.
+     * @param boundaryParticles    Static particles of walls and obstacles counted through
+     *                             Particle::boundaryNeighbours, may be nullptr
+     */
+    static void ComputeDensityAndPressure(ParticleVect&            particleVect,
+                                          const SizetVector&       particleIndices,
+                                          const SimulationParams&  params = SimulationParams(),
+                                          const BoundaryParticles* boundaryParticles = nullptr);
+
+    /**
+     * @brief Computes internal, external and total forces of the given particles only.
+     * Density and pressure of the particles and of all their neighbours must be up to date.
+     * Boundary particles push the particles away with their pressure mirrored from the particle.
+     */
+    static void ComputeForces(ParticleVect&            particleVect,
+                              const SizetVector&       particleIndices,
+                              const SimulationParams&  params = SimulationParams(),
+                              const BoundaryParticles* boundaryParticles = nullptr);
 
 private:
 
-    static void ComputeDensity(ParticleVect& particleVect);
+    static void ComputeDensity(ParticleVect& particleVect, const SimulationParams& params = SimulationParams());
 
-    static void ComputePressure(ParticleVect& particleVect);
+    static void ComputePressure(ParticleVect& particleVect, const SimulationParams& params = SimulationParams());
 
-    static void ComputeSurfaceTension(ParticleVect& particleVect);
+    static void ComputeSurfaceTension(ParticleVect& particleVect, const SimulationParams& params = SimulationParams());
 
-    static void ComputeGravityForce(ParticleVect& particleVect);
+    static void ComputeGravityForce(ParticleVect& particleVect, const SimulationParams& params = SimulationParams());
 
-    static void ComputeInternalForces(ParticleVect& particleVect);
+    static void ComputeInternalForces(ParticleVect& particleVect, const SimulationParams& params = SimulationParams());
 
-    static void ComputeExternalForces(ParticleVect& particleVect);
+    static void ComputeExternalForces(ParticleVect& particleVect, const SimulationParams& params = SimulationParams());
 
 }; // Forces
 
@@ -5,46 +5,57 @@
 **/
 
 #include "Integrator.h"
-#include "Config.h"
 
 #include <cmath>
 
 namespace SPHSDK
 {
 
-void Integrator::integrate(FLOAT timeStep, ParticleVect& particles)
+static void integrateParticle(FLOAT timeStep, Particle& particle, const SimulationParams& params)
 {
-    for (auto& particle : particles)
-    {
-        particle.previous_position = particle.position;
+    particle.previous_position = particle.position;
 
-        const Point3F prevAcceleration = particle.acceleration;
+    const Point3F prevAcceleration = particle.acceleration;
 
-        if (std::abs(particle.density) > 0.)
-            particle.acceleration = particle.fTotal / particle.density;
+    if (std::abs(particle.density) > 0.)
+        particle.acceleration = particle.fTotal / particle.density;
 
-        const Point3F prevVelocity = particle.velocity;
+    const Point3F prevVelocity = particle.velocity;
 
-        particle.velocity += (prevAcceleration + particle.acceleration) / 2.0 * timeStep;
+    particle.velocity += (prevAcceleration + particle.acceleration) / 2.0 * timeStep;
 
-        if (particle.velocity.calcNormSqr() > Config::SpeedTreshold)
-            particle.velocity = prevVelocity;
+    if (particle.velocity.calcNormSqr() > params.speedTreshold)
+        particle.velocity = prevVelocity;
 
-        particle.position += prevVelocity * timeStep + prevAcceleration / 2.0 * timeStep * timeStep;
+    particle.position += prevVelocity * timeStep + prevAcceleration / 2.0 * timeStep * timeStep;
 
-        // color depends on velocity
-        const SPHSDK::FLOAT velocityNorm = particle.velocity.calcNormSqr();
-        particle.colour = Point3F(0.0f, 0.0f, 1.0f);
+    // color depends on velocity
+    const SPHSDK::FLOAT velocityNorm = particle.velocity.calcNormSqr();
+    particle.colour = Point3F(0.0f, 0.0f, 1.0f);
 
-        if (velocityNorm > SPHSDK::Config::SpeedTreshold / 2.)
-        {
-            particle.colour = Point3F(1.0f, 0.0f, 0.0f);
-        }
-        else if (velocityNorm > SPHSDK::Config::SpeedTreshold / 4.)
-        {
-            particle.colour = Point3F(0.99f, 0.7f, 0.0f);
-        }
+    if (velocityNorm > params.speedTreshold / 2.)
+    {
+        particle.colour = Point3F(1.0f, 0.0f, 0.0f);
     }
+    else if (velocityNorm > params.speedTreshold / 4.)
+    {
+        particle.colour = Point3F(0.99f, 0.7f, 0.0f);
+    }
+}
+
+void Integrator::integrate(FLOAT timeStep, ParticleVect& particles, const SimulationParams& params)
+{
+    for (auto& particle : particles)
+        integrateParticle(timeStep, particle, params);
+}
+
+void Integrator::integrate(FLOAT                   timeStep,
+                           ParticleVect&           particles,
+                           const SizetVector&      particleIndices,
+                           const SimulationParams& params)
+{
+    for (const size_t i : particleIndices)
+        integrateParticle(timeStep, particles[i], params);
 }
 
 } // SPHSDK
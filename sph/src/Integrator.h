@@ -8,6 +8,7 @@
 #define INTEGRATOR_H_73C34465A6ED4DB9B9F2F4C3937BF5DV
 
 #include "Particle.h"
+#include "SimulationParams.h"
 
 namespace SPHSDK
 {
@@ -15,7 +16,15 @@ namespace SPHSDK
 class Integrator
 {
 public:
-    static void integrate(FLOAT timeStep, ParticleVect& particles);
+    static void integrate(FLOAT timeStep, ParticleVect& particles, const SimulationParams& params = SimulationParams());
+
+    /**
+     * @brief Integrates the given particles only.
+     */
+    static void integrate(FLOAT                   timeStep,
+                          ParticleVect&           particles,
+                          const SizetVector&      particleIndices,
+                          const SimulationParams& params = SimulationParams());
 };
 
 } //SPHSDK
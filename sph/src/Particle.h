@@ -9,6 +9,7 @@
 
 #include "Config.h"
 #include "algorithms/src/Defines.h"
+#include "algorithms/src/FirstTouchAllocator.h"
 #include "algorithms/src/Point.h"
 
 namespace SPHSDK
@@ -55,9 +56,12 @@ public:
     Point3F fTotal;
 
     SizetVector neighbours;
+
+    // Indices of BoundaryParticles closer than the support radius
+    SizetVector boundaryNeighbours;
 };
 
-using ParticleVect = std::vector<Particle>;
+using ParticleVect = std::vector<Particle, FirstTouchAllocator<Particle>>;
 using ParticleVectConstIter = ParticleVect::const_iterator;
 using ParticleVectIter = ParticleVect::iterator;
 
@@ -7,13 +7,17 @@
 #include "SPH.h"
 
 #include "Collisions.h"
-#include "Config.h"
 #include "Forces.h"
 #include "Integrator.h"
 
+#include "algorithms/src/TaskGraph.h"
+
+#include <algorithm>
 #include <cfloat>
 #include <cmath>
+#include <exception>
 #include <iostream>
+#include <new>
 
 
 namespace SPHSDK
@@ -21,23 +25,28 @@ namespace SPHSDK
 
 static const FLOAT PI = 3.14159265359;
 
+// Rows and layers of boxes in one block of the step pipeline, fixed so the blocks do not depend on the threads number
+static const size_t PipelineBlockSide = 2u;
+
+// Neighbours reserved for every particle by its worker in first-touch mode, about twice the number at rest density
+static const size_t FirstTouchNeighboursCapacity = 64u;
+
+// Collision candidates reserved for every particle by its worker in first-touch mode, closer than 2 * particleRadius
+static const size_t FirstTouchCollisionCandidatesCapacity = 16u;
+
 namespace
 {
 inline Point3F SpericalToCartesian(FLOAT r, FLOAT fi, FLOAT teta)
 {
     return Point3F(r * sin(teta) * cos(fi) + 1.5, r * sin(teta) * sin(fi) + 1.5, r * cos(teta) + 2.);
 }
-} // namespace
 
-SPH::SPH(const std::function<FLOAT(FLOAT, FLOAT, FLOAT)>* obstacle)
-    : particles(Config::ParticlesNumber)
-    , m_volume(Volume(
-          Cuboid(Point3F(), Config::CubeSize, Config::CubeSize, Config::CubeSize)))
-    , m_searcher(NeighboursSearch3D<ParticleVect>(m_volume, Config::WaterSupportRadius, 0.001))
-    , m_obstacle(obstacle)
-{
-    // set initial particle data
-    FLOAT r = 2 * Config::ParticleRadius;
+// Particles start on spheres of growing radii around the centre of the default cube
+Point3FVector getInitialPositions(const SimulationParams& params)
+{
+    Point3FVector positions(params.particlesNumber);
+
+    FLOAT r = 2 * params.particleRadius;
     FLOAT fi = 0.;
     FLOAT teta = 0.;
 
@@ -47,12 +56,9 @@ SPH::SPH(const std::function<FLOAT(FLOAT, FLOAT, FLOAT)>* obstacle)
     size_t m = 0;
     size_t n = 0;
 
-    for (size_t i = 0u; i < Config::ParticlesNumber; ++i)
+    for (size_t i = 0u; i < params.particlesNumber; ++i)
     {
-        particles[i] = SpericalToCartesian(r, fi, teta);
-        particles[i].velocity = Config::InitialVelocity;
-        particles[i].mass = Config::WaterParticleMass;
-        particles[i].supportRadius = Config::WaterSupportRadius;
+        positions[i] = SpericalToCartesian(r, fi, teta);
 
         ++n;
 
@@ -69,21 +75,408 @@ SPH::SPH(const std::function<FLOAT(FLOAT, FLOAT, FLOAT)>* obstacle)
         {
             n = 0;
             m = 0;
-            r += 2 * Config::ParticleRadius;
+            r += 2 * params.particleRadius;
             M += 2;
             N += 2;
         }
     }
+
+    return positions;
+}
+
+/**
+ * Finds the block next to the given one in the direction of shift (-1, 0 or 1),
+ * blocks at the ends of periodic axes are next to each other. Returns false if there is no such block.
+ */
+bool shiftBlock(size_t block, int shift, size_t blocksNumber, bool isPeriodic, size_t& shifted)
+{
+    const long long position = static_cast<long long>(block) + shift;
+    const long long number = static_cast<long long>(blocksNumber);
+
+    if (position >= 0 && position < number)
+        shifted = static_cast<size_t>(position);
+    else if (isPeriodic)
+        shifted = static_cast<size_t>((position + number) % number);
+    else
+        return false;
+
+    return true;
+}
+
+} // namespace
+
+SPH::SPH(const std::function<FLOAT(FLOAT, FLOAT, FLOAT)>* obstacle)
+    : SPH(SimulationParams(), obstacle)
+{
+}
+
+SPH::SPH(const SimulationParams&                          params,
+         const std::function<FLOAT(FLOAT, FLOAT, FLOAT)>* obstacle,
+         const ThreadPoolOptions&                         poolOptions)
+    : SPH(params, obstacle, std::make_shared<ThreadPool>(poolOptions))
+{
+}
+
+SPH::SPH(const SimulationParams&                          params,
+         const std::function<FLOAT(FLOAT, FLOAT, FLOAT)>* obstacle,
+         std::shared_ptr<ThreadPool>                      pool)
+    : SPH(params,
+          nullptr,
+          obstacle != nullptr ? *obstacle : std::function<FLOAT(FLOAT, FLOAT, FLOAT)>(),
+          std::move(pool))
+{
+}
+
+SPH::SPH(const SimulationParams&              params,
+         std::shared_ptr<const ObstacleScene> obstacles,
+         const ThreadPoolOptions&             poolOptions)
+    : SPH(params, std::move(obstacles), std::make_shared<ThreadPool>(poolOptions))
+{
+}
+
+SPH::SPH(const SimulationParams& params, std::shared_ptr<const ObstacleScene> obstacles, std::shared_ptr<ThreadPool> pool)
+    : SPH(params, std::move(obstacles), std::function<FLOAT(FLOAT, FLOAT, FLOAT)>(), std::move(pool))
+{
+}
+
+SPH::SPH(const SimulationParams&                   params,
+         std::shared_ptr<const ObstacleScene>      obstacles,
+         std::function<FLOAT(FLOAT, FLOAT, FLOAT)> unbakedObstacle,
+         std::shared_ptr<ThreadPool>               pool)
+    : m_params(params)
+    , m_volume(params.getVolume())
+    , m_searcher(NeighboursSearch3D<ParticleVect>(m_volume, params.waterSupportRadius, 0.001))
+    , m_obstacles(std::move(obstacles))
+    , m_unbakedObstacle(std::move(unbakedObstacle))
+    , m_pool(std::move(pool))
+{
+    m_params.updateDerivedConstants();
+
+    // Sorted by the blocks of the step pipeline, so the particles of every worker are contiguous
+    // and first-touch gives every worker whole pages
+    Point3FVector positions = getInitialPositions(m_params);
+    std::stable_sort(positions.begin(), positions.end(),
+                     [this](const Point3F& a, const Point3F& b) { return getBlock(a) < getBlock(b); });
+
+    if (m_params.firstTouchAllocation)
+    {
+        allocateParticlesFirstTouch(positions);
+    }
+    else
+    {
+        particles.resize(m_params.particlesNumber);
+        m_collisionCandidates.resize(m_params.particlesNumber);
+        m_collisionBuffers.resize(m_params.particlesNumber);
+    }
+
+    sampleBoundaryParticles();
+
+    for (size_t i = 0u; i < params.particlesNumber; ++i)
+    {
+        // Fields are set in place to keep the storage placed by allocateParticlesFirstTouch()
+        particles[i].position = positions[i];
+        particles[i].radius = params.particleRadius;
+        particles[i].velocity = params.initialVelocity;
+        particles[i].mass = params.waterParticleMass;
+        particles[i].supportRadius = params.waterSupportRadius;
+    }
 }
 
 void SPH::run()
 {
-    m_searcher.search(particles);
+    TaskGraph graph;
+    addStepTasks(graph);
+    graph.run(*m_pool);
+}
+
+void SPH::addStepTasks(TaskGraph& graph)
+{
+    // Baked before the tasks are queued, the graph has not started yet, so the field is sampled on the whole pool
+    bakeObstacle();
+
+    // Blocks are rectangles of rows (y) and layers (z) of boxes, every block spans the whole width,
+    // so neighbours of a block particle lie only in the block and in its 8 neighbour blocks,
+    // along periodic axes the blocks at both ends are neighbours
+    const SizetVector gridSize = m_searcher.getBoxesGridSize();
+    const size_t width = gridSize[0];
+    const size_t length = gridSize[1];
+    const size_t height = gridSize[2];
+
+    const size_t rowBlocksNumber = getRowBlocksNumber();
+    const size_t layerBlocksNumber = getLayerBlocksNumber();
+    const size_t blocksNumber = rowBlocksNumber * layerBlocksNumber;
+
+    // Kept in the simulation, the tasks refer to them until the graph is run
+    VectorOfSizetVectors& blockParticles = m_blockParticles;
+    VectorOfSizetVectors& blockHalo = m_blockHalo;
+
+    blockParticles.resize(blocksNumber);
+    blockHalo.assign(blocksNumber, SizetVector());
+
+    for (size_t layerBlock = 0u; layerBlock < layerBlocksNumber; ++layerBlock)
+        for (size_t rowBlock = 0u; rowBlock < rowBlocksNumber; ++rowBlock)
+        {
+            const size_t block = rowBlock + layerBlock * rowBlocksNumber;
+
+            for (int layerShift = -1; layerShift <= 1; ++layerShift)
+                for (int rowShift = -1; rowShift <= 1; ++rowShift)
+                {
+                    size_t haloLayer = 0u;
+                    size_t haloRow = 0u;
+
+                    if (!shiftBlock(layerBlock, layerShift, layerBlocksNumber, m_volume.isPeriodic(2u), haloLayer) ||
+                        !shiftBlock(rowBlock, rowShift, rowBlocksNumber, m_volume.isPeriodic(1u), haloRow))
+                        continue;
+
+                    // With less than three blocks along a periodic axis both shifts reach the same block
+                    const size_t halo = haloRow + haloLayer * rowBlocksNumber;
+                    if (std::find(blockHalo[block].begin(), blockHalo[block].end(), halo) == blockHalo[block].end())
+                        blockHalo[block].push_back(halo);
+                }
+        }
+
+    // Boxes are filled once for all blocks
+    const size_t insertTask = graph.addTask([this] { m_searcher.insertPoints(particles); });
+
+    SizetVector searchTasks(blocksNumber);
+    SizetVector densityTasks(blocksNumber);
+    SizetVector forcesTasks(blocksNumber);
+    SizetVector integrationTasks(blocksNumber);
+    SizetVector gatherTasks(blocksNumber);
+    SizetVector applyTasks(blocksNumber);
+
+    for (size_t block = 0u; block < blocksNumber; ++block)
+    {
+        const size_t rowBlock = block % rowBlocksNumber;
+        const size_t layerBlock = block / rowBlocksNumber;
+
+        const size_t firstRow = length * rowBlock / rowBlocksNumber;
+        const size_t lastRow = length * (rowBlock + 1u) / rowBlocksNumber;
+        const size_t firstLayer = height * layerBlock / layerBlocksNumber;
+        const size_t lastLayer = height * (layerBlock + 1u) / layerBlocksNumber;
+
+        SizetVector& blockIndices = blockParticles[block];
+
+        // Every stage of the block is queued on the worker which placed its particles
+        const size_t worker = getBlockWorker(block);
+
+        searchTasks[block] = graph.addTask([this, &blockIndices, width, length, firstRow, lastRow, firstLayer, lastLayer] {
+            blockIndices.clear();
+
+            for (size_t layer = firstLayer; layer < lastLayer; ++layer)
+                for (size_t row = firstRow; row < lastRow; ++row)
+                    for (size_t column = 0u; column < width; ++column)
+                    {
+                        const size_t boxIndex = column + row * width + layer * width * length;
+                        const SizetVector& box = m_searcher.getPointsInBox(boxIndex);
+
+                        blockIndices.insert(blockIndices.end(), box.begin(), box.end());
+                        m_searcher.searchInBox(particles, boxIndex, 2.0 * m_params.particleRadius,
+                                               m_collisionCandidates);
+                    }
+
+            if (m_boundaryParticles)
+                for (const size_t i : blockIndices)
+                    m_boundaryParticles->findNeighbours(particles[i].position, particles[i].boundaryNeighbours);
+
+            // Ascending indices keep memory accesses of the block stages in order
+            std::sort(blockIndices.begin(), blockIndices.end());
+        }, worker);
 
-    Forces::ComputeAllForces(particles);
-    Integrator::integrate(0.01, particles);
+        densityTasks[block] = graph.addTask([this, &blockIndices] {
+            Forces::ComputeDensityAndPressure(particles, blockIndices, m_params, m_boundaryParticles.get());
+        }, worker);
 
-    Collision::detectCollisions(particles, m_volume, m_obstacle);
+        forcesTasks[block] = graph.addTask([this, &blockIndices] {
+            Forces::ComputeForces(particles, blockIndices, m_params, m_boundaryParticles.get());
+        }, worker);
+
+        integrationTasks[block] = graph.addTask([this, &blockIndices] {
+            Integrator::integrate(m_params.timeStep, particles, blockIndices, m_params);
+        }, worker);
+
+        gatherTasks[block] = graph.addTask([this, &blockIndices] {
+            Collision::gatherCollisions(particles, blockIndices, m_collisionCandidates, m_volume, m_obstacles.get(), m_params,
+                                        m_collisionBuffers);
+        }, worker);
+
+        applyTasks[block] = graph.addTask([this, &blockIndices] {
+            Collision::applyCollisions(particles, blockIndices, m_collisionBuffers);
+        }, worker);
+    }
+
+    for (size_t block = 0u; block < blocksNumber; ++block)
+    {
+        graph.addDependency(insertTask, searchTasks[block]);
+        graph.addDependency(searchTasks[block], densityTasks[block]);
+
+        for (const size_t halo : blockHalo[block])
+        {
+            // Forces read density and pressure of neighbours
+            graph.addDependency(densityTasks[halo], forcesTasks[block]);
+            // Integration moves particles which neighbour forces still read
+            graph.addDependency(forcesTasks[halo], integrationTasks[block]);
+            // Collisions read moved neighbours
+            graph.addDependency(integrationTasks[halo], gatherTasks[block]);
+            // Applied collisions move particles which neighbour gathers still read
+            graph.addDependency(gatherTasks[halo], applyTasks[block]);
+        }
+    }
+}
+
+const SimulationParams& SPH::getParams() const
+{
+    return m_params;
+}
+
+void SPH::allocateParticlesFirstTouch(const Point3FVector& positions)
+{
+    const size_t threadsNumber = m_pool->getThreadsNumber();
+
+    // Positions are sorted by blocks, so every worker gets the contiguous range of the particles starting
+    // in the blocks the step pipeline queues on it
+    SizetVector workerStarts(threadsNumber + 1u, positions.size());
+    for (size_t worker = 0u, i = 0u; worker < threadsNumber; ++worker)
+    {
+        while (i < positions.size() && getBlockWorker(getBlock(positions[i])) < worker)
+            ++i;
+
+        workerStarts[worker] = i;
+    }
+
+    {
+        DeferConstructionScope scope;
+        particles.resize(positions.size());
+        m_collisionBuffers.resize(positions.size());
+    }
+
+    // Only the empty vectors are constructed here, their elements are reserved by the workers
+    m_collisionCandidates.resize(positions.size());
+
+    std::vector<std::exception_ptr> errors(threadsNumber);
+
+    // Chunk k of parallelFor() is run by worker k. Particle() and Point3F() only set numbers and empty vectors,
+    // so every element is constructed before anything which may throw and the vectors stay destructible,
+    // exceptions of the reserves are rethrown once all workers are done.
+    m_pool->parallelFor(0u, threadsNumber, [this, &workerStarts, &errors](size_t begin, size_t end) {
+        for (size_t worker = begin; worker < end; ++worker)
+        {
+            for (size_t i = workerStarts[worker]; i < workerStarts[worker + 1u]; ++i)
+            {
+                ::new (static_cast<void*>(&particles[i])) Particle();
+                ::new (static_cast<void*>(&m_collisionBuffers.positions[i])) Point3F();
+                ::new (static_cast<void*>(&m_collisionBuffers.velocities[i])) Point3F();
+            }
+
+            try
+            {
+                for (size_t i = workerStarts[worker]; i < workerStarts[worker + 1u]; ++i)
+                {
+                    particles[i].neighbours.reserve(FirstTouchNeighboursCapacity);
+                    m_collisionCandidates[i].reserve(FirstTouchCollisionCandidatesCapacity);
+
+                    if (m_params.boundaryParticles)
+                        particles[i].boundaryNeighbours.reserve(FirstTouchNeighboursCapacity);
+                }
+            }
+            catch (...)
+            {
+                errors[worker] = std::current_exception();
+            }
+        }
+    });
+
+    for (const std::exception_ptr& error : errors)
+        if (error)
+            std::rethrow_exception(error);
+}
+
+size_t SPH::getRowBlocksNumber() const
+{
+    return std::max<size_t>(1u, m_searcher.getBoxesGridSize()[1] / PipelineBlockSide);
+}
+
+size_t SPH::getLayerBlocksNumber() const
+{
+    return std::max<size_t>(1u, m_searcher.getBoxesGridSize()[2] / PipelineBlockSide);
+}
+
+size_t SPH::getBlock(const Point3F& position) const
+{
+    const SizetVector gridSize = m_searcher.getBoxesGridSize();
+    const Cuboid cuboid = m_volume.getBoundingCuboid();
+    const Point3F wrapped = m_volume.wrapPosition(position);
+
+    // Boxes of the neighbour search are support radius wide, points outside of the volume go to the nearest ones
+    const auto getBox = [this](FLOAT offset, size_t boxesNumber) {
+        const size_t box = static_cast<size_t>(std::max<FLOAT>(offset, 0.0) / m_params.waterSupportRadius);
+        return std::min(box, boxesNumber - 1u);
+    };
+
+    const size_t row = getBox(wrapped.y - cuboid.startingPoint.y, gridSize[1]);
+    const size_t layer = getBox(wrapped.z - cuboid.startingPoint.z, gridSize[2]);
+
+    // Inverse of the first rows and layers of blocks in addStepTasks()
+    const size_t rowBlocksNumber = getRowBlocksNumber();
+    const size_t layerBlocksNumber = getLayerBlocksNumber();
+    const size_t rowBlock = (row * rowBlocksNumber + rowBlocksNumber - 1u) / gridSize[1];
+    const size_t layerBlock = (layer * layerBlocksNumber + layerBlocksNumber - 1u) / gridSize[2];
+
+    return rowBlock + layerBlock * rowBlocksNumber;
+}
+
+size_t SPH::getOwningWorker(const Point3F& position) const
+{
+    return getBlockWorker(getBlock(position));
+}
+
+size_t SPH::getBlockWorker(size_t block) const
+{
+    const size_t blocksNumber = getRowBlocksNumber() * getLayerBlocksNumber();
+    return block * m_pool->getThreadsNumber() / blocksNumber;
+}
+
+ThreadPool& SPH::getThreadPool() const
+{
+    return *m_pool;
+}
+
+const BoundaryParticles* SPH::getBoundaryParticles() const
+{
+    return m_boundaryParticles.get();
+}
+
+void SPH::sampleBoundaryParticles()
+{
+    if (!m_params.boundaryParticles)
+        return;
+
+    // Boundary particles sample the obstacle, so it can not wait for the first step
+    bakeObstacle();
+
+    auto boundaryParticles = std::make_shared<BoundaryParticles>();
+    boundaryParticles->sample(m_volume, m_obstacles.get(), m_params, m_pool.get());
+
+    m_boundaryParticles = std::move(boundaryParticles);
+}
+
+void SPH::bakeObstacle()
+{
+    if (!m_unbakedObstacle)
+        return;
+
+    // The obstacle may lie anywhere in the volume
+    auto obstacles = std::make_shared<ObstacleScene>();
+    obstacles->addField(SignedDistanceField(m_unbakedObstacle, m_params.getVolume().getBoundingCuboid(),
+                                            m_params.obstacleCellSize, m_params.obstacleBandWidth, m_pool.get()));
+
+    m_obstacles = std::move(obstacles);
+    m_unbakedObstacle = nullptr;
+}
+
+void SPH::setGravitationalAcceleration(const Point3F& gravitationalAcceleration)
+{
+    m_params.gravitationalAcceleration = gravitationalAcceleration;
 }
 
 } // namespace SPHSDK
@@ -7,33 +7,162 @@
 #ifndef SPH_H_73C34465A6ED4DB9B9F2F4C3937BF5DC
 #define SPH_H_73C34465A6ED4DB9B9F2F4C3937BF5DC
 
+#include "BoundaryParticles.h"
+#include "Collisions.h"
 #include "Particle.h"
+#include "SimulationParams.h"
 
 #include "algorithms/src/Area.h"
 #include "algorithms/src/Defines.h"
 #include "algorithms/src/NeighboursSearch.h"
+#include "algorithms/src/ThreadPool.h"
 
 #include <functional>
+#include <memory>
 
 namespace SPHSDK
 {
 
+class TaskGraph;
+
 class SPH
 {
 public:
     SPH(const std::function<FLOAT(FLOAT, FLOAT, FLOAT)>* obstacle = nullptr);
 
+    /**
+     * @brief Creates simulation with its own thread pool.
+     * The obstacle is copied and sampled into a distance field by the first step, or on construction
+     * if SimulationParams::boundaryParticles is set, so simulations which never step do not pay for it.
+     */
+    explicit SPH(const SimulationParams&                          params,
+                 const std::function<FLOAT(FLOAT, FLOAT, FLOAT)>* obstacle = nullptr,
+                 const ThreadPoolOptions&                         poolOptions = ThreadPoolOptions());
+
+    /**
+     * @brief Creates simulation which runs on the given pool, several simulations may share one pool,
+     * steps of simulations run by different threads take turns on it.
+     */
+    SPH(const SimulationParams&                          params,
+        const std::function<FLOAT(FLOAT, FLOAT, FLOAT)>* obstacle,
+        std::shared_ptr<ThreadPool>                      pool);
+
+    /**
+     * @brief Creates simulation with a scene of obstacles and its own thread pool.
+     * @param obstacles    The obstacles, may be shared by several simulations, nullptr means no obstacles
+     */
+    SPH(const SimulationParams&              params,
+        std::shared_ptr<const ObstacleScene> obstacles,
+        const ThreadPoolOptions&             poolOptions = ThreadPoolOptions());
+
+    SPH(const SimulationParams& params, std::shared_ptr<const ObstacleScene> obstacles, std::shared_ptr<ThreadPool> pool);
+
+    /**
+     * @brief Makes one step on the pool with overlapping stages.
+     * The boxes of the neighbour search are grouped into blocks of rows and layers, every stage of a block
+     * (search, density, forces, integration, collisions) is a task which waits only for the previous stage
+     * of the block and of its neighbour blocks, so no thread idles at full-array barriers.
+     * Collisions are gathered into buffers from positions of the previous stage and applied afterwards,
+     * so the result does not depend on the number of threads or the order of blocks.
+     */
     void run();
 
+    /**
+     * @brief Adds the tasks of one step described in run() to the graph, so steps of several simulations
+     * may run in one graph and idle threads take blocks of any of them.
+     * The tasks refer to the simulation, it must not be moved or stepped until the graph has run.
+     */
+    void addStepTasks(TaskGraph& graph);
+
+    const SimulationParams& getParams() const;
+
+    /**
+     * @brief Returns the pool of the simulation, e.g. to read its worker statistics.
+     */
+    ThreadPool& getThreadPool() const;
+
+    /**
+     * @brief Returns the worker the step tasks of the block containing the point are queued on.
+     * The particles start sorted by blocks, so every worker owns a contiguous range of them.
+     */
+    size_t getOwningWorker(const Point3F& position) const;
+
+    /**
+     * @brief Returns static particles of walls and obstacles, nullptr unless SimulationParams::boundaryParticles is set.
+     */
+    const BoundaryParticles* getBoundaryParticles() const;
+
+    void setGravitationalAcceleration(const Point3F& gravitationalAcceleration);
+
 public:
+    // With SimulationParams::firstTouchAllocation the particles are placed by the pool workers,
+    // copies of the simulation are placed by the copying thread
     ParticleVect particles;
 
 private:
+    SPH(const SimulationParams&                   params,
+        std::shared_ptr<const ObstacleScene>      obstacles,
+        std::function<FLOAT(FLOAT, FLOAT, FLOAT)> unbakedObstacle,
+        std::shared_ptr<ThreadPool>               pool);
+
+    /**
+     * @brief Lets every pool worker construct the particles starting in the blocks of the step pipeline
+     * queued on it, with their neighbours, collision candidates and collision buffers,
+     * so with NUMA pinning their pages land on the node of the worker which steps them.
+     * The positions are sorted by blocks, so the particles of a worker are one contiguous range.
+     */
+    void allocateParticlesFirstTouch(const Point3FVector& positions);
+
+    // Blocks of the step pipeline along rows (y) and layers (z) of the boxes of the neighbour search
+    size_t getRowBlocksNumber() const;
+    size_t getLayerBlocksNumber() const;
+
+    // Block of the step pipeline containing the point
+    size_t getBlock(const Point3F& position) const;
+
+    // The worker the stages of the block are queued on, blocks are split into contiguous ranges
+    // like the chunks of ThreadPool::parallelFor()
+    size_t getBlockWorker(size_t block) const;
+
+    /**
+     * @brief Samples walls and obstacles with static particles if SimulationParams::boundaryParticles is set.
+     */
+    void sampleBoundaryParticles();
+
+    /**
+     * @brief Samples the obstacle function given on construction into m_obstacles, does nothing once it is done.
+     * Must not run while a graph of the simulation is running.
+     */
+    void bakeObstacle();
+
+private:
+    SimulationParams m_params;
+
     Volume m_volume;
 
     NeighboursSearch3D<ParticleVect> m_searcher;
 
-    const std::function<FLOAT(FLOAT, FLOAT, FLOAT)>* m_obstacle;
+    // Particles and halo blocks of every block of the step pipeline, see addStepTasks()
+    VectorOfSizetVectors m_blockParticles;
+    VectorOfSizetVectors m_blockHalo;
+
+    // Neighbours closer than 2 * particleRadius, the broad phase of particle collisions
+    VectorOfSizetVectors m_collisionCandidates;
+
+    CollisionBuffers m_collisionBuffers;
+
+    // Shared by copies of the simulation, nullptr without obstacles or until the obstacle function is baked
+    std::shared_ptr<const ObstacleScene> m_obstacles;
+
+    // The obstacle function waiting for bakeObstacle(), empty once baked,
+    // copies of the simulation made before the first step bake it on their own
+    std::function<FLOAT(FLOAT, FLOAT, FLOAT)> m_unbakedObstacle;
+
+    // Shared by copies of the simulation, nullptr without boundary particles
+    std::shared_ptr<const BoundaryParticles> m_boundaryParticles;
+
+    // Shared by copies of the simulation
+    std::shared_ptr<ThreadPool> m_pool;
 };
 
 } // namespace SPHSDK
@@ -0,0 +1,200 @@
+/**
+ * @file SimulationParams.cpp
+ * @author Anton Artyukh (artyukhanton@gmail.com)
+ * @date Created Oct 19, 2026
+ **/
+
+#include "SimulationParams.h"
+
+#include "Config.h"
+
+#define _USE_MATH_DEFINES
+#include <math.h>
+
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace SPHSDK
+{
+
+namespace
+{
+std::string trim(const std::string& text)
+{
+    const size_t first = text.find_first_not_of(" \t\r");
+    if (first == std::string::npos)
+        return std::string();
+
+    const size_t last = text.find_last_not_of(" \t\r");
+    return text.substr(first, last - first + 1u);
+}
+
+template <class T> void readValue(std::istringstream& value, const std::string& name, T& result)
+{
+    T parsed;
+    if (!(value >> parsed) || !(value >> std::ws).eof())
+        throw std::runtime_error("Invalid value of simulation parameter " + name);
+
+    result = parsed;
+}
+
+void readValue(std::istringstream& value, const std::string& name, Point3F& result)
+{
+    Point3F parsed;
+    if (!(value >> parsed.x >> parsed.y >> parsed.z) || !(value >> std::ws).eof())
+        throw std::runtime_error("Invalid value of simulation parameter " + name);
+
+    result = parsed;
+}
+
+void readValue(std::istringstream& value, const std::string& name, std::array<bool, 3>& result)
+{
+    std::array<bool, 3> parsed;
+    if (!(value >> parsed[0] >> parsed[1] >> parsed[2]) || !(value >> std::ws).eof())
+        throw std::runtime_error("Invalid value of simulation parameter " + name);
+
+    result = parsed;
+}
+} // namespace
+
+SimulationParams::SimulationParams()
+    : particlesNumber(Config::ParticlesNumber)
+    , particleRadius(Config::ParticleRadius)
+    , waterDensity(Config::WaterDensity)
+    , waterStiffness(Config::WaterStiffness)
+    , waterViscosity(Config::WaterViscosity)
+    , waterThreshold(Config::WaterThreshold)
+    , waterParticleMass(Config::WaterParticleMass)
+    , waterSupportRadius(Config::WaterSupportRadius)
+    , waterSurfaceTension(Config::WaterSurfaceTension)
+    , gravitationalAcceleration(Config::InitialGravitationalAcceleration)
+    , initialVelocity(Config::InitialVelocity)
+    , collisionVelocityMultiplier(Config::CollisionVelocityMultiplier)
+    , speedTreshold(Config::SpeedTreshold)
+    , cubeSize(Config::CubeSize)
+    , periodicAxes({false, false, false})
+    , timeStep(Config::TimeStep)
+    , obstacleCellSize(Config::ObstacleCellSize)
+    , obstacleBandWidth(Config::ObstacleBandWidth)
+    , obstacleRestitution(Config::ObstacleRestitution)
+    , obstacleFriction(Config::ObstacleFriction)
+    , sweptCollisions(false)
+    , sweptCollisionDistance(Config::SweptCollisionDistance)
+    , boundaryParticles(false)
+    , boundarySpacing(Config::BoundarySpacing)
+    , firstTouchAllocation(false)
+{
+    updateDerivedConstants();
+}
+
+SimulationParams SimulationParams::loadFromFile(const std::string& fileName)
+{
+    std::ifstream file(fileName);
+    if (!file)
+        throw std::runtime_error("Can not open simulation parameters file " + fileName);
+
+    return loadFromStream(file);
+}
+
+SimulationParams SimulationParams::loadFromStream(std::istream& stream)
+{
+    SimulationParams params;
+
+    std::string line;
+    while (std::getline(stream, line))
+    {
+        line = trim(line);
+        if (line.empty() || line[0] == '#')
+            continue;
+
+        const size_t separator = line.find('=');
+        if (separator == std::string::npos)
+            throw std::runtime_error("Invalid simulation parameters line: " + line);
+
+        const std::string name = trim(line.substr(0u, separator));
+        std::istringstream value(line.substr(separator + 1u));
+
+        if (name == "ParticlesNumber")
+            readValue(value, name, params.particlesNumber);
+        else if (name == "ParticleRadius")
+            readValue(value, name, params.particleRadius);
+        else if (name == "WaterDensity")
+            readValue(value, name, params.waterDensity);
+        else if (name == "WaterStiffness")
+            readValue(value, name, params.waterStiffness);
+        else if (name == "WaterViscosity")
+            readValue(value, name, params.waterViscosity);
+        else if (name == "WaterThreshold")
+            readValue(value, name, params.waterThreshold);
+        else if (name == "WaterParticleMass")
+            readValue(value, name, params.waterParticleMass);
+        else if (name == "WaterSupportRadius")
+            readValue(value, name, params.waterSupportRadius);
+        else if (name == "WaterSurfaceTension")
+            readValue(value, name, params.waterSurfaceTension);
+        else if (name == "GravitationalAcceleration")
+            readValue(value, name, params.gravitationalAcceleration);
+        else if (name == "InitialVelocity")
+            readValue(value, name, params.initialVelocity);
+        else if (name == "CollisionVelocityMultiplier")
+            readValue(value, name, params.collisionVelocityMultiplier);
+        else if (name == "SpeedTreshold")
+            readValue(value, name, params.speedTreshold);
+        else if (name == "CubeSize")
+            readValue(value, name, params.cubeSize);
+        else if (name == "PeriodicAxes")
+            readValue(value, name, params.periodicAxes);
+        else if (name == "TimeStep")
+            readValue(value, name, params.timeStep);
+        else if (name == "ObstacleCellSize")
+            readValue(value, name, params.obstacleCellSize);
+        else if (name == "ObstacleBandWidth")
+            readValue(value, name, params.obstacleBandWidth);
+        else if (name == "ObstacleRestitution")
+            readValue(value, name, params.obstacleRestitution);
+        else if (name == "ObstacleFriction")
+            readValue(value, name, params.obstacleFriction);
+        else if (name == "SweptCollisions")
+            readValue(value, name, params.sweptCollisions);
+        else if (name == "SweptCollisionDistance")
+            readValue(value, name, params.sweptCollisionDistance);
+        else if (name == "BoundaryParticles")
+            readValue(value, name, params.boundaryParticles);
+        else if (name == "BoundarySpacing")
+            readValue(value, name, params.boundarySpacing);
+        else if (name == "FirstTouchAllocation")
+            readValue(value, name, params.firstTouchAllocation);
+        else
+            throw std::runtime_error("Unknown simulation parameter " + name);
+    }
+
+    params.updateDerivedConstants();
+
+    return params;
+}
+
+void SimulationParams::updateDerivedConstants()
+{
+    const FLOAT piPowH9 = M_PI * pow(waterSupportRadius, 9);
+    const FLOAT piPowH6 = M_PI * pow(waterSupportRadius, 6);
+
+    supportRadiusSqr = waterSupportRadius * waterSupportRadius;
+    kernelDefaultMultiplier = 315.0 / (64.0 * piPowH9);
+    kernelDefaultGradientMultiplier = -945.0 / (32.0 * piPowH9);
+    kernelPressureGradientMultiplier = -45.0 / piPowH6;
+    kernelViscosityLaplacianMultiplier = 45.0 / piPowH6;
+    ownDensity = 315.0 / (64.0 * M_PI * pow(waterSupportRadius, 3));
+}
+
+Volume SimulationParams::getVolume() const
+{
+    return Volume(Cuboid(Point3F(), cubeSize, cubeSize, cubeSize), periodicAxes);
+}
+
+bool SimulationParams::hasPeriodicAxes() const
+{
+    return periodicAxes[0] || periodicAxes[1] || periodicAxes[2];
+}
+
+} // namespace SPHSDK
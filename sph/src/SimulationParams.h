@@ -0,0 +1,117 @@
+/**
+ * @file SimulationParams.h
+ * @author Anton Artyukh (artyukhanton@gmail.com)
+ * @date Created Oct 19, 2026
+ **/
+
+#ifndef SIMULATION_PARAMS_H_86962C78ED154C88A4F6C0A7DF1503B7
+#define SIMULATION_PARAMS_H_86962C78ED154C88A4F6C0A7DF1503B7
+
+#include "algorithms/src/Area.h"
+#include "algorithms/src/Defines.h"
+#include "algorithms/src/Point.h"
+
+#include <array>
+#include <cstddef>
+#include <istream>
+#include <string>
+
+namespace SPHSDK
+{
+
+/**
+ * @brief SimulationParams struct keeps physical parameters of one simulation.
+ * Default values are taken from Config, so every instance can override them
+ * independently of the others and several simulations can run in one process.
+ *
+ * Kernel coefficients derived from the support radius are computed once per instance,
+ * call updateDerivedConstants() after changing waterSupportRadius in code.
+ */
+struct SimulationParams
+{
+    SimulationParams();
+
+    /**
+     * @brief Reads parameters from text file.
+     * Every line has the form "Name = value", where Name is one of Config members,
+     * vectors are given by three numbers and lines starting with '#' are ignored.
+     * Parameters missing in the file keep their Config values.
+     * @param fileName    The path to the file
+     * @return parameters with derived constants updated
+     * @throw std::runtime_error if the file can not be read or contains unknown parameter
+     */
+    static SimulationParams loadFromFile(const std::string& fileName);
+
+    /**
+     * @brief Reads parameters from stream in the same format as loadFromFile().
+     */
+    static SimulationParams loadFromStream(std::istream& stream);
+
+    /**
+     * @brief Recomputes kernel coefficients from waterSupportRadius.
+     */
+    void updateDerivedConstants();
+
+    /**
+     * @brief Returns the simulated cube of cubeSize with periodicAxes.
+     */
+    Volume getVolume() const;
+
+    bool hasPeriodicAxes() const;
+
+    size_t particlesNumber;
+    FLOAT particleRadius;
+
+    FLOAT waterDensity;
+    FLOAT waterStiffness;
+    FLOAT waterViscosity;
+    FLOAT waterThreshold;
+    FLOAT waterParticleMass;
+    FLOAT waterSupportRadius;
+    FLOAT waterSurfaceTension;
+
+    Point3F gravitationalAcceleration;
+    Point3F initialVelocity;
+    FLOAT collisionVelocityMultiplier;
+
+    FLOAT speedTreshold;
+
+    FLOAT cubeSize;
+
+    // Axes x, y and z without walls, particles leaving the cube on one side enter it on the opposite one
+    std::array<bool, 3> periodicAxes;
+
+    FLOAT timeStep;
+
+    // Voxel side and narrow band width of the distance field caching the obstacle, see SignedDistanceField
+    FLOAT obstacleCellSize;
+    FLOAT obstacleBandWidth;
+
+    // Share of normal velocity kept after reflection from the obstacle and Coulomb friction coefficient of its surface
+    FLOAT obstacleRestitution;
+    FLOAT obstacleFriction;
+
+    // Particles moving farther than the distance in one step are swept against the obstacles, so they do not
+    // tunnel through thin features, see Collision::gatherCollisions()
+    bool sweptCollisions;
+    FLOAT sweptCollisionDistance;
+
+    // Walls and obstacles are sampled with static particles taking part in density and pressure, see BoundaryParticles
+    bool boundaryParticles;
+    FLOAT boundarySpacing;
+
+    // Particles are placed in memory by the pool workers which own them, see SPH
+    bool firstTouchAllocation;
+
+    // Derived constants (Formulae 4.3, 4.4, 4.14, 4.22)
+    FLOAT supportRadiusSqr;
+    FLOAT kernelDefaultMultiplier;
+    FLOAT kernelDefaultGradientMultiplier;
+    FLOAT kernelPressureGradientMultiplier;
+    FLOAT kernelViscosityLaplacianMultiplier;
+    FLOAT ownDensity;
+};
+
+} // namespace SPHSDK
+
+#endif // SIMULATION_PARAMS_H_86962C78ED154C88A4F6C0A7DF1503B7
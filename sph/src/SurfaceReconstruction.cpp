@@ -0,0 +1,246 @@
+/**
+ * @file SurfaceReconstruction.cpp
+ * @author Anton Artyukh (artyukhanton@gmail.com)
+ * @date Created Oct 19, 2026
+ **/
+
+#include "SurfaceReconstruction.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+namespace SPHSDK
+{
+
+SurfaceReconstruction::SurfaceReconstruction(const SimulationParams& params, FLOAT cellSize, FLOAT isoLevel)
+    : m_params(params)
+    , m_cellSize(0.0)
+    , m_isoLevel(isoLevel)
+{
+    if (!(cellSize > 0.0))
+        throw std::invalid_argument("Surface reconstruction cell size must be positive");
+
+    const FLOAT cellsPerRadius = std::max<FLOAT>(1.0, std::round(m_params.waterSupportRadius / cellSize));
+    m_cellSize = m_params.waterSupportRadius / cellsPerRadius;
+}
+
+void SurfaceReconstruction::reconstruct(const ParticleVect& particles, IndexedMesh& mesh, ThreadPool* pool)
+{
+    buildCells(particles);
+
+    if (m_positions.empty())
+    {
+        mesh.clear();
+        return;
+    }
+
+    const auto field = [this](FLOAT x, FLOAT y, FLOAT z) { return getColourField(Point3F(x, y, z)) - m_isoLevel; };
+    const auto mayContainSurface = [this](const Point3F& min, const Point3F& max) {
+        return this->mayContainSurface(min, max);
+    };
+
+    MarchingCubes::generateCulledMesh(field, m_bounds, m_cellSize, mayContainSurface, mesh, pool);
+}
+
+FLOAT SurfaceReconstruction::getColourField(const Point3F& point) const
+{
+    if (m_positions.empty())
+        return 0.0;
+
+    const FLOAT coordinates[3] = {point.x, point.y, point.z};
+
+    long long cell[3];
+    for (size_t axis = 0u; axis < 3u; ++axis)
+    {
+        if (!std::isfinite(coordinates[axis]))
+            return 0.0;
+
+        cell[axis] = getCellCoordinate(coordinates[axis], axis);
+    }
+
+    FLOAT colour = 0.0;
+
+    // The 27 cells around the point, particles farther than one cell are beyond the support radius
+    for (long long z = cell[2] - 1; z <= cell[2] + 1; ++z)
+        for (long long y = cell[1] - 1; y <= cell[1] + 1; ++y)
+        {
+            // Cells of a row are adjacent in the sorted arrays
+            const CellKey last(z, y, cell[0] + 1);
+
+            for (auto c = std::lower_bound(m_cells.begin(), m_cells.end(), CellKey(z, y, cell[0] - 1));
+                 c != m_cells.end() && *c <= last; ++c)
+            {
+                const size_t index = static_cast<size_t>(c - m_cells.begin());
+
+                for (size_t j = m_cellStarts[index]; j < m_cellStarts[index + 1u]; ++j)
+                {
+                    const FLOAT difference = m_params.supportRadiusSqr - (point - m_positions[j]).calcNormSqr();
+
+                    // Poly6 kernel of density (Formula 4.3)
+                    if (difference > 0.0)
+                        colour +=
+                            m_volumes[j] * m_params.kernelDefaultMultiplier * difference * difference * difference;
+                }
+            }
+        }
+
+    return colour;
+}
+
+const Cuboid& SurfaceReconstruction::getBounds() const
+{
+    return m_bounds;
+}
+
+FLOAT SurfaceReconstruction::getCellSize() const
+{
+    return m_cellSize;
+}
+
+void SurfaceReconstruction::buildCells(const ParticleVect& particles)
+{
+    m_cells.clear();
+    m_cellStarts.clear();
+    m_positions.clear();
+    m_volumes.clear();
+    m_sortedParticles.clear();
+
+    // Diverged particles have no place in the grid and add nothing to the field
+    const auto isFinite = [](const Point3F& position) {
+        return std::isfinite(position.x) && std::isfinite(position.y) && std::isfinite(position.z);
+    };
+
+    bool isEmpty = true;
+    Point3F min;
+    Point3F max;
+
+    for (const Particle& particle : particles)
+    {
+        const Point3F& position = particle.position;
+        if (!isFinite(position))
+            continue;
+
+        min = isEmpty ? position
+                      : Point3F(std::min(min.x, position.x), std::min(min.y, position.y), std::min(min.z, position.z));
+        max = isEmpty ? position
+                      : Point3F(std::max(max.x, position.x), std::max(max.y, position.y), std::max(max.z, position.z));
+        isEmpty = false;
+    }
+
+    if (isEmpty)
+    {
+        m_bounds = Cuboid();
+        return;
+    }
+
+    const FLOAT supportRadius = m_params.waterSupportRadius;
+
+    // One empty cell around the particles, the field reaches one support radius out of them
+    const FLOAT extents[3] = {max.x - min.x, max.y - min.y, max.z - min.z};
+    FLOAT sides[3];
+    for (size_t axis = 0u; axis < 3u; ++axis)
+    {
+        sides[axis] = (std::floor(extents[axis] / supportRadius) + 3.0) * supportRadius;
+
+        // Cell coordinates of the particles and of the marching cubes grid must fit their integers
+        if (!(sides[axis] / m_cellSize < static_cast<FLOAT>(MarchingCubes::MaxCellsNumber)))
+        {
+            m_bounds = Cuboid();
+            throw std::invalid_argument("Particles are spread over too many cells to reconstruct the surface");
+        }
+    }
+
+    m_bounds = Cuboid(min - Point3F(supportRadius, supportRadius, supportRadius), sides[0], sides[1], sides[2]);
+
+    // Sorted by cells and then by indices, so particles of a cell keep their order
+    for (size_t i = 0u; i < particles.size(); ++i)
+    {
+        const Point3F& position = particles[i].position;
+        if (!isFinite(position))
+            continue;
+
+        m_sortedParticles.emplace_back(CellKey(getCellCoordinate(position.z, 2u), getCellCoordinate(position.y, 1u),
+                                               getCellCoordinate(position.x, 0u)),
+                                       i);
+    }
+
+    std::sort(m_sortedParticles.begin(), m_sortedParticles.end());
+
+    m_positions.reserve(m_sortedParticles.size());
+    m_volumes.reserve(m_sortedParticles.size());
+
+    for (const auto& sortedParticle : m_sortedParticles)
+    {
+        if (m_cells.empty() || m_cells.back() != sortedParticle.first)
+        {
+            m_cells.push_back(sortedParticle.first);
+            m_cellStarts.push_back(m_positions.size());
+        }
+
+        const Particle& particle = particles[sortedParticle.second];
+        const FLOAT density = particle.density > 0.0 ? particle.density : m_params.waterDensity;
+
+        m_positions.push_back(particle.position);
+        m_volumes.push_back(m_params.waterParticleMass / density);
+    }
+
+    m_cellStarts.push_back(m_positions.size());
+}
+
+bool SurfaceReconstruction::mayContainSurface(const Point3F& min, const Point3F& max) const
+{
+    const FLOAT minCoordinates[3] = {min.x, min.y, min.z};
+    const FLOAT maxCoordinates[3] = {max.x, max.y, max.z};
+
+    // Cells [first, last] of particles within one cell from the box
+    long long first[3];
+    long long last[3];
+
+    for (size_t axis = 0u; axis < 3u; ++axis)
+    {
+        first[axis] = getCellCoordinate(minCoordinates[axis], axis) - 1;
+        last[axis] = getCellCoordinate(maxCoordinates[axis], axis) + 1;
+    }
+
+    // Walks the occupied cells from the first one in the box, every step skips to the next row
+    // or plane the box may have cells in, so empty parts of the box cost nothing
+    auto c = std::lower_bound(m_cells.begin(), m_cells.end(), CellKey(first[2], first[1], first[0]));
+
+    while (c != m_cells.end())
+    {
+        const long long z = std::get<0>(*c);
+        const long long y = std::get<1>(*c);
+        const long long x = std::get<2>(*c);
+
+        if (z > last[2])
+            return false;
+
+        CellKey next;
+        if (y < first[1])
+            next = CellKey(z, first[1], first[0]);
+        else if (y > last[1])
+            next = CellKey(z + 1, first[1], first[0]);
+        else if (x < first[0])
+            next = CellKey(z, y, first[0]);
+        else if (x > last[0])
+            next = CellKey(z, y + 1, first[0]);
+        else
+            return true;
+
+        c = std::lower_bound(c, m_cells.end(), next);
+    }
+
+    return false;
+}
+
+long long SurfaceReconstruction::getCellCoordinate(FLOAT coordinate, size_t axis) const
+{
+    const FLOAT origin =
+        axis == 0u ? m_bounds.startingPoint.x : (axis == 1u ? m_bounds.startingPoint.y : m_bounds.startingPoint.z);
+
+    return static_cast<long long>(std::floor((coordinate - origin) / m_params.waterSupportRadius));
+}
+
+} // namespace SPHSDK
@@ -0,0 +1,106 @@
+/**
+ * @file SurfaceReconstruction.h
+ * @author Anton Artyukh (artyukhanton@gmail.com)
+ * @date Created Oct 19, 2026
+ **/
+
+#ifndef SURFACE_RECONSTRUCTION_H_A3F60C9E2D7B4E8591C4D02B6E7F1A35
+#define SURFACE_RECONSTRUCTION_H_A3F60C9E2D7B4E8591C4D02B6E7F1A35
+
+#include "Particle.h"
+#include "SimulationParams.h"
+
+#include "algorithms/src/Area.h"
+#include "algorithms/src/Defines.h"
+#include "algorithms/src/MarchingCubes.h"
+
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace SPHSDK
+{
+
+class ThreadPool;
+
+/**
+ * @brief SurfaceReconstruction class meshes the free surface of the fluid.
+ * Particles splat their volume mass / density with the density kernel into the colour field,
+ * which is about 1 inside of the fluid and 0 outside, the surface is its isoLevel.
+ *
+ * Particles are kept in cells of the support radius like in the neighbour search, the field in a point
+ * sums only the 27 cells around it, and marching cubes visit only the cells of the grid
+ * within one search cell from an occupied one, so empty space is never evaluated.
+ * Only occupied cells are stored, sorted along z, y and x, so a particle far from the others
+ * widens the bounds but costs no memory or time for the empty cells between them.
+ * The boxes of NeighboursSearch3D are not reused: they cover only the volume of a simulation, clamp or wrap
+ * the points outside of it into its side boxes, and belong to an SPH, while any particles may be meshed here.
+ */
+class SurfaceReconstruction
+{
+public:
+    /**
+     * @param cellSize    The side of marching cubes cells, rounded so the support radius is a whole number of them
+     * @param isoLevel    The level of the colour field on the surface
+     */
+    SurfaceReconstruction(const SimulationParams& params, FLOAT cellSize, FLOAT isoLevel = 0.5);
+
+    /**
+     * @brief Replaces mesh with the surface of the particles, its buffers are reused.
+     * Particles without density (not computed yet) are taken at the rest density.
+     * Particles with infinite or NaN coordinates are skipped.
+     * @param pool    The pool evaluating the field in parallel, may be nullptr
+     * @throw std::invalid_argument if the particles span more than MarchingCubes::MaxCellsNumber cells along an axis
+     */
+    void reconstruct(const ParticleVect& particles, IndexedMesh& mesh, ThreadPool* pool = nullptr);
+
+    /**
+     * @brief Returns the colour field of the particles of the last reconstruct() in the point.
+     */
+    FLOAT getColourField(const Point3F& point) const;
+
+    /**
+     * @brief Returns the grid of the last reconstruct(), the particles with one support radius around them.
+     */
+    const Cuboid& getBounds() const;
+
+    FLOAT getCellSize() const;
+
+private:
+    // Search cell along z, y and x, so the cells of a row along x are adjacent when sorted
+    using CellKey = std::tuple<long long, long long, long long>;
+
+    void buildCells(const ParticleVect& particles);
+
+    bool mayContainSurface(const Point3F& min, const Point3F& max) const;
+
+    // Index of the search cell along the axis, may be outside of the bounds
+    long long getCellCoordinate(FLOAT coordinate, size_t axis) const;
+
+private:
+    SimulationParams m_params;
+
+    FLOAT m_cellSize;
+
+    FLOAT m_isoLevel;
+
+    Cuboid m_bounds;
+
+    // Occupied cells in increasing order
+    std::vector<CellKey> m_cells;
+
+    // Particles of cell m_cells[c] are m_positions[m_cellStarts[c], m_cellStarts[c + 1])
+    SizetVector m_cellStarts;
+
+    Point3FVector m_positions;
+
+    // mass / density of every particle
+    std::vector<FLOAT> m_volumes;
+
+    // Cells and indices of the particles sorted by buildCells()
+    std::vector<std::pair<CellKey, size_t>> m_sortedParticles;
+};
+
+} // namespace SPHSDK
+
+#endif // SURFACE_RECONSTRUCTION_H_A3F60C9E2D7B4E8591C4D02B6E7F1A35
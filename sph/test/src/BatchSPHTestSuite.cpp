@@ -0,0 +1,110 @@
+/**
+ * @file BatchSPHTestSuite.cpp
+ * @author Anton Artyukh (artyukhanton@gmail.com)
+ * @date Created Oct 19, 2026
+ **/
+
+#include "BatchSPHTestSuite.h"
+#include "SPHTestHelpers.h"
+
+#include "BatchSPH.h"
+
+#include <gtest/gtest.h>
+
+namespace SPHSDK
+{
+namespace TestEnvironment
+{
+
+static SimulationParams makeSweepParams(FLOAT viscosity, FLOAT stiffness)
+{
+    SimulationParams params = makeParams(400u);
+    params.waterViscosity = viscosity;
+    params.waterStiffness = stiffness;
+    return params;
+}
+
+void BatchSPHTestSuite::scenesKeepOwnParams()
+{
+    BatchSPH batch(2);
+
+    ASSERT_EQ(0u, batch.addScene(makeSweepParams(1.0, 2.0)));
+    ASSERT_EQ(1u, batch.addScene(makeSweepParams(5.0, 4.0)));
+    ASSERT_EQ(2u, batch.getScenesNumber());
+
+    EXPECT_DOUBLE_EQ(1.0, batch.getScene(0).getParams().waterViscosity);
+    EXPECT_DOUBLE_EQ(2.0, batch.getScene(0).getParams().waterStiffness);
+    EXPECT_DOUBLE_EQ(5.0, batch.getScene(1).getParams().waterViscosity);
+    EXPECT_DOUBLE_EQ(4.0, batch.getScene(1).getParams().waterStiffness);
+    EXPECT_EQ(400u, batch.getScene(1).particles.size());
+}
+
+void BatchSPHTestSuite::batchMatchesStandaloneScenes()
+{
+    const std::vector<SimulationParams> sweep = {makeSweepParams(1.0, 3.0), makeSweepParams(3.5, 3.0),
+                                                 makeSweepParams(3.5, 6.0), makeSweepParams(7.0, 1.5),
+                                                 makeSweepParams(0.5, 3.0)};
+    const size_t stepsNumber = 5u;
+
+    BatchSPH batch(3);
+    for (const auto& params : sweep)
+        batch.addScene(params);
+
+    batch.run(stepsNumber);
+
+    for (size_t sceneIndex = 0u; sceneIndex < sweep.size(); ++sceneIndex)
+    {
+        SPH standalone(sweep[sceneIndex]);
+        for (size_t i = 0u; i < stepsNumber; ++i)
+            standalone.run();
+
+        const ParticleVect& batchParticles = batch.getScene(sceneIndex).particles;
+        ASSERT_EQ(standalone.particles.size(), batchParticles.size());
+
+        for (size_t i = 0u; i < batchParticles.size(); ++i)
+        {
+            expectSamePoint(standalone.particles[i].position, batchParticles[i].position);
+            expectSamePoint(standalone.particles[i].velocity, batchParticles[i].velocity);
+        }
+    }
+}
+
+void BatchSPHTestSuite::idleThreadsStealSceneBlocks()
+{
+    BatchSPH batch(4);
+    batch.addScene(makeParams(1500u));
+    batch.addScene(makeParams(400u));
+
+    ThreadPool& pool = batch.getScene(0).getThreadPool();
+    pool.resetWorkerStats();
+
+    batch.run(3u);
+
+    // Workers are not tied to scenes, so all four take blocks of the two scenes
+    size_t busyWorkers = 0u;
+    for (const WorkerStats& stats : pool.getWorkerStats())
+        if (stats.tasksRun > 0u)
+            ++busyWorkers;
+
+    EXPECT_GT(busyWorkers, 2u);
+}
+
+} // namespace TestEnvironment
+} // namespace SPHSDK
+
+using namespace SPHSDK::TestEnvironment;
+
+TEST(BatchSPHTestSuite, scenesKeepOwnParams)
+{
+    BatchSPHTestSuite::scenesKeepOwnParams();
+}
+
+TEST(BatchSPHTestSuite, batchMatchesStandaloneScenes)
+{
+    BatchSPHTestSuite::batchMatchesStandaloneScenes();
+}
+
+TEST(BatchSPHTestSuite, idleThreadsStealSceneBlocks)
+{
+    BatchSPHTestSuite::idleThreadsStealSceneBlocks();
+}
@@ -0,0 +1,29 @@
+/**
+ * @file BatchSPHTestSuite.h
+ * @author Anton Artyukh (artyukhanton@gmail.com)
+ * @date Created Oct 19, 2026
+ **/
+
+#ifndef BATCH_SPH_TEST_SUITE_H_46E8C75CE4A245B9B8D3DE4515671ED5
+#define BATCH_SPH_TEST_SUITE_H_46E8C75CE4A245B9B8D3DE4515671ED5
+
+namespace SPHSDK
+{
+
+namespace TestEnvironment
+{
+
+class BatchSPHTestSuite
+{
+public:
+    static void scenesKeepOwnParams();
+
+    static void batchMatchesStandaloneScenes();
+
+    static void idleThreadsStealSceneBlocks();
+};
+
+} // namespace TestEnvironment
+} // namespace SPHSDK
+
+#endif // BATCH_SPH_TEST_SUITE_H_46E8C75CE4A245B9B8D3DE4515671ED5
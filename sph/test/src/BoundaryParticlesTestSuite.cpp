@@ -0,0 +1,249 @@
+/**
+ * @file BoundaryParticlesTestSuite.cpp
+ * @author Anton Artyukh (artyukhanton@gmail.com)
+ * @date Created Oct 19, 2026
+ **/
+
+#include "BoundaryParticlesTestSuite.h"
+
+#include "BoundaryParticles.h"
+#include "Forces.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <set>
+#include <tuple>
+
+namespace SPHSDK
+{
+namespace TestEnvironment
+{
+
+static Volume makeVolume(FLOAT side)
+{
+    return Volume(Cuboid(Point3F(), side, side, side));
+}
+
+static FLOAT sumKernels(const BoundaryParticles& boundary, const Point3F& point, const SimulationParams& params)
+{
+    SizetVector neighbours;
+    boundary.findNeighbours(point, neighbours);
+
+    FLOAT sum = 0.0;
+    for (const size_t b : neighbours)
+    {
+        const FLOAT difference = params.supportRadiusSqr - (point - boundary.getPositions()[b]).calcNormSqr();
+        sum += boundary.getMasses()[b] * params.kernelDefaultMultiplier * difference * difference * difference;
+    }
+
+    return sum;
+}
+
+void BoundaryParticlesTestSuite::wallsAreSampledOnce()
+{
+    SimulationParams params;
+    params.boundarySpacing = 0.015;
+
+    BoundaryParticles boundary;
+    boundary.sample(makeVolume(0.3), nullptr, params);
+
+    // 20 intervals along every side
+    EXPECT_EQ(6u * 20u * 20u + 2u, boundary.size());
+
+    std::set<std::tuple<long long, long long, long long>> unique;
+
+    for (const Point3F& position : boundary.getPositions())
+    {
+        const auto isOnWall = [](FLOAT coordinate) {
+            return std::abs(coordinate) < 1e-12 || std::abs(coordinate - 0.3) < 1e-12;
+        };
+        EXPECT_TRUE(isOnWall(position.x) || isOnWall(position.y) || isOnWall(position.z));
+
+        unique.insert(std::make_tuple(std::llround(position.x / 0.015), std::llround(position.y / 0.015),
+                                      std::llround(position.z / 0.015)));
+    }
+
+    EXPECT_EQ(boundary.size(), unique.size());
+}
+
+void BoundaryParticlesTestSuite::neighboursMatchBruteForce()
+{
+    SimulationParams params;
+
+    BoundaryParticles boundary;
+    boundary.sample(makeVolume(0.5), nullptr, params);
+
+    std::mt19937 generator(7u);
+    std::uniform_real_distribution<FLOAT> coordinate(-0.2, 0.7);
+
+    SizetVector neighbours;
+
+    for (size_t test = 0u; test < 200u; ++test)
+    {
+        const Point3F point(coordinate(generator), coordinate(generator), coordinate(generator));
+
+        boundary.findNeighbours(point, neighbours);
+        std::sort(neighbours.begin(), neighbours.end());
+
+        SizetVector expected;
+        for (size_t b = 0u; b < boundary.size(); ++b)
+            if ((boundary.getPositions()[b] - point).calcNormSqr() < params.supportRadiusSqr)
+                expected.push_back(b);
+
+        EXPECT_EQ(expected, neighbours);
+    }
+}
+
+void BoundaryParticlesTestSuite::wallGivesRestDensity()
+{
+    SimulationParams params;
+
+    BoundaryParticles boundary;
+    boundary.sample(makeVolume(1.0), nullptr, params);
+
+    // Far from edges the wall is a regular plane, so a point on it gets exactly the rest density
+    const Point3F middle(0.5, 0.5, 0.0);
+
+    SizetVector neighbours;
+    boundary.findNeighbours(middle, neighbours);
+    ASSERT_FALSE(neighbours.empty());
+
+    Point3F center = boundary.getPositions()[neighbours.front()];
+    for (const size_t b : neighbours)
+        if ((boundary.getPositions()[b] - middle).calcNormSqr() < (center - middle).calcNormSqr())
+            center = boundary.getPositions()[b];
+
+    EXPECT_NEAR(params.waterDensity, sumKernels(boundary, center, params), 1e-9 * params.waterDensity);
+
+    // The density fades with the distance from the wall
+    EXPECT_GT(sumKernels(boundary, center + Point3F(0.0, 0.0, 0.01), params), 0.5 * params.waterDensity);
+    EXPECT_DOUBLE_EQ(0.0, sumKernels(boundary, center + Point3F(0.0, 0.0, 0.11), params));
+}
+
+void BoundaryParticlesTestSuite::obstacleIsSampledOnSurface()
+{
+    SimulationParams params;
+
+    const FLOAT radius = 0.2;
+    const Point3F ballCenter(0.5, 0.5, 0.5);
+
+    ObstacleScene scene;
+    scene.addShape(
+        [&ballCenter, radius](FLOAT x, FLOAT y, FLOAT z) {
+            return radius * radius - (Point3F(x, y, z) - ballCenter).calcNormSqr();
+        },
+        Cuboid(ballCenter - Point3F(radius, radius, radius), 2.0 * radius, 2.0 * radius, 2.0 * radius), 0.02, 0.08);
+
+    BoundaryParticles walls;
+    walls.sample(makeVolume(1.0), nullptr, params);
+
+    BoundaryParticles boundary;
+    boundary.sample(makeVolume(1.0), &scene, params);
+
+    ASSERT_GT(boundary.size(), walls.size());
+
+    size_t ballParticles = 0u;
+    for (const Point3F& position : boundary.getPositions())
+    {
+        const FLOAT distance = (position - ballCenter).calcNorm();
+        if (distance < 0.4)
+        {
+            EXPECT_NEAR(radius, distance, 2e-3);
+            ++ballParticles;
+        }
+    }
+
+    EXPECT_EQ(boundary.size() - walls.size(), ballParticles);
+}
+
+void BoundaryParticlesTestSuite::wallPushesParticleAway()
+{
+    SimulationParams params;
+
+    BoundaryParticles boundary;
+    boundary.sample(makeVolume(1.0), nullptr, params);
+
+    ParticleVect particles(1u, Particle(Point3F(0.5, 0.5, 0.02)));
+    boundary.findNeighbours(particles[0].position, particles[0].boundaryNeighbours);
+
+    const SizetVector indices(1u, 0u);
+
+    Forces::ComputeDensityAndPressure(particles, indices, params);
+    const FLOAT freeDensity = particles[0].density;
+
+    Forces::ComputeDensityAndPressure(particles, indices, params, &boundary);
+    EXPECT_GT(particles[0].density, freeDensity + 0.5 * params.waterDensity);
+
+    Forces::ComputeForces(particles, indices, params, &boundary);
+    EXPECT_GT(particles[0].fPressure.z, 0.0);
+    EXPECT_NEAR(0.0, particles[0].fPressure.x, 1e-9 * particles[0].fPressure.z);
+    EXPECT_NEAR(0.0, particles[0].fPressure.y, 1e-9 * particles[0].fPressure.z);
+}
+
+void BoundaryParticlesTestSuite::periodicAxisHasNoWalls()
+{
+    SimulationParams params;
+    params.boundarySpacing = 0.015;
+
+    BoundaryParticles boundary;
+    boundary.sample(Volume(Cuboid(Point3F(), 0.3, 0.3, 0.3), {true, false, false}), nullptr, params);
+
+    // 20 samples along x, the walls of y and z share the edges of y
+    size_t insideParticles = 0u;
+    for (const Point3F& position : boundary.getPositions())
+    {
+        EXPECT_TRUE(std::abs(position.y) < 1e-12 || std::abs(position.y - 0.3) < 1e-12 || std::abs(position.z) < 1e-12 ||
+                    std::abs(position.z - 0.3) < 1e-12);
+
+        if (position.x > -1e-12 && position.x < 0.3 - 1e-12)
+            ++insideParticles;
+    }
+
+    EXPECT_EQ(2u * 20u * 21u + 2u * 20u * 19u, insideParticles);
+    EXPECT_GT(boundary.size(), insideParticles);
+
+    // With the images of the other side the floor does not change along x, the seam included
+    const FLOAT density = sumKernels(boundary, Point3F(0.15, 0.15, 0.0), params);
+    EXPECT_GT(density, 0.9 * params.waterDensity);
+
+    for (const FLOAT x : {0.0, 0.015, 0.285})
+        EXPECT_NEAR(density, sumKernels(boundary, Point3F(x, 0.15, 0.0), params), 1e-9 * density);
+}
+
+} // namespace TestEnvironment
+} // namespace SPHSDK
+
+using namespace SPHSDK::TestEnvironment;
+
+TEST(BoundaryParticlesTestSuite, wallsAreSampledOnce)
+{
+    BoundaryParticlesTestSuite::wallsAreSampledOnce();
+}
+
+TEST(BoundaryParticlesTestSuite, neighboursMatchBruteForce)
+{
+    BoundaryParticlesTestSuite::neighboursMatchBruteForce();
+}
+
+TEST(BoundaryParticlesTestSuite, wallGivesRestDensity)
+{
+    BoundaryParticlesTestSuite::wallGivesRestDensity();
+}
+
+TEST(BoundaryParticlesTestSuite, obstacleIsSampledOnSurface)
+{
+    BoundaryParticlesTestSuite::obstacleIsSampledOnSurface();
+}
+
+TEST(BoundaryParticlesTestSuite, wallPushesParticleAway)
+{
+    BoundaryParticlesTestSuite::wallPushesParticleAway();
+}
+
+TEST(BoundaryParticlesTestSuite, periodicAxisHasNoWalls)
+{
+    BoundaryParticlesTestSuite::periodicAxisHasNoWalls();
+}
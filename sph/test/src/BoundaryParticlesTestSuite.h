@@ -0,0 +1,35 @@
+/**
+ * @file BoundaryParticlesTestSuite.h
+ * @author Anton Artyukh (artyukhanton@gmail.com)
+ * @date Created Oct 19, 2026
+ **/
+
+#ifndef BOUNDARY_PARTICLES_TEST_SUITE_H_8E41C07D2B5A4F6390D1E7A5C3B2F846
+#define BOUNDARY_PARTICLES_TEST_SUITE_H_8E41C07D2B5A4F6390D1E7A5C3B2F846
+
+namespace SPHSDK
+{
+
+namespace TestEnvironment
+{
+
+class BoundaryParticlesTestSuite
+{
+public:
+    static void wallsAreSampledOnce();
+
+    static void neighboursMatchBruteForce();
+
+    static void wallGivesRestDensity();
+
+    static void obstacleIsSampledOnSurface();
+
+    static void wallPushesParticleAway();
+
+    static void periodicAxisHasNoWalls();
+};
+
+} // namespace TestEnvironment
+} // namespace SPHSDK
+
+#endif // BOUNDARY_PARTICLES_TEST_SUITE_H_8E41C07D2B5A4F6390D1E7A5C3B2F846
@@ -7,10 +7,14 @@
 #include "CollisionsTestSuite.h"
 
 #include "Collisions.h"
+#include "Config.h"
 #include "algorithms/src/Area.h"
 
 #include <gtest/gtest.h>
 
+#include <cmath>
+#include <limits>
+
 namespace SPHSDK
 {
 namespace TestEnvironment
@@ -360,6 +364,285 @@ void CollisionsTestSuite::threeOnBoundaryParticleCollision()
     EXPECT_DOUBLE_EQ(1.0, particleVector[2].velocity.z);
 }
 
+void CollisionsTestSuite::onlyCandidatesCollide()
+{
+    ParticleVect particleVector = {Particle(Point3F(0.5, 0.5, 0.5)), Particle(Point3F(0.51, 0.5, 0.5))};
+    particleVector[0].velocity = Point3F(1.0, 0.0, 0.0);
+    particleVector[1].velocity = Point3F(-1.0, 0.0, 0.0);
+    particleVector[0].neighbours = {1};
+    particleVector[1].neighbours = {0};
+    Volume volume(Cuboid(Point3F(0.0, 0.0, 0.0), 1.0, 1.0, 1.0));
+
+    // The second particle has no candidates, so its neighbour is not tested
+    const VectorOfSizetVectors candidates = {{1}, {}};
+
+    CollisionBuffers buffers;
+    buffers.resize(particleVector.size());
+
+    Collision::gatherCollisions(particleVector, SizetVector({0, 1}), candidates, volume, nullptr, SimulationParams(),
+                                buffers);
+    Collision::applyCollisions(particleVector, SizetVector({0, 1}), buffers);
+
+    EXPECT_DOUBLE_EQ(0.5 - Config::ParticleRadius, particleVector[0].position.x);
+    EXPECT_DOUBLE_EQ(-1.0, particleVector[0].velocity.x);
+    EXPECT_DOUBLE_EQ(0.51, particleVector[1].position.x);
+    EXPECT_DOUBLE_EQ(-1.0, particleVector[1].velocity.x);
+}
+
+void CollisionsTestSuite::gatherDoesNotDependOnOrder()
+{
+    ParticleVect particleVector = {Particle(Point3F(0.5, 0.5, 0.5)), Particle(Point3F(0.51, 0.5, 0.5)),
+                                   Particle(Point3F(0.5, 0.51, 0.5))};
+    particleVector[0].velocity = Point3F(1.0, 1.0, 0.0);
+    particleVector[1].velocity = Point3F(-1.0, 0.0, 0.0);
+    particleVector[2].velocity = Point3F(0.0, -1.0, 0.0);
+    Volume volume(Cuboid(Point3F(0.0, 0.0, 0.0), 1.0, 1.0, 1.0));
+
+    const VectorOfSizetVectors candidates = {{1, 2}, {0, 2}, {0, 1}};
+
+    ParticleVect forward = particleVector;
+    ParticleVect backward = particleVector;
+    CollisionBuffers buffers;
+    buffers.resize(particleVector.size());
+
+    Collision::gatherCollisions(forward, SizetVector({0, 1, 2}), candidates, volume, nullptr, SimulationParams(),
+                                buffers);
+    Collision::applyCollisions(forward, SizetVector({0, 1, 2}), buffers);
+
+    // Gathered one particle at a time in reverse order
+    for (size_t i = backward.size(); i > 0u; --i)
+        Collision::gatherCollisions(backward, SizetVector({i - 1u}), candidates, volume, nullptr, SimulationParams(),
+                                    buffers);
+    Collision::applyCollisions(backward, SizetVector({2, 1, 0}), buffers);
+
+    for (size_t i = 0u; i < particleVector.size(); ++i)
+    {
+        EXPECT_DOUBLE_EQ(forward[i].position.x, backward[i].position.x);
+        EXPECT_DOUBLE_EQ(forward[i].position.y, backward[i].position.y);
+        EXPECT_DOUBLE_EQ(forward[i].velocity.x, backward[i].velocity.x);
+        EXPECT_DOUBLE_EQ(forward[i].velocity.y, backward[i].velocity.y);
+    }
+
+    // Both particles of a pair are pushed apart, not only the first one
+    EXPECT_DOUBLE_EQ(0.51 + Config::ParticleRadius, forward[1].position.x);
+    EXPECT_DOUBLE_EQ(0.51 + Config::ParticleRadius, forward[2].position.y);
+}
+
+void CollisionsTestSuite::obstacleFieldProjectsParticle()
+{
+    const Cuboid cuboid(Point3F(0.0, 0.0, 0.0), 1.0, 1.0, 1.0);
+    Volume volume(cuboid);
+
+    // Ball of radius 0.2 in the centre of the volume
+    ObstacleScene obstacles;
+    obstacles.addShape(
+        [](FLOAT x, FLOAT y, FLOAT z) {
+            return 0.04 - (x - 0.5) * (x - 0.5) - (y - 0.5) * (y - 0.5) - (z - 0.5) * (z - 0.5);
+        },
+        Cuboid(Point3F(0.3, 0.3, 0.3), 0.4, 0.4, 0.4), 0.02, 0.08);
+
+    // The first particle entered the ball from below, the second one is far from it
+    ParticleVect particleVector = {Particle(Point3F(0.5, 0.5, 0.32)), Particle(Point3F(0.5, 0.5, 0.1))};
+    particleVector[0].previous_position = Point3F(0.5, 0.5, 0.28);
+    particleVector[0].velocity = Point3F(1.0, 0.0, 2.0);
+    particleVector[1].previous_position = Point3F(0.5, 0.5, 0.12);
+    particleVector[1].velocity = Point3F(0.0, 0.0, -2.0);
+
+    const VectorOfSizetVectors candidates = {{}, {}};
+
+    CollisionBuffers buffers;
+    buffers.resize(particleVector.size());
+
+    Collision::gatherCollisions(particleVector, SizetVector({0, 1}), candidates, volume, &obstacles,
+                                SimulationParams(), buffers);
+    Collision::applyCollisions(particleVector, SizetVector({0, 1}), buffers);
+
+    // Projected to the surface, the normal velocity is reflected, friction slows down the tangential one
+    // Up to the interpolation error of the 0.02 grid
+    EXPECT_NEAR(0.3, particleVector[0].position.z, 2e-3);
+    EXPECT_NEAR(0.5, particleVector[0].position.x, 2e-3);
+    EXPECT_NEAR(-2.0 * Config::ObstacleRestitution, particleVector[0].velocity.z, 1e-2);
+    EXPECT_NEAR(1.0 - Config::ObstacleFriction * (1.0 + Config::ObstacleRestitution) * 2.0,
+                particleVector[0].velocity.x, 1e-2);
+
+    EXPECT_DOUBLE_EQ(0.1, particleVector[1].position.z);
+    EXPECT_DOUBLE_EQ(-2.0, particleVector[1].velocity.z);
+}
+
+void CollisionsTestSuite::obstacleFunctionProjectsParticle()
+{
+    Volume volume(Cuboid(Point3F(0.0, 0.0, 0.0), 1.0, 1.0, 1.0));
+
+    const std::function<FLOAT(FLOAT, FLOAT, FLOAT)> obstacle = [](FLOAT x, FLOAT y, FLOAT z) {
+        return 0.04 - (x - 0.5) * (x - 0.5) - (y - 0.5) * (y - 0.5) - (z - 0.5) * (z - 0.5);
+    };
+
+    // Enters the ball from the side moving away from its surface, so the velocity is kept
+    ParticleVect particleVector = {Particle(Point3F(0.69, 0.5, 0.5))};
+    particleVector[0].previous_position = Point3F(0.71, 0.5, 0.5);
+    particleVector[0].velocity = Point3F(0.5, 0.0, 0.0);
+
+    SimulationParams params;
+    params.obstacleFriction = 0.0;
+
+    Collision::detectCollisions(particleVector, volume, &obstacle, params);
+
+    // f / |grad f| slightly overestimates the depth of the ball
+    EXPECT_NEAR(0.7, particleVector[0].position.x, 1e-3);
+    EXPECT_DOUBLE_EQ(0.5, particleVector[0].position.y);
+    EXPECT_DOUBLE_EQ(0.5, particleVector[0].velocity.x);
+    EXPECT_LE(obstacle(particleVector[0].position.x, 0.5, 0.5), 0.0);
+}
+
+void CollisionsTestSuite::clampToVolumeMatchesWalls()
+{
+    const FLOAT nan = std::numeric_limits<FLOAT>::quiet_NaN();
+
+    // Odd number of particles, so both the paired and the single loop run
+    ParticleComponents components;
+    components.resize(5u);
+
+    components.x = {-1.0, 0.5, 2.5, nan, 0.5};
+    components.y = {0.5, 3.0, 0.5, 0.5, 0.5};
+    components.z = {0.5, 0.5, 0.5, 0.5, 0.5};
+    components.velocityX = {-2.0, 1.0, 4.0, 1.0, 1.0};
+    components.velocityY = {1.0, 2.0, 1.0, 1.0, 1.0};
+    components.velocityZ = {1.0, 1.0, 1.0, 1.0, 1.0};
+    // The last particle is wider than the cuboid, it is clamped to both walls
+    components.radius = {0.1, 0.1, 0.1, 0.1, 0.6};
+
+    Collision::clampToVolume(components, Volume(Cuboid(Point3F(), 2.0, 2.0, 1.0)), -0.5);
+
+    EXPECT_DOUBLE_EQ(0.1, components.x[0]);
+    EXPECT_DOUBLE_EQ(1.0, components.velocityX[0]);
+    EXPECT_DOUBLE_EQ(0.5, components.y[0]);
+    EXPECT_DOUBLE_EQ(1.0, components.velocityY[0]);
+
+    EXPECT_DOUBLE_EQ(0.5, components.x[1]);
+    EXPECT_DOUBLE_EQ(1.0, components.velocityX[1]);
+    EXPECT_DOUBLE_EQ(1.9, components.y[1]);
+    EXPECT_DOUBLE_EQ(-1.0, components.velocityY[1]);
+
+    EXPECT_DOUBLE_EQ(1.9, components.x[2]);
+    EXPECT_DOUBLE_EQ(-2.0, components.velocityX[2]);
+
+    EXPECT_TRUE(std::isnan(components.x[3]));
+    EXPECT_DOUBLE_EQ(1.0, components.velocityX[3]);
+
+    EXPECT_DOUBLE_EQ(0.6, components.z[4]);
+    EXPECT_DOUBLE_EQ(0.25, components.velocityZ[4]);
+
+    for (size_t i = 0u; i < 4u; ++i)
+    {
+        EXPECT_DOUBLE_EQ(0.5, components.z[i]);
+        EXPECT_DOUBLE_EQ(1.0, components.velocityZ[i]);
+    }
+}
+
+void CollisionsTestSuite::clampToVolumeWrapsPeriodicAxes()
+{
+    ParticleComponents components;
+    components.resize(3u);
+
+    components.x = {-0.5, 2.25, 1.0};
+    components.y = {-0.5, 2.25, 1.0};
+    components.z = {0.5, 0.5, 0.5};
+    components.velocityX = {1.0, 1.0, 1.0};
+    components.velocityY = {1.0, 1.0, 1.0};
+    components.velocityZ = {1.0, 1.0, 1.0};
+    components.radius = {0.1, 0.1, 0.1};
+
+    // Only x is periodic
+    Collision::clampToVolume(components, Volume(Cuboid(Point3F(), 2.0, 2.0, 1.0), {true, false, false}), -0.5);
+
+    EXPECT_DOUBLE_EQ(1.5, components.x[0]);
+    EXPECT_DOUBLE_EQ(0.25, components.x[1]);
+    EXPECT_DOUBLE_EQ(1.0, components.x[2]);
+    EXPECT_DOUBLE_EQ(1.0, components.velocityX[0]);
+    EXPECT_DOUBLE_EQ(1.0, components.velocityX[1]);
+
+    EXPECT_DOUBLE_EQ(0.1, components.y[0]);
+    EXPECT_DOUBLE_EQ(1.9, components.y[1]);
+    EXPECT_DOUBLE_EQ(-0.5, components.velocityY[0]);
+    EXPECT_DOUBLE_EQ(-0.5, components.velocityY[1]);
+
+    // Wrapping follows the volume, also when the cuboid does not start at the origin
+    const Volume shiftedVolume(Cuboid(Point3F(1.0, 0.0, 0.0), 2.0, 2.0, 1.0), {true, false, false});
+    components.x = {3.5, -1.25, -1e-17};
+
+    Collision::clampToVolume(components, shiftedVolume, -0.5);
+
+    for (size_t i = 0u; i < 3u; ++i)
+        EXPECT_DOUBLE_EQ(shiftedVolume.wrapPosition(Point3F(components.x[i], 1.0, 0.5)).x, components.x[i]);
+    EXPECT_DOUBLE_EQ(1.5, components.x[0]);
+    EXPECT_DOUBLE_EQ(2.75, components.x[1]);
+}
+
+void CollisionsTestSuite::particlesCollideAcrossPeriodicSide()
+{
+    ParticleVect particleVector = {Particle(Point3F(0.04, 1.0, 1.0), 0.1), Particle(Point3F(1.98, 1.0, 1.0), 0.1)};
+    particleVector[0].velocity = Point3F(-1.0, 0.0, 0.0);
+    particleVector[1].velocity = Point3F(1.0, 0.0, 0.0);
+
+    const VectorOfSizetVectors candidates = {{1}, {0}};
+    const Volume volume(Cuboid(Point3F(), 2.0, 2.0, 2.0), {true, false, false});
+
+    SimulationParams params;
+    params.particleRadius = 0.1;
+
+    CollisionBuffers buffers;
+    buffers.resize(2u);
+
+    Collision::gatherCollisions(particleVector, SizetVector({0, 1}), candidates, volume, nullptr, params, buffers);
+
+    // The particles are 0.06 apart through the side x = 0, they are pushed apart and reflected
+    EXPECT_NEAR(0.14, buffers.positions[0].x, 1e-12);
+    EXPECT_NEAR(1.88, buffers.positions[1].x, 1e-12);
+    EXPECT_GT(buffers.velocities[0].x, 0.0);
+    EXPECT_LT(buffers.velocities[1].x, 0.0);
+}
+
+void CollisionsTestSuite::sweptParticleStopsAtThinObstacle()
+{
+    const Volume volume(Cuboid(Point3F(0.0, 0.0, 0.0), 1.0, 1.0, 1.0));
+
+    // A plate 0.04 thick, the particle jumps over it in one step
+    ObstacleScene obstacles;
+    obstacles.addShape([](FLOAT, FLOAT, FLOAT z) { return 0.02 - std::abs(z - 0.5); },
+                       Cuboid(Point3F(0.2, 0.2, 0.48), 0.6, 0.6, 0.04), 0.02, 0.08);
+
+    ParticleVect particleVector = {Particle(Point3F(0.5, 0.5, 0.7))};
+    particleVector[0].previous_position = Point3F(0.5, 0.5, 0.3);
+    particleVector[0].velocity = Point3F(0.0, 0.0, 40.0);
+
+    const VectorOfSizetVectors candidates = {{}};
+
+    SimulationParams params;
+
+    CollisionBuffers buffers;
+    buffers.resize(1u);
+
+    Collision::gatherCollisions(particleVector, SizetVector({0}), candidates, volume, &obstacles, params, buffers);
+
+    EXPECT_DOUBLE_EQ(0.7, buffers.positions[0].z);
+    EXPECT_DOUBLE_EQ(40.0, buffers.velocities[0].z);
+
+    params.sweptCollisions = true;
+    Collision::gatherCollisions(particleVector, SizetVector({0}), candidates, volume, &obstacles, params, buffers);
+
+    // Stopped at the lower side of the plate and reflected, the plate is only two voxels thick,
+    // so the projection is less precise than for smooth obstacles
+    EXPECT_NEAR(0.48, buffers.positions[0].z, 5e-3);
+    EXPECT_NEAR(0.5, buffers.positions[0].x, 1e-9);
+    EXPECT_NEAR(-40.0 * params.obstacleRestitution, buffers.velocities[0].z, 1e-1);
+
+    // Short steps are not swept
+    particleVector[0].previous_position = Point3F(0.5, 0.5, 0.695);
+    Collision::gatherCollisions(particleVector, SizetVector({0}), candidates, volume, &obstacles, params, buffers);
+
+    EXPECT_DOUBLE_EQ(0.7, buffers.positions[0].z);
+}
+
 } // namespace TestEnvironment
 } // namespace SPHSDK
 
@@ -414,3 +697,43 @@ TEST(CollisionsTestSuite, threeOnBoundaryParticleCollision)
 {
     CollisionsTestSuite::threeOnBoundaryParticleCollision();
 }
+
+TEST(CollisionsTestSuite, onlyCandidatesCollide)
+{
+    CollisionsTestSuite::onlyCandidatesCollide();
+}
+
+TEST(CollisionsTestSuite, gatherDoesNotDependOnOrder)
+{
+    CollisionsTestSuite::gatherDoesNotDependOnOrder();
+}
+
+TEST(CollisionsTestSuite, obstacleFieldProjectsParticle)
+{
+    CollisionsTestSuite::obstacleFieldProjectsParticle();
+}
+
+TEST(CollisionsTestSuite, obstacleFunctionProjectsParticle)
+{
+    CollisionsTestSuite::obstacleFunctionProjectsParticle();
+}
+
+TEST(CollisionsTestSuite, clampToVolumeMatchesWalls)
+{
+    CollisionsTestSuite::clampToVolumeMatchesWalls();
+}
+
+TEST(CollisionsTestSuite, clampToVolumeWrapsPeriodicAxes)
+{
+    CollisionsTestSuite::clampToVolumeWrapsPeriodicAxes();
+}
+
+TEST(CollisionsTestSuite, particlesCollideAcrossPeriodicSide)
+{
+    CollisionsTestSuite::particlesCollideAcrossPeriodicSide();
+}
+
+TEST(CollisionsTestSuite, sweptParticleStopsAtThinObstacle)
+{
+    CollisionsTestSuite::sweptParticleStopsAtThinObstacle();
+}
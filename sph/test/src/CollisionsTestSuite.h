@@ -35,6 +35,22 @@ public:
     static void twoOnBoundaryParticleCollision();
 
     static void threeOnBoundaryParticleCollision();
+
+    static void onlyCandidatesCollide();
+
+    static void gatherDoesNotDependOnOrder();
+
+    static void obstacleFieldProjectsParticle();
+
+    static void obstacleFunctionProjectsParticle();
+
+    static void clampToVolumeMatchesWalls();
+
+    static void clampToVolumeWrapsPeriodicAxes();
+
+    static void particlesCollideAcrossPeriodicSide();
+
+    static void sweptParticleStopsAtThinObstacle();
 };
 
 } // namespace TestEnvironment
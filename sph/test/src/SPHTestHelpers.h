@@ -0,0 +1,50 @@
+/**
+ * @file SPHTestHelpers.h
+ * @author Anton Artyukh (artyukhanton@gmail.com)
+ * @date Created Oct 19, 2026
+ **/
+
+#ifndef SPH_TEST_HELPERS_H_6F2A91C4E07D4B38A5C1D9E82B3F0A67
+#define SPH_TEST_HELPERS_H_6F2A91C4E07D4B38A5C1D9E82B3F0A67
+
+#include "SimulationParams.h"
+
+#include "algorithms/src/ThreadPool.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+namespace SPHSDK
+{
+namespace TestEnvironment
+{
+
+inline SimulationParams makeParams(size_t particlesNumber)
+{
+    SimulationParams params;
+    params.particlesNumber = particlesNumber;
+    return params;
+}
+
+inline ThreadPoolOptions makePoolOptions(size_t threadsNumber)
+{
+    ThreadPoolOptions options;
+    options.threadsNumber = threadsNumber;
+    return options;
+}
+
+// Particles started at the same point turn into NaN, so NaN is treated as equal to NaN
+inline void expectSamePoint(const Point3F& expected, const Point3F& actual)
+{
+    const auto same = [](FLOAT a, FLOAT b) { return a == b || (std::isnan(a) && std::isnan(b)); };
+
+    EXPECT_TRUE(same(expected.x, actual.x));
+    EXPECT_TRUE(same(expected.y, actual.y));
+    EXPECT_TRUE(same(expected.z, actual.z));
+}
+
+} // namespace TestEnvironment
+} // namespace SPHSDK
+
+#endif // SPH_TEST_HELPERS_H_6F2A91C4E07D4B38A5C1D9E82B3F0A67
@@ -0,0 +1,176 @@
+/**
+ * @file SPHTestSuite.cpp
+ * @author Anton Artyukh (artyukhanton@gmail.com)
+ * @date Created Oct 19, 2026
+ **/
+
+#include "SPHTestSuite.h"
+#include "SPHTestHelpers.h"
+
+#include "Forces.h"
+#include "Integrator.h"
+#include "SPH.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cmath>
+
+namespace SPHSDK
+{
+namespace TestEnvironment
+{
+
+void SPHTestSuite::pipelineMatchesSequentialForces()
+{
+    const SimulationParams params = makeParams(1500u);
+
+    SPH sph(params, nullptr, makePoolOptions(4u));
+
+    // Full-array stages without collisions
+    ParticleVect reference = sph.particles;
+    NeighboursSearch3D<ParticleVect> searcher(
+        Volume(Cuboid(Point3F(), params.cubeSize, params.cubeSize, params.cubeSize)), params.waterSupportRadius, 0.001);
+
+    searcher.search(reference);
+    Forces::ComputeAllForces(reference, params);
+    Integrator::integrate(params.timeStep, reference, params);
+
+    sph.run();
+
+    ASSERT_EQ(reference.size(), sph.particles.size());
+
+    for (size_t i = 0u; i < sph.particles.size(); ++i)
+    {
+        EXPECT_EQ(reference[i].neighbours, sph.particles[i].neighbours);
+        EXPECT_DOUBLE_EQ(reference[i].density, sph.particles[i].density);
+        EXPECT_DOUBLE_EQ(reference[i].pressure, sph.particles[i].pressure);
+        expectSamePoint(reference[i].fTotal, sph.particles[i].fTotal);
+        expectSamePoint(reference[i].acceleration, sph.particles[i].acceleration);
+        expectSamePoint(reference[i].previous_position, sph.particles[i].previous_position);
+    }
+}
+
+void SPHTestSuite::pipelineDoesNotDependOnThreadsNumber()
+{
+    SPH first(makeParams(1500u), nullptr, makePoolOptions(1u));
+    SPH second(makeParams(1500u), nullptr, makePoolOptions(4u));
+
+    ASSERT_EQ(4u, second.getThreadPool().getThreadsNumber());
+
+    for (size_t step = 0u; step < 5u; ++step)
+    {
+        first.run();
+        second.run();
+    }
+
+    for (size_t i = 0u; i < first.particles.size(); ++i)
+    {
+        expectSamePoint(first.particles[i].position, second.particles[i].position);
+        expectSamePoint(first.particles[i].velocity, second.particles[i].velocity);
+    }
+
+    size_t tasksRun = 0u;
+    for (const WorkerStats& stats : second.getThreadPool().getWorkerStats())
+        tasksRun += stats.tasksRun;
+
+    EXPECT_GT(tasksRun, 0u);
+}
+
+void SPHTestSuite::firstTouchAllocationMatchesDefault()
+{
+    SimulationParams params = makeParams(1500u);
+    SPH defaultAllocation(params, nullptr, makePoolOptions(3u));
+
+    params.firstTouchAllocation = true;
+    SPH firstTouch(params, nullptr, makePoolOptions(3u));
+
+    ASSERT_EQ(defaultAllocation.particles.size(), firstTouch.particles.size());
+
+    for (const Particle& particle : firstTouch.particles)
+        EXPECT_LE(64u, particle.neighbours.capacity());
+
+    // Every worker first-touches one contiguous range of particles
+    for (size_t i = 1u; i < firstTouch.particles.size(); ++i)
+        EXPECT_LE(firstTouch.getOwningWorker(firstTouch.particles[i - 1u].position),
+                  firstTouch.getOwningWorker(firstTouch.particles[i].position));
+
+    EXPECT_LT(firstTouch.getOwningWorker(firstTouch.particles.front().position),
+              firstTouch.getOwningWorker(firstTouch.particles.back().position));
+
+    for (size_t step = 0u; step < 3u; ++step)
+    {
+        defaultAllocation.run();
+        firstTouch.run();
+    }
+
+    for (size_t i = 0u; i < firstTouch.particles.size(); ++i)
+    {
+        expectSamePoint(defaultAllocation.particles[i].position, firstTouch.particles[i].position);
+        expectSamePoint(defaultAllocation.particles[i].velocity, firstTouch.particles[i].velocity);
+    }
+
+    // Boundary neighbours are reserved by the workers as well
+    params.boundaryParticles = true;
+    const SPH withBoundary(params, nullptr, makePoolOptions(3u));
+
+    for (const Particle& particle : withBoundary.particles)
+        EXPECT_LE(64u, particle.boundaryNeighbours.capacity());
+}
+
+void SPHTestSuite::obstacleIsBakedByFirstStep()
+{
+    // Sampled by several workers at once
+    std::atomic<size_t> calls{0u};
+    const std::function<FLOAT(FLOAT, FLOAT, FLOAT)> obstacle = [&calls](FLOAT, FLOAT, FLOAT) {
+        ++calls;
+        return -1.0;
+    };
+
+    SimulationParams params = makeParams(500u);
+    params.obstacleCellSize = 0.1;
+    SPH sph(params, &obstacle, makePoolOptions(2u));
+
+    EXPECT_EQ(0u, calls.load());
+
+    sph.run();
+
+    const size_t bakeCalls = calls.load();
+    EXPECT_GT(bakeCalls, 0u);
+
+    sph.run();
+
+    EXPECT_EQ(bakeCalls, calls.load());
+
+    // Boundary particles sample the obstacle on construction
+    params.boundaryParticles = true;
+    calls = 0u;
+    const SPH withBoundary(params, &obstacle, makePoolOptions(2u));
+
+    EXPECT_EQ(bakeCalls, calls.load());
+}
+
+} // namespace TestEnvironment
+} // namespace SPHSDK
+
+using namespace SPHSDK::TestEnvironment;
+
+TEST(SPHTestSuite, pipelineMatchesSequentialForces)
+{
+    SPHTestSuite::pipelineMatchesSequentialForces();
+}
+
+TEST(SPHTestSuite, pipelineDoesNotDependOnThreadsNumber)
+{
+    SPHTestSuite::pipelineDoesNotDependOnThreadsNumber();
+}
+
+TEST(SPHTestSuite, firstTouchAllocationMatchesDefault)
+{
+    SPHTestSuite::firstTouchAllocationMatchesDefault();
+}
+
+TEST(SPHTestSuite, obstacleIsBakedByFirstStep)
+{
+    SPHTestSuite::obstacleIsBakedByFirstStep();
+}
@@ -0,0 +1,31 @@
+/**
+ * @file SPHTestSuite.h
+ * @author Anton Artyukh (artyukhanton@gmail.com)
+ * @date Created Oct 19, 2026
+ **/
+
+#ifndef SPH_TEST_SUITE_H_682E790738A248EAA574E55993274E83
+#define SPH_TEST_SUITE_H_682E790738A248EAA574E55993274E83
+
+namespace SPHSDK
+{
+
+namespace TestEnvironment
+{
+
+class SPHTestSuite
+{
+public:
+    static void pipelineMatchesSequentialForces();
+
+    static void pipelineDoesNotDependOnThreadsNumber();
+
+    static void firstTouchAllocationMatchesDefault();
+
+    static void obstacleIsBakedByFirstStep();
+};
+
+} // namespace TestEnvironment
+} // namespace SPHSDK
+
+#endif // SPH_TEST_SUITE_H_682E790738A248EAA574E55993274E83
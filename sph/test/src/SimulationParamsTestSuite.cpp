@@ -0,0 +1,159 @@
+/**
+ * @file SimulationParamsTestSuite.cpp
+ * @author Anton Artyukh (artyukhanton@gmail.com)
+ * @date Created Oct 19, 2026
+ **/
+
+#include "SimulationParamsTestSuite.h"
+
+#include "Config.h"
+#include "Forces.h"
+#include "SimulationParams.h"
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <stdexcept>
+
+namespace SPHSDK
+{
+namespace TestEnvironment
+{
+
+void SimulationParamsTestSuite::defaultsMatchConfig()
+{
+    const SimulationParams params;
+
+    EXPECT_EQ(Config::ParticlesNumber, params.particlesNumber);
+    EXPECT_DOUBLE_EQ(Config::ParticleRadius, params.particleRadius);
+    EXPECT_DOUBLE_EQ(Config::WaterDensity, params.waterDensity);
+    EXPECT_DOUBLE_EQ(Config::WaterStiffness, params.waterStiffness);
+    EXPECT_DOUBLE_EQ(Config::WaterViscosity, params.waterViscosity);
+    EXPECT_DOUBLE_EQ(Config::WaterSupportRadius, params.waterSupportRadius);
+    EXPECT_DOUBLE_EQ(Config::InitialGravitationalAcceleration.z, params.gravitationalAcceleration.z);
+    EXPECT_DOUBLE_EQ(Config::TimeStep, params.timeStep);
+    EXPECT_FALSE(params.firstTouchAllocation);
+    EXPECT_DOUBLE_EQ(Config::ObstacleCellSize, params.obstacleCellSize);
+    EXPECT_DOUBLE_EQ(Config::ObstacleBandWidth, params.obstacleBandWidth);
+    EXPECT_DOUBLE_EQ(Config::ObstacleRestitution, params.obstacleRestitution);
+    EXPECT_DOUBLE_EQ(Config::ObstacleFriction, params.obstacleFriction);
+    EXPECT_FALSE(params.sweptCollisions);
+    EXPECT_DOUBLE_EQ(Config::SweptCollisionDistance, params.sweptCollisionDistance);
+    EXPECT_FALSE(params.boundaryParticles);
+    EXPECT_DOUBLE_EQ(Config::BoundarySpacing, params.boundarySpacing);
+    EXPECT_FALSE(params.hasPeriodicAxes());
+}
+
+void SimulationParamsTestSuite::derivedConstantsFollowSupportRadius()
+{
+    SimulationParams params;
+    const FLOAT defaultOwnDensity = params.ownDensity;
+
+    params.waterSupportRadius = 2 * Config::WaterSupportRadius;
+    params.updateDerivedConstants();
+
+    EXPECT_DOUBLE_EQ(4 * Config::WaterSupportRadius * Config::WaterSupportRadius, params.supportRadiusSqr);
+    EXPECT_DOUBLE_EQ(defaultOwnDensity / 8, params.ownDensity);
+}
+
+void SimulationParamsTestSuite::loadFromStream()
+{
+    std::istringstream stream("# viscosity sweep\n"
+                              "WaterViscosity = 7.5\n"
+                              "\n"
+                              "  WaterSupportRadius=0.2  \n"
+                              "ParticlesNumber = 1200\n"
+                              "GravitationalAcceleration = 0 -9.82 0\n"
+                              "FirstTouchAllocation = 1\n"
+                              "ObstacleCellSize = 0.05\n"
+                              "PeriodicAxes = 1 0 1\n");
+
+    const SimulationParams params = SimulationParams::loadFromStream(stream);
+
+    EXPECT_DOUBLE_EQ(7.5, params.waterViscosity);
+    EXPECT_DOUBLE_EQ(0.2, params.waterSupportRadius);
+    EXPECT_DOUBLE_EQ(0.04, params.supportRadiusSqr);
+    EXPECT_EQ(1200u, params.particlesNumber);
+    EXPECT_DOUBLE_EQ(0.0, params.gravitationalAcceleration.x);
+    EXPECT_DOUBLE_EQ(-9.82, params.gravitationalAcceleration.y);
+    EXPECT_DOUBLE_EQ(0.0, params.gravitationalAcceleration.z);
+    EXPECT_DOUBLE_EQ(Config::WaterStiffness, params.waterStiffness);
+    EXPECT_TRUE(params.firstTouchAllocation);
+    EXPECT_DOUBLE_EQ(0.05, params.obstacleCellSize);
+    EXPECT_DOUBLE_EQ(Config::ObstacleBandWidth, params.obstacleBandWidth);
+    EXPECT_TRUE(params.periodicAxes[0]);
+    EXPECT_FALSE(params.periodicAxes[1]);
+    EXPECT_TRUE(params.periodicAxes[2]);
+    EXPECT_TRUE(params.getVolume().isPeriodic(2u));
+}
+
+void SimulationParamsTestSuite::loadRejectsUnknownParameter()
+{
+    std::istringstream unknownName("WaterViscocity = 7.5\n");
+    EXPECT_THROW(SimulationParams::loadFromStream(unknownName), std::runtime_error);
+
+    std::istringstream invalidValue("WaterViscosity = fast\n");
+    EXPECT_THROW(SimulationParams::loadFromStream(invalidValue), std::runtime_error);
+
+    std::istringstream shortVector("InitialVelocity = 1 2\n");
+    EXPECT_THROW(SimulationParams::loadFromStream(shortVector), std::runtime_error);
+}
+
+void SimulationParamsTestSuite::loadRejectsMissingFile()
+{
+    EXPECT_THROW(SimulationParams::loadFromFile("not_existing_params.cfg"), std::runtime_error);
+}
+
+void SimulationParamsTestSuite::forcesUseInstanceParams()
+{
+    ParticleVect light = {Particle(Point3F(1.0, 1.0, 1.0), 0.01), Particle(Point3F(1.0, 1.01, 1.0), 0.01)};
+    light[0].neighbours = {1};
+    light[1].neighbours = {0};
+    ParticleVect heavy = light;
+
+    SimulationParams heavyParams;
+    heavyParams.waterParticleMass = 2 * Config::WaterParticleMass;
+
+    Forces::ComputeAllForces(light);
+    Forces::ComputeAllForces(heavy, heavyParams);
+
+    const FLOAT ownDensity = SimulationParams().ownDensity;
+
+    EXPECT_NEAR(2 * (light[0].density - ownDensity), heavy[0].density - ownDensity, 1e-07);
+    EXPECT_NEAR(2 * (light[1].density - ownDensity), heavy[1].density - ownDensity, 1e-07);
+}
+
+} // namespace TestEnvironment
+} // namespace SPHSDK
+
+using namespace SPHSDK::TestEnvironment;
+
+TEST(SimulationParamsTestSuite, defaultsMatchConfig)
+{
+    SimulationParamsTestSuite::defaultsMatchConfig();
+}
+
+TEST(SimulationParamsTestSuite, derivedConstantsFollowSupportRadius)
+{
+    SimulationParamsTestSuite::derivedConstantsFollowSupportRadius();
+}
+
+TEST(SimulationParamsTestSuite, loadFromStream)
+{
+    SimulationParamsTestSuite::loadFromStream();
+}
+
+TEST(SimulationParamsTestSuite, loadRejectsUnknownParameter)
+{
+    SimulationParamsTestSuite::loadRejectsUnknownParameter();
+}
+
+TEST(SimulationParamsTestSuite, loadRejectsMissingFile)
+{
+    SimulationParamsTestSuite::loadRejectsMissingFile();
+}
+
+TEST(SimulationParamsTestSuite, forcesUseInstanceParams)
+{
+    SimulationParamsTestSuite::forcesUseInstanceParams();
+}
@@ -0,0 +1,35 @@
+/**
+ * @file SimulationParamsTestSuite.h
+ * @author Anton Artyukh (artyukhanton@gmail.com)
+ * @date Created Oct 19, 2026
+ **/
+
+#ifndef SIMULATION_PARAMS_TEST_SUITE_H_1754660D67AC4005BE95212B46FF4BAF
+#define SIMULATION_PARAMS_TEST_SUITE_H_1754660D67AC4005BE95212B46FF4BAF
+
+namespace SPHSDK
+{
+
+namespace TestEnvironment
+{
+
+class SimulationParamsTestSuite
+{
+public:
+    static void defaultsMatchConfig();
+
+    static void derivedConstantsFollowSupportRadius();
+
+    static void loadFromStream();
+
+    static void loadRejectsUnknownParameter();
+
+    static void loadRejectsMissingFile();
+
+    static void forcesUseInstanceParams();
+};
+
+} // namespace TestEnvironment
+} // namespace SPHSDK
+
+#endif // SIMULATION_PARAMS_TEST_SUITE_H_1754660D67AC4005BE95212B46FF4BAF
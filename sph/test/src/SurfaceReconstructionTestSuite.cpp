@@ -0,0 +1,313 @@
+/**
+ * @file SurfaceReconstructionTestSuite.cpp
+ * @author Anton Artyukh (artyukhanton@gmail.com)
+ * @date Created Oct 19, 2026
+ **/
+
+#include "SurfaceReconstructionTestSuite.h"
+
+#include "SurfaceReconstruction.h"
+
+#include "algorithms/src/ThreadPool.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+namespace SPHSDK
+{
+namespace TestEnvironment
+{
+
+// Lattice particles of the given spacing inside of the ball, their volume is spacing^3
+static ParticleVect makeBall(const Point3F& center, FLOAT radius, FLOAT spacing, const SimulationParams& params)
+{
+    ParticleVect particles;
+    const long long steps = static_cast<long long>(radius / spacing);
+
+    for (long long i = -steps; i <= steps; ++i)
+        for (long long j = -steps; j <= steps; ++j)
+            for (long long k = -steps; k <= steps; ++k)
+            {
+                const Point3F offset(i * spacing, j * spacing, k * spacing);
+                if (offset.calcNorm() > radius)
+                    continue;
+
+                Particle particle(center + offset);
+                particle.density = params.waterParticleMass / (spacing * spacing * spacing);
+                particles.push_back(particle);
+            }
+
+    return particles;
+}
+
+void SurfaceReconstructionTestSuite::ballSurfaceIsNearParticles()
+{
+    const SimulationParams params;
+    const Point3F center(0.5, 0.5, 0.5);
+    const FLOAT radius = 0.2;
+
+    const ParticleVect particles = makeBall(center, radius, 0.025, params);
+
+    SurfaceReconstruction reconstruction(params, 0.021);
+    EXPECT_NEAR(params.waterSupportRadius / 5.0, reconstruction.getCellSize(), 1e-12);
+
+    IndexedMesh mesh;
+    reconstruction.reconstruct(particles, mesh);
+
+    // The field is about 1 inside of the fluid
+    EXPECT_NEAR(1.0, reconstruction.getColourField(center), 0.1);
+    EXPECT_DOUBLE_EQ(0.0, reconstruction.getColourField(Point3F(2.0, 2.0, 2.0)));
+
+    ASSERT_FALSE(mesh.vertices.empty());
+    EXPECT_GT(mesh.getTrianglesNumber(), 1000u);
+
+    for (const Point3F& vertex : mesh.vertices)
+    {
+        const FLOAT distance = (vertex - center).calcNorm();
+        EXPECT_GT(distance, radius - params.waterSupportRadius);
+        EXPECT_LT(distance, radius + params.waterSupportRadius);
+    }
+
+    reconstruction.reconstruct(ParticleVect(), mesh);
+    EXPECT_TRUE(mesh.vertices.empty());
+    EXPECT_TRUE(mesh.indices.empty());
+}
+
+void SurfaceReconstructionTestSuite::meshMatchesUniformGrid()
+{
+    const SimulationParams params;
+    const ParticleVect particles = makeBall(Point3F(0.3, 0.4, 0.5), 0.12, 0.03, params);
+
+    SurfaceReconstruction reconstruction(params, 0.025);
+
+    IndexedMesh mesh;
+    reconstruction.reconstruct(particles, mesh);
+
+    // Colour field of all particles evaluated in every vertex of the grid
+    const auto field = [&params, &particles](FLOAT x, FLOAT y, FLOAT z) {
+        FLOAT colour = 0.0;
+
+        for (const Particle& particle : particles)
+        {
+            const FLOAT difference = params.supportRadiusSqr - (Point3F(x, y, z) - particle.position).calcNormSqr();
+            if (difference > 0.0)
+                colour += params.waterParticleMass / particle.density * params.kernelDefaultMultiplier * difference *
+                          difference * difference;
+        }
+
+        return colour - 0.5;
+    };
+
+    IndexedMesh uniformMesh;
+    MarchingCubes::generateMesh(field, reconstruction.getBounds(), reconstruction.getCellSize(), uniformMesh);
+
+    ASSERT_FALSE(uniformMesh.indices.empty());
+    ASSERT_EQ(uniformMesh.indices, mesh.indices);
+    ASSERT_EQ(uniformMesh.vertices.size(), mesh.vertices.size());
+
+    for (size_t i = 0u; i < mesh.vertices.size(); ++i)
+        EXPECT_NEAR(0.0, (uniformMesh.vertices[i] - mesh.vertices[i]).calcNorm(), 1e-9);
+}
+
+void SurfaceReconstructionTestSuite::savesObj()
+{
+    const SimulationParams params;
+    const ParticleVect particles = makeBall(Point3F(0.5, 0.5, 0.5), 0.1, 0.025, params);
+
+    IndexedMesh mesh;
+    SurfaceReconstruction(params, 0.02).reconstruct(particles, mesh);
+
+    std::stringstream stream;
+    mesh.saveObj(stream);
+
+    size_t verticesNumber = 0u;
+    size_t facesNumber = 0u;
+    std::string line;
+
+    while (std::getline(stream, line))
+    {
+        std::istringstream lineStream(line);
+        std::string type;
+        lineStream >> type;
+
+        if (type == "v")
+        {
+            ++verticesNumber;
+        }
+        else if (type == "f")
+        {
+            ++facesNumber;
+
+            for (size_t corner = 0u; corner < 3u; ++corner)
+            {
+                size_t index = 0u;
+                lineStream >> index;
+                EXPECT_GE(index, 1u);
+                EXPECT_LE(index, mesh.vertices.size());
+            }
+        }
+    }
+
+    EXPECT_EQ(mesh.vertices.size(), verticesNumber);
+    EXPECT_EQ(mesh.getTrianglesNumber(), facesNumber);
+}
+
+void SurfaceReconstructionTestSuite::skipsNonFiniteParticles()
+{
+    const SimulationParams params;
+    const ParticleVect particles = makeBall(Point3F(0.5, 0.5, 0.5), 0.1, 0.025, params);
+
+    SurfaceReconstruction reconstruction(params, 0.02);
+
+    IndexedMesh mesh;
+    reconstruction.reconstruct(particles, mesh);
+    const Cuboid bounds = reconstruction.getBounds();
+
+    // Diverged particles, as left by a blown up simulation
+    ParticleVect diverged = particles;
+    diverged.insert(diverged.begin() + 3, Particle(Point3F(NAN, 0.5, 0.5)));
+    diverged.push_back(Particle(Point3F(0.5, INFINITY, 0.5)));
+    diverged.push_back(Particle(Point3F(NAN, NAN, NAN)));
+
+    IndexedMesh divergedMesh;
+    ASSERT_NO_THROW(reconstruction.reconstruct(diverged, divergedMesh));
+
+    EXPECT_DOUBLE_EQ(bounds.startingPoint.x, reconstruction.getBounds().startingPoint.x);
+    EXPECT_DOUBLE_EQ(bounds.width, reconstruction.getBounds().width);
+    EXPECT_EQ(mesh.indices, divergedMesh.indices);
+    EXPECT_EQ(mesh.vertices.size(), divergedMesh.vertices.size());
+    EXPECT_DOUBLE_EQ(0.0, reconstruction.getColourField(Point3F(NAN, 0.5, 0.5)));
+
+    reconstruction.reconstruct(ParticleVect(2u, Particle(Point3F(NAN, NAN, NAN))), divergedMesh);
+    EXPECT_TRUE(divergedMesh.indices.empty());
+}
+
+void SurfaceReconstructionTestSuite::strayParticleKeepsMeshOfFluid()
+{
+    const SimulationParams params;
+    const ParticleVect particles = makeBall(Point3F(0.5, 0.5, 0.5), 0.1, 0.025, params);
+
+    SurfaceReconstruction reconstruction(params, 0.02);
+
+    IndexedMesh mesh;
+    reconstruction.reconstruct(particles, mesh);
+
+    // Far beyond the fluid along every axis, the bounds hold about 10^14 cells of the mesh
+    ParticleVect withStray = particles;
+    withStray.push_back(Particle(Point3F(1000.0, 1000.0, 1000.0)));
+
+    IndexedMesh strayMesh;
+    reconstruction.reconstruct(withStray, strayMesh);
+
+    EXPECT_GT(reconstruction.getBounds().width, 999.0);
+    EXPECT_DOUBLE_EQ(0.0, reconstruction.getColourField(Point3F(500.0, 500.0, 500.0)));
+    EXPECT_GT(reconstruction.getColourField(Point3F(1000.0, 1000.0, 1000.0)), 0.0);
+
+    // The grid starts at the same point, so the fluid is meshed first and the same way
+    ASSERT_GE(strayMesh.indices.size(), mesh.indices.size());
+    EXPECT_TRUE(std::equal(mesh.indices.begin(), mesh.indices.end(), strayMesh.indices.begin()));
+
+    for (size_t i = 0u; i < mesh.vertices.size(); ++i)
+        EXPECT_NEAR(0.0, (mesh.vertices[i] - strayMesh.vertices[i]).calcNorm(), 1e-9);
+}
+
+void SurfaceReconstructionTestSuite::farParticleKeepsMeshOfFluid()
+{
+    const SimulationParams params;
+    const ParticleVect particles = makeBall(Point3F(0.5, 0.5, 0.5), 0.1, 0.025, params);
+
+    SurfaceReconstruction reconstruction(params, 0.02);
+
+    IndexedMesh mesh;
+    reconstruction.reconstruct(particles, mesh);
+
+    // About 5 * 10^7 cells along every axis, more than 2^64 cells in the whole grid
+    ParticleVect withFar = particles;
+    withFar.push_back(Particle(Point3F(1e6, 1e6, 1e6)));
+
+    IndexedMesh farMesh;
+    reconstruction.reconstruct(withFar, farMesh);
+
+    EXPECT_GT(reconstruction.getBounds().width / reconstruction.getCellSize(), 4e7);
+    ASSERT_GE(farMesh.indices.size(), mesh.indices.size());
+    EXPECT_TRUE(std::equal(mesh.indices.begin(), mesh.indices.end(), farMesh.indices.begin()));
+
+    // Too far for the integer coordinates of cells
+    withFar.back().position = Point3F(1e30, 0.5, 0.5);
+    EXPECT_THROW(reconstruction.reconstruct(withFar, farMesh), std::invalid_argument);
+}
+
+void SurfaceReconstructionTestSuite::parallelMeshMatchesSerial()
+{
+    const SimulationParams params;
+    ParticleVect particles = makeBall(Point3F(0.3, 0.4, 0.5), 0.12, 0.03, params);
+
+    const ParticleVect secondBall = makeBall(Point3F(0.7, 0.5, 0.5), 0.08, 0.03, params);
+    particles.insert(particles.end(), secondBall.begin(), secondBall.end());
+
+    SurfaceReconstruction reconstruction(params, 0.02);
+
+    IndexedMesh mesh;
+    reconstruction.reconstruct(particles, mesh);
+
+    ThreadPool pool(4u);
+
+    IndexedMesh parallelMesh;
+    reconstruction.reconstruct(particles, parallelMesh, &pool);
+
+    ASSERT_FALSE(mesh.indices.empty());
+    EXPECT_EQ(mesh.indices, parallelMesh.indices);
+    ASSERT_EQ(mesh.vertices.size(), parallelMesh.vertices.size());
+
+    for (size_t i = 0u; i < mesh.vertices.size(); ++i)
+    {
+        EXPECT_DOUBLE_EQ(mesh.vertices[i].x, parallelMesh.vertices[i].x);
+        EXPECT_DOUBLE_EQ(mesh.vertices[i].y, parallelMesh.vertices[i].y);
+        EXPECT_DOUBLE_EQ(mesh.vertices[i].z, parallelMesh.vertices[i].z);
+    }
+}
+
+} // namespace TestEnvironment
+} // namespace SPHSDK
+
+using namespace SPHSDK::TestEnvironment;
+
+TEST(SurfaceReconstructionTestSuite, ballSurfaceIsNearParticles)
+{
+    SurfaceReconstructionTestSuite::ballSurfaceIsNearParticles();
+}
+
+TEST(SurfaceReconstructionTestSuite, meshMatchesUniformGrid)
+{
+    SurfaceReconstructionTestSuite::meshMatchesUniformGrid();
+}
+
+TEST(SurfaceReconstructionTestSuite, savesObj)
+{
+    SurfaceReconstructionTestSuite::savesObj();
+}
+
+TEST(SurfaceReconstructionTestSuite, skipsNonFiniteParticles)
+{
+    SurfaceReconstructionTestSuite::skipsNonFiniteParticles();
+}
+
+TEST(SurfaceReconstructionTestSuite, strayParticleKeepsMeshOfFluid)
+{
+    SurfaceReconstructionTestSuite::strayParticleKeepsMeshOfFluid();
+}
+
+TEST(SurfaceReconstructionTestSuite, farParticleKeepsMeshOfFluid)
+{
+    SurfaceReconstructionTestSuite::farParticleKeepsMeshOfFluid();
+}
+
+TEST(SurfaceReconstructionTestSuite, parallelMeshMatchesSerial)
+{
+    SurfaceReconstructionTestSuite::parallelMeshMatchesSerial();
+}
@@ -0,0 +1,37 @@
+/**
+ * @file SurfaceReconstructionTestSuite.h
+ * @author Anton Artyukh (artyukhanton@gmail.com)
+ * @date Created Oct 19, 2026
+ **/
+
+#ifndef SURFACE_RECONSTRUCTION_TEST_SUITE_H_6D2B9F047C3E4A1B8E5F90A7D1C36B28
+#define SURFACE_RECONSTRUCTION_TEST_SUITE_H_6D2B9F047C3E4A1B8E5F90A7D1C36B28
+
+namespace SPHSDK
+{
+
+namespace TestEnvironment
+{
+
+class SurfaceReconstructionTestSuite
+{
+public:
+    static void ballSurfaceIsNearParticles();
+
+    static void meshMatchesUniformGrid();
+
+    static void savesObj();
+
+    static void skipsNonFiniteParticles();
+
+    static void strayParticleKeepsMeshOfFluid();
+
+    static void farParticleKeepsMeshOfFluid();
+
+    static void parallelMeshMatchesSerial();
+};
+
+} // namespace TestEnvironment
+} // namespace SPHSDK
+
+#endif // SURFACE_RECONSTRUCTION_TEST_SUITE_H_6D2B9F047C3E4A1B8E5F90A7D1C36B28